@@ -42,6 +42,9 @@
   Copyright (C) Dominik Reichl <dominik.reichl@t-online.de>
 */
 #include <QtCore/qendian.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <utility>
 
 #ifdef Q_CC_MSVC
 #  include <stdlib.h>
@@ -190,6 +193,168 @@ static inline void sha1ProcessChunk(Sha1State *state, const unsigned char *buffe
 #endif
 }
 
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SHA) && \
+    QT_COMPILER_SUPPORTS_HERE(SSE4_1) && !defined(QT_BOOTSTRAPPED)
+#  define QT_SHA_SHANI
+#  define QT_FUNCTION_TARGET_STRING_SHA_SSE4_1 \
+    QT_FUNCTION_TARGET_STRING_SHA "," QT_FUNCTION_TARGET_STRING_SSE4_1
+
+// One group of four rounds using the SHA new instructions. msg[Group % 4]
+// holds the message schedule for this group; the schedules of the following
+// groups are computed on the way. All lanes are independent of each other
+// and are interleaved to hide the latency of the instructions.
+template <int Group, int Lanes>
+static inline void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1ShaNiGroup(__m128i *abcd, __m128i *e, __m128i *eNext, __m128i (*msg)[4])
+{
+    constexpr int Cur = Group % 4;
+    for (int l = 0; l < Lanes; ++l) {
+        if constexpr (Group == 0)
+            e[l] = _mm_add_epi32(e[l], msg[l][Cur]);
+        else
+            e[l] = _mm_sha1nexte_epu32(e[l], msg[l][Cur]);
+        eNext[l] = abcd[l];
+        if constexpr (Group >= 3 && Group <= 18)
+            msg[l][(Group + 1) % 4] = _mm_sha1msg2_epu32(msg[l][(Group + 1) % 4], msg[l][Cur]);
+        abcd[l] = _mm_sha1rnds4_epu32(abcd[l], e[l], Group / 5);
+        if constexpr (Group >= 1 && Group <= 16)
+            msg[l][(Group + 3) % 4] = _mm_sha1msg1_epu32(msg[l][(Group + 3) % 4], msg[l][Cur]);
+        if constexpr (Group >= 2 && Group <= 17)
+            msg[l][(Group + 2) % 4] = _mm_xor_si128(msg[l][(Group + 2) % 4], msg[l][Cur]);
+    }
+}
+
+template <int Lanes, int... Groups>
+static inline void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1ShaNiRounds(__m128i *abcd, __m128i *e0, __m128i *e1, __m128i (*msg)[4],
+                std::integer_sequence<int, Groups...>)
+{
+    // E alternates between e0 and e1 from one group to the next
+    ((Groups % 2 ? sha1ShaNiGroup<Groups, Lanes>(abcd, e1, e0, msg)
+                 : sha1ShaNiGroup<Groups, Lanes>(abcd, e0, e1, msg)), ...);
+}
+
+// Processes count consecutive chunks of each lane. states[l] holds the five
+// words of the state of lane l.
+template <int Lanes>
+static void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1ShaNiChunks(quint32 *const *states, const unsigned char *const *data, qint64 count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    __m128i abcd[Lanes], e0[Lanes], e1[Lanes];
+    __m128i abcdSave[Lanes], e0Save[Lanes];
+    __m128i msg[Lanes][4];
+
+    for (int l = 0; l < Lanes; ++l) {
+        const quint32 *h = states[l];
+        abcd[l] = _mm_set_epi32(h[0], h[1], h[2], h[3]);
+        e0[l] = _mm_set_epi32(h[4], 0, 0, 0);
+    }
+
+    for (qint64 i = 0; i < count; ++i) {
+        for (int l = 0; l < Lanes; ++l) {
+            abcdSave[l] = abcd[l];
+            e0Save[l] = e0[l];
+            const unsigned char *chunk = data[l] + i * 64;
+            for (int j = 0; j < 4; ++j) {
+                const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chunk + j * 16));
+                msg[l][j] = _mm_shuffle_epi8(words, byteSwap);
+            }
+        }
+
+        sha1ShaNiRounds<Lanes>(abcd, e0, e1, msg, std::make_integer_sequence<int, 20>());
+
+        for (int l = 0; l < Lanes; ++l) {
+            e0[l] = _mm_sha1nexte_epu32(e0[l], e0Save[l]);
+            abcd[l] = _mm_add_epi32(abcd[l], abcdSave[l]);
+        }
+    }
+
+    for (int l = 0; l < Lanes; ++l) {
+        quint32 *h = states[l];
+        h[0] = _mm_extract_epi32(abcd[l], 3);
+        h[1] = _mm_extract_epi32(abcd[l], 2);
+        h[2] = _mm_extract_epi32(abcd[l], 1);
+        h[3] = _mm_extract_epi32(abcd[l], 0);
+        h[4] = _mm_extract_epi32(e0[l], 3);
+    }
+}
+#elif defined(Q_PROCESSOR_ARM_64) && QT_COMPILER_SUPPORTS_HERE(AES) && !defined(QT_BOOTSTRAPPED)
+#  define QT_SHA_ARM_CRYPTO
+
+// The SHA-1 instructions are part of the ARMv8 cryptographic extension,
+// but the CPU reports them separately from AES.
+static void QT_FUNCTION_TARGET(SHA1)
+sha1ArmChunks(quint32 *h, const unsigned char *data, qint64 count)
+{
+    static const quint32 K[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+    uint32x4_t abcd = vld1q_u32(h);
+    quint32 e0 = h[4];
+
+    for (; count; --count, data += 64) {
+        const uint32x4_t abcdSave = abcd;
+        const quint32 e0Save = e0;
+        uint32x4_t msg[4];
+        for (int j = 0; j < 4; ++j)
+            msg[j] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + j * 16)));
+
+        quint32 e1;
+        for (int group = 0; group < 20; ++group) {
+            // E alternates between e0 and e1 from one group to the next
+            quint32 &e = group % 2 ? e1 : e0;
+            quint32 &eNext = group % 2 ? e0 : e1;
+            uint32x4_t &cur = msg[group % 4];
+            const uint32x4_t wk = vaddq_u32(cur, vdupq_n_u32(K[group / 5]));
+            eNext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (group < 5)
+                abcd = vsha1cq_u32(abcd, e, wk);
+            else if (group >= 10 && group < 15)
+                abcd = vsha1mq_u32(abcd, e, wk);
+            else
+                abcd = vsha1pq_u32(abcd, e, wk);
+            if (group < 16) {
+                cur = vsha1su0q_u32(cur, msg[(group + 1) % 4], msg[(group + 2) % 4]);
+                cur = vsha1su1q_u32(cur, msg[(group + 3) % 4]);
+            }
+        }
+
+        e0 += e0Save;
+        abcd = vaddq_u32(abcd, abcdSave);
+    }
+
+    vst1q_u32(h, abcd);
+    h[4] = e0;
+}
+#endif
+
+static inline void sha1ProcessChunks(Sha1State *state, const unsigned char *data, qint64 count)
+{
+#if defined(QT_SHA_SHANI) || defined(QT_SHA_ARM_CRYPTO)
+#  if defined(QT_SHA_SHANI)
+    const bool accelerated = qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+#  else
+    const bool accelerated = qCpuHasFeature(SHA1);
+#  endif
+    if (accelerated) {
+        quint32 h[5] = { state->h0, state->h1, state->h2, state->h3, state->h4 };
+#  if defined(QT_SHA_SHANI)
+        quint32 *states[1] = { h };
+        sha1ShaNiChunks<1>(states, &data, count);
+#  else
+        sha1ArmChunks(h, data, count);
+#  endif
+        state->h0 = h[0];
+        state->h1 = h[1];
+        state->h2 = h[2];
+        state->h3 = h[3];
+        state->h4 = h[4];
+        return;
+    }
+#endif
+    for (; count; --count, data += 64)
+        sha1ProcessChunk(state, data);
+}
+
 static inline void sha1InitState(Sha1State *state)
 {
     state->h0 = 0x67452301;
@@ -217,8 +382,10 @@ static inline void sha1Update(Sha1State *state, const unsigned char *data, qint6
         sha1ProcessChunk(state, state->buffer);
 
         qint64 lastI = len - ((len + rest) & Q_INT64_C(63));
-        for( ; i < lastI; i += 64)
-            sha1ProcessChunk(state, &data[i]);
+        if (i < lastI) {
+            sha1ProcessChunks(state, &data[i], (lastI - i) / 64);
+            i = lastI;
+        }
 
         memcpy(&state->buffer[0], &data[i], len - i);
     }
@@ -211,6 +211,24 @@ eventfd_write(fd, value);
 }
 ")
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"#include <sys/epoll.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct epoll_event ev = {};
+int fd = epoll_create1(EPOLL_CLOEXEC);
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(fd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # futimens
 qt_config_compile_test(futimens
     LABEL "futimens()"
@@ -427,6 +445,27 @@ poll(&pfd, 1, 0);
 }
 ")
 
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+struct io_uring_sqe sqe = {};
+sqe.opcode = IORING_OP_READ;
+int fd = syscall(__NR_io_uring_setup, 8, &params);
+syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, 0, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # renameat2
 qt_config_compile_test(renameat2
     LABEL "renameat2()"
@@ -569,6 +608,10 @@ qt_feature("eventfd" PUBLIC
     CONDITION NOT WASM AND TEST_eventfd
 )
 qt_feature_definition("eventfd" "QT_NO_EVENTFD" NEGATE VALUE "1")
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    CONDITION LINUX AND TEST_epoll
+)
 qt_feature("futimens" PRIVATE
     LABEL "futimens()"
     CONDITION NOT WIN32 AND TEST_futimens
@@ -612,6 +655,10 @@ qt_feature("ipc_posix"
     CONDITION TEST_ipc_posix
 )
 qt_feature_definition("ipc_posix" "QT_POSIX_IPC")
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    CONDITION LINUX AND QT_FEATURE_future AND TEST_io_uring
+)
 qt_feature("journald" PRIVATE
     LABEL "journald"
     AUTODETECT OFF
@@ -956,6 +1003,16 @@ qt_feature("cborstreamwriter" PUBLIC
     LABEL "CBOR stream writing"
     PURPOSE "Provides support for writing the CBOR binary format."
 )
+qt_feature("jsonstreamreader" PUBLIC
+    SECTION "Utilities"
+    LABEL "JSON stream reading"
+    PURPOSE "Provides support for reading JSON documents incrementally."
+)
+qt_feature("jsonstreamwriter" PUBLIC
+    SECTION "Utilities"
+    LABEL "JSON stream writing"
+    PURPOSE "Provides support for writing JSON documents incrementally."
+)
 qt_configure_add_summary_section(NAME "Qt Core")
 qt_configure_add_summary_entry(ARGS "backtrace")
 qt_configure_add_summary_entry(ARGS "doubleconversion")
@@ -78,3 +78,13 @@
 
     QCborValue contents = QCborValue::fromCbor(reader);
 //! [6]
+
+//! [7]
+    QFile file("cache.cbor");
+    file.open(QIODevice::ReadOnly);
+    const uchar *data = file.map(0, file.size());
+    QCborValue cache = QCborValue::fromRawCbor(reinterpret_cast<const char *>(data), file.size());
+
+    // only the entries map and this one entry are decoded
+    QCborMap entry = cache[QLatin1String("entries")][key].toMap();
+//! [7]
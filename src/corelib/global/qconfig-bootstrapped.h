@@ -96,6 +96,8 @@
 #define QT_FEATURE_islamiccivilcalendar -1
 #define QT_FEATURE_jalalicalendar -1
 #define QT_FEATURE_journald -1
+#define QT_FEATURE_jsonstreamreader -1
+#define QT_FEATURE_jsonstreamwriter -1
 #define QT_FEATURE_futimens -1
 #define QT_FEATURE_futimes -1
 #define QT_FEATURE_future -1
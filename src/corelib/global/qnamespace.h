@@ -1308,6 +1308,7 @@ namespace Qt {
         BlockingQueuedConnection,
         UniqueConnection =  0x80,
         SingleShotConnection = 0x100,
+        CoalescedConnection = 0x200,
     };
 
     enum ShortcutContext {
@@ -79,10 +79,14 @@
 
 // copied from <asm/hwcap.h> (ARM):
 #define HWCAP2_AES   (1 << 0)
+#define HWCAP2_SHA1  (1 << 2)
+#define HWCAP2_SHA2  (1 << 3)
 #define HWCAP2_CRC32 (1 << 4)
 
 // copied from <asm/hwcap.h> (Aarch64)
 #define HWCAP_AES               (1 << 3)
+#define HWCAP_SHA1              (1 << 5)
+#define HWCAP_SHA2              (1 << 6)
 #define HWCAP_CRC32             (1 << 7)
 
 // copied from <linux/auxvec.h>
@@ -102,13 +106,17 @@ QT_BEGIN_NAMESPACE
  neon
  crc32
  aes
+ sha1
+ sha2
  */
 static const char features_string[] =
         "\0"
         " neon\0"
         " crc32\0"
-        " aes\0";
-static const int features_indices[] = { 0, 1, 7, 14 };
+        " aes\0"
+        " sha1\0"
+        " sha2\0";
+static const int features_indices[] = { 0, 1, 7, 14, 19, 25 };
 #elif defined(Q_PROCESSOR_MIPS)
 /* Data:
  dsp
@@ -150,6 +158,10 @@ static inline quint64 detectProcessorFeatures()
             features |= CpuFeatureCRC32;
         if (auxvHwCap & HWCAP_AES)
             features |= CpuFeatureAES;
+        if (auxvHwCap & HWCAP_SHA1)
+            features |= CpuFeatureSHA1;
+        if (auxvHwCap & HWCAP_SHA2)
+            features |= CpuFeatureSHA2;
 #  else
         // For ARM32:
         if (auxvHwCap & HWCAP_NEON)
@@ -159,6 +171,10 @@ static inline quint64 detectProcessorFeatures()
             features |= CpuFeatureCRC32;
         if (auxvHwCap & HWCAP2_AES)
             features |= CpuFeatureAES;
+        if (auxvHwCap & HWCAP2_SHA1)
+            features |= CpuFeatureSHA1;
+        if (auxvHwCap & HWCAP2_SHA2)
+            features |= CpuFeatureSHA2;
 #  endif
         return features;
     }
@@ -170,17 +186,18 @@ static inline quint64 detectProcessorFeatures()
         features |= feature ? CpuFeatureNEON : 0;
     if (sysctlbyname("hw.optional.armv8_crc32", &feature, &len, nullptr, 0) == 0)
         features |= feature ? CpuFeatureCRC32 : 0;
-    // There is currently no optional value for crypto/AES.
+    // There is currently no optional value for crypto/AES/SHA.
 #if defined(__ARM_FEATURE_CRYPTO)
-    features |= CpuFeatureAES;
+    features |= CpuFeatureAES | CpuFeatureSHA1 | CpuFeatureSHA2;
 #endif
     return features;
 #elif defined(Q_OS_WIN) && defined(Q_PROCESSOR_ARM_64)
     features |= CpuFeatureNEON;
     if (IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE) != 0)
         features |= CpuFeatureCRC32;
+    // the crypto extension covers AES, SHA-1 and SHA-256
     if (IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0)
-        features |= CpuFeatureAES;
+        features |= CpuFeatureAES | CpuFeatureSHA1 | CpuFeatureSHA2;
     return features;
 #endif
 #if defined(__ARM_NEON__) || defined(__ARM_NEON)
@@ -192,6 +209,9 @@ static inline quint64 detectProcessorFeatures()
 #if defined(__ARM_FEATURE_CRYPTO)
     features |= CpuFeatureAES;
 #endif
+#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2)
+    features |= CpuFeatureSHA1 | CpuFeatureSHA2;
+#endif
 
     return features;
 }
@@ -596,7 +616,7 @@ uint64_t QT_MANGLE_NAMESPACE(qDetectCpuFeatures)()
 #if defined(Q_OS_LINUX) && defined(Q_PROCESSOR_ARM_64)
     // Yocto hard-codes CRC32+AES on. Since they are unlikely to be used
     // automatically by compilers, we can just add runtime check.
-    minFeatureTest &= ~(CpuFeatureAES|CpuFeatureCRC32);
+    minFeatureTest &= ~(CpuFeatureAES|CpuFeatureSHA1|CpuFeatureSHA2|CpuFeatureCRC32);
 #endif
     QCpuFeatureType f = detectProcessorFeatures();
 
@@ -611,7 +631,11 @@ uint64_t QT_MANGLE_NAMESPACE(qDetectCpuFeatures)()
         while (char *token = strtok(disable, " ")) {
             disable = nullptr;
             for (uint i = 0; i < std::size(features_indices); ++i) {
-                if (strcmp(token, features_string + features_indices[i]) == 0)
+                // skip the leading space in features_string, if there is one
+                const char *name = features_string + features_indices[i];
+                if (*name == ' ')
+                    ++name;
+                if (strcmp(token, name) == 0)
                     f &= ~(Q_UINT64_C(1) << i);
             }
         }
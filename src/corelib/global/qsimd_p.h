@@ -312,17 +312,25 @@ inline uint8_t vaddv_u8(uint8x8_t v8)
 #if defined(Q_PROCESSOR_ARM_64)
 #if defined(Q_CC_CLANG)
 #define QT_FUNCTION_TARGET_STRING_AES        "crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA1       "crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA2       "crypto"
 #define QT_FUNCTION_TARGET_STRING_CRC32      "crc"
 #elif defined(Q_CC_GNU)
 #define QT_FUNCTION_TARGET_STRING_AES        "+crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA1       "+crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA2       "+crypto"
 #define QT_FUNCTION_TARGET_STRING_CRC32      "+crc"
 #endif
 #elif defined(Q_PROCESSOR_ARM_32)
 #if defined(Q_CC_CLANG)
 #define QT_FUNCTION_TARGET_STRING_AES        "armv8-a,crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA1       "armv8-a,crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA2       "armv8-a,crypto"
 #define QT_FUNCTION_TARGET_STRING_CRC32      "armv8-a,crc"
 #elif defined(Q_CC_GNU)
 #define QT_FUNCTION_TARGET_STRING_AES        "arch=armv8-a+crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA1       "arch=armv8-a+crypto"
+#define QT_FUNCTION_TARGET_STRING_SHA2       "arch=armv8-a+crypto"
 #define QT_FUNCTION_TARGET_STRING_CRC32      "arch=armv8-a+crc"
 #endif
 #endif
@@ -335,6 +343,8 @@ enum CPUFeatures {
     CpuFeatureCRC32         = 4,
     CpuFeatureAES           = 8,
     CpuFeatureARM_CRYPTO    = CpuFeatureAES,
+    CpuFeatureSHA1          = 16,
+    CpuFeatureSHA2          = 32,
 #elif defined(Q_PROCESSOR_MIPS)
     CpuFeatureDSP           = 2,
     CpuFeatureDSPR2         = 4,
@@ -351,6 +361,9 @@ static const quint64 qCompilerCpuFeatures = 0
 #if defined __ARM_FEATURE_CRYPTO
         | CpuFeatureAES
 #endif
+#if defined __ARM_FEATURE_CRYPTO || defined __ARM_FEATURE_SHA2
+        | CpuFeatureSHA1 | CpuFeatureSHA2
+#endif
 #if defined __mips_dsp
         | CpuFeatureDSP
 #endif
@@ -51,6 +51,14 @@
 #include "private/qfilesystemengine_p.h"
 #include "private/qsystemerror_p.h"
 #include "private/qtemporaryfile_p.h"
+
+#if QT_CONFIG(future)
+#  include "qfuture.h"
+#  include "private/qfileasyncio_p.h"
+#  ifdef Q_OS_UNIX
+#    include "private/qcore_unix_p.h"
+#  endif
+#endif
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
@@ -1266,6 +1274,122 @@ qint64 QFile::size() const
 */
 
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.4
+
+    Starts reading at most \a maxSize bytes from the file, beginning at
+    \a offset, and returns a QFuture that receives the data. The calling
+    thread is not blocked; use QFutureWatcher or QFuture::then() to be
+    notified through the event loop when the data is available. If nothing
+    could be read, the result is an empty QByteArray.
+
+    The transfer does not change pos() and it completes even if the QFile
+    is closed or destroyed in the meantime. On Unix, it works on a duplicate
+    of the native file handle and uses positioned I/O. On Linux, such
+    requests are handed to io_uring if the kernel supports it; otherwise
+    they run on an internal thread pool. Setting the \c QT_NO_IO_URING
+    environment variable forces the thread pool. On other platforms, and
+    for files without a native handle such as
+    \l{The Qt Resource System}{resources}, the file is opened again by name
+    in a thread of the internal thread pool.
+
+    The file must be open for reading and must not be sequential. Only
+    files that were opened from a handle and have no name are read
+    synchronously; the returned future is then already finished.
+
+    \sa writeAsync(), handle()
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 maxSize)
+{
+    if (!isReadable() || isSequential()) {
+        qWarning("QFile::readAsync: File (%ls) not open for reading or sequential",
+                 qUtf16Printable(fileName()));
+        return QtFuture::makeReadyFuture(QByteArray());
+    }
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QFile::readAsync: Called with negative offset or size");
+        return QtFuture::makeReadyFuture(QByteArray());
+    }
+
+    // make sure the other side sees what we still hold in the write buffer
+    if (isWritable())
+        flush();
+
+#ifdef Q_OS_UNIX
+    const int fd = handle();
+    if (fd != -1) {
+        const int dupfd = qt_safe_dup(fd);
+        if (dupfd != -1)
+            return QFileAsyncIO::read(dupfd, offset, maxSize);
+    }
+#endif
+    if (!fileName().isEmpty())
+        return QFileAsyncIO::read(fileName(), offset, maxSize);
+
+    const qint64 oldPos = pos();
+    QByteArray data;
+    if (seek(offset))
+        data = QFileAsyncIO::readAtMost(this, maxSize);
+    seek(oldPos);
+    return QtFuture::makeReadyFuture(std::move(data));
+}
+
+/*!
+    \since 6.4
+
+    Starts writing \a data to the file at \a offset and returns a QFuture
+    that receives the number of bytes written, or -1 if an error occurred
+    before anything was written. The calling thread is not blocked.
+
+    \a data is shared, not copied, and the transfer does not change pos().
+    The same backends as for readAsync() are used. Note that on Linux,
+    positioned writes to a file opened in QIODevice::Append mode always
+    append, regardless of \a offset.
+
+    The file must be open for writing and must not be sequential. Any data
+    buffered by QFile is flushed before the request is started. Only files
+    that were opened from a handle and have no name are written
+    synchronously; the returned future is then already finished.
+
+    \sa readAsync()
+*/
+QFuture<qint64> QFile::writeAsync(qint64 offset, const QByteArray &data)
+{
+    if (!isWritable() || isSequential()) {
+        qWarning("QFile::writeAsync: File (%ls) not open for writing or sequential",
+                 qUtf16Printable(fileName()));
+        return QtFuture::makeReadyFuture(qint64(-1));
+    }
+    if (offset < 0) {
+        qWarning("QFile::writeAsync: Called with negative offset");
+        return QtFuture::makeReadyFuture(qint64(-1));
+    }
+
+    flush();
+
+#ifdef Q_OS_UNIX
+    const int fd = handle();
+    if (fd != -1) {
+        const int dupfd = qt_safe_dup(fd);
+        if (dupfd != -1)
+            return QFileAsyncIO::write(dupfd, offset, data);
+    }
+#endif
+    if (!fileName().isEmpty())
+        return QFileAsyncIO::write(fileName(), openMode(), offset, data);
+
+    const qint64 oldPos = pos();
+    qint64 written = -1;
+    if (seek(offset)) {
+        written = write(data);
+        flush();
+    }
+    seek(oldPos);
+    return QtFuture::makeReadyFuture(written);
+}
+#endif // QT_CONFIG(future)
+
 QT_END_NAMESPACE
 
 #ifndef QT_NO_QOBJECT
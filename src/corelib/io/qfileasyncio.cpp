@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qfileasyncio_p.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+Q_GLOBAL_STATIC(QThreadPool, asyncIOThreadPool)
+
+QThreadPool *QFileAsyncIO::threadPool()
+{
+    return asyncIOThreadPool();
+}
+
+QByteArray QFileAsyncIO::readAtMost(QIODevice *device, qint64 maxSize)
+{
+    constexpr qint64 ChunkSize = 16384;
+    const qint64 expected = qMax(device->size() - device->pos(), qint64(0));
+    QByteArray data;
+    while (data.size() < maxSize) {
+        const qint64 chunk = qMin(maxSize - data.size(), qMax(expected - data.size(), ChunkSize));
+        const QByteArray next = device->read(chunk);
+        if (next.isEmpty())
+            break;
+        data += next;
+    }
+    return data;
+}
+
+QFuture<QByteArray> QFileAsyncIO::read(const QString &fileName, qint64 offset, qint64 maxSize)
+{
+    auto promise = std::make_shared<QPromise<QByteArray>>();
+    QFuture<QByteArray> future = promise->future();
+    promise->start();
+
+    threadPool()->start([promise, fileName, offset, maxSize] {
+        QByteArray data;
+        QFile file(fileName);
+        if (file.open(QIODevice::ReadOnly) && file.seek(offset))
+            data = readAtMost(&file, maxSize);
+        promise->addResult(std::move(data));
+        promise->finish();
+    });
+
+    return future;
+}
+
+QFuture<qint64> QFileAsyncIO::write(const QString &fileName, QIODevice::OpenMode mode,
+                                    qint64 offset, const QByteArray &data)
+{
+    auto promise = std::make_shared<QPromise<qint64>>();
+    QFuture<qint64> future = promise->future();
+    promise->start();
+
+    threadPool()->start([promise, fileName, mode, offset, data] {
+        qint64 written = -1;
+        // WriteOnly without Append would truncate the file, so only files
+        // opened for appending can be opened again without read access
+        const QIODevice::OpenMode openMode = mode & QIODevice::Append
+                ? QIODevice::WriteOnly | QIODevice::Append
+                : QIODevice::ReadWrite;
+        QFile file(fileName);
+        if (file.open(openMode)
+                && (mode & QIODevice::Append || file.seek(offset))) {
+            written = file.write(data);
+            if (!file.flush())
+                written = -1;
+        }
+        promise->addResult(written);
+        promise->finish();
+    });
+
+    return future;
+}
+
+QT_END_NAMESPACE
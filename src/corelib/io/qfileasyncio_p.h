@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFILEASYNCIO_P_H
+#define QFILEASYNCIO_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qiodevice.h>
+
+QT_REQUIRE_CONFIG(future);
+
+QT_BEGIN_NAMESPACE
+
+class QThreadPool;
+
+namespace QFileAsyncIO {
+
+QThreadPool *threadPool();
+
+// Reads up to \a maxSize bytes from the current position until the end of
+// \a device. size() is only used to size the first chunk, since files like
+// the ones in /proc and /sys report a size of 0.
+QByteArray readAtMost(QIODevice *device, qint64 maxSize);
+
+// For files without a native descriptor: open the file again by name in a
+// thread of threadPool(). \a mode only matters for QIODevice::Append.
+QFuture<QByteArray> read(const QString &fileName, qint64 offset, qint64 maxSize);
+QFuture<qint64> write(const QString &fileName, QIODevice::OpenMode mode,
+                      qint64 offset, const QByteArray &data);
+
+#ifdef Q_OS_UNIX
+// Both functions take ownership of \a fd and close it once the transfer is
+// done. They use positioned I/O, so the offset of the file description the
+// descriptor was duplicated from is left untouched.
+QFuture<QByteArray> read(int fd, qint64 offset, qint64 maxSize);
+QFuture<qint64> write(int fd, qint64 offset, const QByteArray &data);
+
+enum class Backend {
+    ThreadPool,
+    IoUring
+};
+Q_AUTOTEST_EXPORT Backend backend();
+// Backend::ThreadPool makes later requests run on threadPool() even if
+// io_uring is available; Backend::IoUring undoes that.
+Q_AUTOTEST_EXPORT void setBackend(Backend backend);
+#endif
+
+} // namespace QFileAsyncIO
+
+QT_END_NAMESPACE
+
+#endif // QFILEASYNCIO_P_H
@@ -0,0 +1,565 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+#include "qfileasyncio_p.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qset.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/private/qcore_unix_p.h>
+
+#if QT_CONFIG(io_uring)
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Linux never transfers more than this in a single read() or write()
+constexpr qint64 MaxTransferSize = 0x7ffff000;
+// reads grow their buffer by at least this much once it is full
+constexpr qint64 ReadChunkSize = 16384;
+
+class AsyncRequest
+{
+public:
+    enum Operation { Read, Write };
+
+    AsyncRequest(Operation operation, int fd, qint64 offset, QByteArray buffer, qint64 limit)
+        : operation(operation), fd(fd), offset(offset), limit(limit), buffer(std::move(buffer))
+    { }
+    virtual ~AsyncRequest() { qt_safe_close(fd); }
+
+    // reads own their buffer, writes must not detach the caller's data
+    char *nextData()
+    {
+        char *data = operation == Read ? buffer.data() : const_cast<char *>(buffer.constData());
+        return data + transferred;
+    }
+    qint64 nextOffset() const { return offset + transferred; }
+    qint64 nextLength() const { return qMin(buffer.size() - transferred, MaxTransferSize); }
+
+    // Accounts for a transfer that returned \a result, which is either a byte
+    // count or a negated errno value. Returns true once nothing is left to do.
+    bool advance(qint64 result)
+    {
+        if (result == -EINTR || result == -EAGAIN)
+            return false;
+        if (result < 0) {
+            error = int(-result);
+            return true;
+        }
+        transferred += result;
+        if (result == 0 || transferred == limit)
+            return true;
+        // the size of the file was only a guess, keep reading until EOF
+        if (transferred == buffer.size())
+            buffer.resize(qMin(limit, qMax(2 * buffer.size(), ReadChunkSize)));
+        return false;
+    }
+
+    void runBlocking()
+    {
+        qint64 result;
+        do {
+            if (operation == Read)
+                result = ::pread(fd, nextData(), size_t(nextLength()), QT_OFF_T(nextOffset()));
+            else
+                result = ::pwrite(fd, nextData(), size_t(nextLength()), QT_OFF_T(nextOffset()));
+            if (result < 0)
+                result = -errno;
+        } while (!advance(result));
+        finish();
+    }
+
+    virtual void finish() = 0;
+    // Fails the request while the kernel may still refer to its buffer
+    virtual void abandon(int error) = 0;
+
+    const Operation operation;
+    const int fd;
+    const qint64 offset;
+    // reads may grow their buffer up to this size
+    const qint64 limit;
+    QByteArray buffer;
+    qint64 transferred = 0;
+    int error = 0;
+};
+
+class ReadRequest final : public AsyncRequest
+{
+public:
+    ReadRequest(int fd, qint64 offset, qint64 maxSize)
+        : AsyncRequest(Read, fd, offset,
+                       QByteArray(initialSize(fd, offset, maxSize), Qt::Uninitialized), maxSize)
+    {
+        promise.start();
+    }
+
+    // Files in /proc and /sys report a size of 0, so the size only decides
+    // how much to allocate up front.
+    static qsizetype initialSize(int fd, qint64 offset, qint64 maxSize)
+    {
+        QT_STATBUF st;
+        qint64 expected = 0;
+        if (QT_FSTAT(fd, &st) == 0 && S_ISREG(st.st_mode))
+            expected = qMax(qint64(st.st_size) - offset, qint64(0));
+        return qsizetype(qMin(maxSize, expected + ReadChunkSize));
+    }
+
+    void finish() override
+    {
+        // like QIODevice::read(), a failure that happens before any data
+        // arrived yields an empty array
+        buffer.truncate(transferred);
+        promise.addResult(std::move(buffer));
+        promise.finish();
+    }
+
+    void abandon(int) override
+    {
+        promise.addResult(QByteArray());
+        promise.finish();
+    }
+
+    QPromise<QByteArray> promise;
+};
+
+class WriteRequest final : public AsyncRequest
+{
+public:
+    WriteRequest(int fd, qint64 offset, const QByteArray &data)
+        : AsyncRequest(Write, fd, offset, data, data.size())
+    {
+        promise.start();
+    }
+
+    void finish() override
+    {
+        promise.addResult(error && !transferred ? qint64(-1) : transferred);
+        promise.finish();
+    }
+
+    void abandon(int e) override
+    {
+        error = e;
+        finish();
+    }
+
+    QPromise<qint64> promise;
+};
+
+} // unnamed namespace
+
+static void runInThreadPool(AsyncRequest *request)
+{
+    QFileAsyncIO::threadPool()->start([request]() {
+        request->runBlocking();
+        delete request;
+    });
+}
+
+#if QT_CONFIG(io_uring)
+/*
+    A minimal io_uring(7) client. Callers submit from any thread under
+    submitMutex; a single reaper thread waits for completions, resubmits
+    partial transfers and fulfills the promises. The number of requests in
+    flight is capped at the size of the submission queue, which keeps the
+    completion queue (twice as large) from ever overflowing. When the cap is
+    reached, or the kernel does not take the request, submit() fails and the
+    request goes to the thread pool instead.
+    The reaper only quits once every request it knows of has completed, or
+    after failing them if the ring cannot be waited on any more.
+*/
+class QIoUring
+{
+    Q_DISABLE_COPY_MOVE(QIoUring)
+public:
+    QIoUring();
+    ~QIoUring();
+
+    bool isValid() const { return ringFd != -1; }
+    bool submit(AsyncRequest *request);
+
+private:
+    class ReaperThread final : public QThread
+    {
+    public:
+        explicit ReaperThread(QIoUring *ring) : ring(ring) { }
+    protected:
+        void run() override { ring->reapCompletions(); }
+    private:
+        QIoUring *ring;
+    };
+
+    bool setup();
+    void teardown();
+    io_uring_sqe *nextSubmissionEntry();
+    bool enqueue(AsyncRequest *request);
+    bool flushSubmissions();
+    void reapCompletions();
+    void abandonInFlight(int error);
+
+    int ringFd = -1;
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    size_t sqesSize = 0;
+
+    // the ring indices are shared with the kernel
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqMask = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned *cqMask = nullptr;
+    io_uring_cqe *cqes = nullptr;
+
+    QMutex submitMutex;
+    QSemaphore freeSlots;
+    // both guarded by submitMutex
+    QSet<AsyncRequest *> inFlight;
+    bool quitting = false;
+    ReaperThread reaper;
+};
+
+static inline int qt_io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static inline int qt_io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+QIoUring::QIoUring()
+    : reaper(this)
+{
+    if (qEnvironmentVariableIsSet("QT_NO_IO_URING") || !setup()) {
+        teardown();
+        return;
+    }
+    reaper.setObjectName(QStringLiteral("Qt io_uring reaper"));
+    reaper.start();
+}
+
+QIoUring::~QIoUring()
+{
+    if (reaper.isRunning()) {
+        // a NOP without a request wakes the reaper up and tells it to quit
+        {
+            QMutexLocker locker(&submitMutex);
+            quitting = true;
+            io_uring_sqe *sqe = nextSubmissionEntry();
+            sqe->opcode = IORING_OP_NOP;
+            sqe->user_data = 0;
+            if (!flushSubmissions()) {
+                // the reaper cannot be woken up; leave the ring mapped for it,
+                // the process is exiting anyway
+                return;
+            }
+        }
+        reaper.wait();
+    }
+    teardown();
+}
+
+bool QIoUring::setup()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd = qt_io_uring_setup(256, &params);
+    if (ringFd == -1)
+        return false;   // ENOSYS, or disabled by seccomp or sysctl
+
+    // IORING_OP_READ and IORING_OP_WRITE appeared together with this flag (Linux 5.6)
+    if (!(params.features & IORING_FEAT_RW_CUR_POS))
+        return false;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+        return false;
+    if (singleMmap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return false;
+    }
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+        return false;
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    freeSlots.release(int(params.sq_entries));
+    return true;
+}
+
+void QIoUring::teardown()
+{
+    if (sqes != MAP_FAILED)
+        munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    sqRing = cqRing = MAP_FAILED;
+    if (ringFd != -1)
+        qt_safe_close(ringFd);
+    ringFd = -1;
+}
+
+// must be called with submitMutex locked
+io_uring_sqe *QIoUring::nextSubmissionEntry()
+{
+    const unsigned tail = *sqTail;
+    const unsigned index = tail & *sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray[index] = index;
+    // the entry becomes visible to the kernel when the tail moves, which
+    // flushSubmissions() does after the caller has filled it in
+    return sqe;
+}
+
+// must be called with submitMutex locked
+bool QIoUring::enqueue(AsyncRequest *request)
+{
+    io_uring_sqe *sqe = nextSubmissionEntry();
+    sqe->opcode = request->operation == AsyncRequest::Read ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe->fd = request->fd;
+    sqe->off = quint64(request->nextOffset());
+    sqe->addr = quintptr(request->nextData());
+    sqe->len = quint32(request->nextLength());
+    sqe->user_data = quintptr(request);
+    return flushSubmissions();
+}
+
+/*
+    Hands the entry filled in by the caller to the kernel. Without
+    IORING_SETUP_SQPOLL, the kernel only consumes entries inside
+    io_uring_enter(), so if that fails the entry is taken back and the
+    caller keeps the request. Must be called with submitMutex locked.
+*/
+bool QIoUring::flushSubmissions()
+{
+    const unsigned tail = *sqTail;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    int ret;
+    EINTR_LOOP(ret, qt_io_uring_enter(ringFd, 1, 0, 0));
+    if (ret == 1)
+        return true;
+
+    qErrnoWarning("QFileAsyncIO: io_uring_enter failed");
+    __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+    return false;
+}
+
+bool QIoUring::submit(AsyncRequest *request)
+{
+    if (!freeSlots.tryAcquire())
+        return false;
+
+    QMutexLocker locker(&submitMutex);
+    if (quitting) {
+        freeSlots.release();
+        return false;
+    }
+    if (!enqueue(request)) {
+        freeSlots.release();
+        return false;
+    }
+    inFlight.insert(request);
+    return true;
+}
+
+void QIoUring::reapCompletions()
+{
+    bool quit = false;
+    for (;;) {
+        if (qt_io_uring_enter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) == -1 && errno != EINTR) {
+            const int error = errno;
+            qErrnoWarning(error, "QFileAsyncIO: io_uring_enter failed");
+            abandonInFlight(error);
+            return;
+        }
+
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for ( ; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & *cqMask];
+            auto request = reinterpret_cast<AsyncRequest *>(quintptr(cqe.user_data));
+            if (!request) {
+                quit = true;
+                continue;
+            }
+
+            const bool done = request->advance(cqe.res);
+            if (!done) {
+                // partial transfer, the request keeps its slot
+                QMutexLocker locker(&submitMutex);
+                if (enqueue(request))
+                    continue;
+            }
+
+            {
+                QMutexLocker locker(&submitMutex);
+                inFlight.remove(request);
+            }
+            freeSlots.release();
+            if (done) {
+                request->finish();
+                delete request;
+            } else {
+                // the rest of the transfer could not be resubmitted
+                runInThreadPool(request);
+            }
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+        // requests submitted before the quit NOP may complete after it
+        if (quit) {
+            QMutexLocker locker(&submitMutex);
+            if (inFlight.isEmpty())
+                return;
+        }
+    }
+}
+
+/*
+    Fails the requests that have not completed when the reaper can no
+    longer wait for completions, so that no future is left unfinished. The
+    kernel may still write to their buffers, so they are not deleted.
+*/
+void QIoUring::abandonInFlight(int error)
+{
+    QMutexLocker locker(&submitMutex);
+    quitting = true;
+    const QSet<AsyncRequest *> requests = std::exchange(inFlight, {});
+    locker.unlock();
+
+    for (AsyncRequest *request : requests)
+        request->abandon(error);
+}
+
+Q_GLOBAL_STATIC(QIoUring, ioUring)
+#endif // QT_CONFIG(io_uring)
+
+Q_CONSTINIT static QBasicAtomicInt threadPoolForced = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+static void dispatch(AsyncRequest *request)
+{
+#if QT_CONFIG(io_uring)
+    QIoUring *ring = threadPoolForced.loadRelaxed() ? nullptr : ioUring();
+    if (ring && ring->isValid() && ring->submit(request))
+        return;
+#endif
+
+    runInThreadPool(request);
+}
+
+QFuture<QByteArray> QFileAsyncIO::read(int fd, qint64 offset, qint64 maxSize)
+{
+    auto request = new ReadRequest(fd, offset, maxSize);
+    QFuture<QByteArray> future = request->promise.future();
+    dispatch(request);
+    return future;
+}
+
+QFuture<qint64> QFileAsyncIO::write(int fd, qint64 offset, const QByteArray &data)
+{
+    auto request = new WriteRequest(fd, offset, data);
+    QFuture<qint64> future = request->promise.future();
+    dispatch(request);
+    return future;
+}
+
+QFileAsyncIO::Backend QFileAsyncIO::backend()
+{
+#if QT_CONFIG(io_uring)
+    QIoUring *ring = threadPoolForced.loadRelaxed() ? nullptr : ioUring();
+    if (ring && ring->isValid())
+        return Backend::IoUring;
+#endif
+    return Backend::ThreadPool;
+}
+
+void QFileAsyncIO::setBackend(Backend backend)
+{
+    threadPoolForced.storeRelaxed(backend == Backend::ThreadPool);
+}
+
+QT_END_NAMESPACE
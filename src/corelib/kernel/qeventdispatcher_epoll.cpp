@@ -0,0 +1,409 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+
+#include <iterator>
+#include <limits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+static inline quint32 epollEvents(const QSocketNotifierSetUNIX &sn_set)
+{
+    quint32 result = 0;
+
+    if (sn_set.notifiers[QSocketNotifier::Read])
+        result |= EPOLLIN;
+
+    if (sn_set.notifiers[QSocketNotifier::Write])
+        result |= EPOLLOUT;
+
+    if (sn_set.notifiers[QSocketNotifier::Exception])
+        result |= EPOLLPRI;
+
+    return result;
+}
+
+#ifdef SYS_epoll_pwait2
+// epoll_pwait2() takes a timespec, but needs Linux 5.11
+Q_CONSTINIT static QBasicAtomicInt epollPwait2Unsupported = Q_BASIC_ATOMIC_INITIALIZER(0);
+#endif
+
+static inline int timespecToEpollTimeout(const timespec *tm)
+{
+    if (!tm)
+        return -1;
+
+    // round up, so that we do not wake up right before a timer expires
+    // and spin until it does
+    qint64 msecs = qint64(tm->tv_sec) * 1000 + (tm->tv_nsec + 999999) / 1000000;
+    return int(qMin(msecs, qint64(std::numeric_limits<int>::max())));
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (Q_UNLIKELY(epollFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot create epoll instance: %s",
+               qPrintable(qt_error_string(errno)));
+
+    const pollfd pipefd = threadPipe.prepare();
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = pipefd.fd;
+    if (Q_UNLIKELY(epoll_ctl(epollFd, EPOLL_CTL_ADD, pipefd.fd, &ev) == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot watch the thread pipe: %s",
+               qPrintable(qt_error_string(errno)));
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    qt_safe_close(epollFd);
+}
+
+/*!
+    \internal
+
+    Brings the kernel's interest list for \a sockfd in sync with the
+    notifiers registered in socketNotifiers. A descriptor that was closed
+    without disabling its notifiers first is dropped from the epoll set by
+    the kernel, and a new descriptor may reuse its number, so a failed
+    EPOLL_CTL_MOD is retried as EPOLL_CTL_ADD.
+
+    Regular files and directories cannot be added to an epoll set. poll()
+    reports them as always readable and writable, so they are kept in
+    alwaysReadySockets instead.
+*/
+void QEventDispatcherEpollPrivate::updateRegistration(int sockfd)
+{
+    const auto it = socketNotifiers.constFind(sockfd);
+    if (it == socketNotifiers.cend()) {
+        // ENOENT and EBADF mean the kernel already forgot about the descriptor
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, sockfd, nullptr);
+        invalidSockets.removeOne(sockfd);
+        alwaysReadySockets.removeOne(sockfd);
+        return;
+    }
+
+    epoll_event ev = {};
+    ev.events = epollEvents(it.value());
+    ev.data.fd = sockfd;
+
+    // the descriptor number may have been reused for a different kind of file
+    alwaysReadySockets.removeOne(sockfd);
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, sockfd, &ev) == 0)
+        return;
+    if (errno == ENOENT && epoll_ctl(epollFd, EPOLL_CTL_ADD, sockfd, &ev) == 0)
+        return;
+    if (errno == EPERM) {
+        alwaysReadySockets.append(sockfd);
+        return;
+    }
+
+    // Most likely EBADF. poll() would report POLLNVAL for it on the next
+    // call, so defer disabling the notifiers until then as well.
+    if (!invalidSockets.contains(sockfd))
+        invalidSockets.append(sockfd);
+}
+
+/*!
+    \internal
+
+    Same as the POLLNVAL handling of the poll()-based dispatcher: disables
+    all notifiers of the descriptors that could not be added to the epoll
+    set.
+*/
+void QEventDispatcherEpollPrivate::disableInvalidSockets()
+{
+    static const char *const socketTypes[] = { "Read", "Write", "Exception" };
+
+    const QList<int> sockets = std::exchange(invalidSockets, {});
+    for (int sockfd : sockets) {
+        const auto it = socketNotifiers.constFind(sockfd);
+        if (it == socketNotifiers.cend())
+            continue;
+
+        // disabling a notifier modifies socketNotifiers, so work on a copy
+        const QSocketNotifierSetUNIX sn_set = it.value();
+        for (int type = 0; type < 3; ++type) {
+            QSocketNotifier *notifier = sn_set.notifiers[type];
+            if (!notifier)
+                continue;
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     sockfd, socketTypes[type]);
+            notifier->setEnabled(false);
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Waits for at most \a tm (forever if \c nullptr) and returns the number of
+    entries filled in readyEvents, or -1 on error.
+*/
+int QEventDispatcherEpollPrivate::waitForEvents(const timespec *tm)
+{
+    int nevents;
+#ifdef SYS_epoll_pwait2
+    if (!epollPwait2Unsupported.loadRelaxed()) {
+        nevents = int(syscall(SYS_epoll_pwait2, epollFd, readyEvents,
+                              int(std::size(readyEvents)), tm, nullptr, 0));
+        if (nevents != -1 || errno != ENOSYS) {
+            if (nevents == -1 && errno == EINTR)
+                return 0;
+            return nevents;
+        }
+        epollPwait2Unsupported.storeRelaxed(1);
+    }
+#endif
+
+    const int timeout = timespecToEpollTimeout(tm);
+    nevents = epoll_wait(epollFd, readyEvents, int(std::size(readyEvents)), timeout);
+    if (nevents == -1 && errno == EINTR)
+        return 0;   // the caller loops and recalculates the timers anyway
+    return nevents;
+}
+
+/*!
+    \internal
+
+    Consumes the thread pipe and queues the notifiers for the first \a nevents
+    entries of readyEvents. Returns the number of thread pipe wake-ups seen,
+    which is either 0 or 1.
+*/
+int QEventDispatcherEpollPrivate::processReadyEvents(int nevents)
+{
+    static const struct {
+        QSocketNotifier::Type type;
+        quint32 flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      EPOLLIN  | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Write,     EPOLLOUT | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Exception, EPOLLPRI | EPOLLHUP | EPOLLERR }
+    };
+
+    int wakeUps = 0;
+    pollfd pipefd = threadPipe.prepare();
+
+    for (int i = 0; i < nevents; ++i) {
+        const epoll_event &ev = readyEvents[i];
+
+        if (ev.data.fd == pipefd.fd) {
+            pipefd.revents = (ev.events & EPOLLIN) ? POLLIN : 0;
+            wakeUps += threadPipe.check(pipefd);
+            continue;
+        }
+
+        auto it = socketNotifiers.constFind(ev.data.fd);
+        if (it == socketNotifiers.cend())
+            continue;
+
+        const QSocketNotifierSetUNIX &sn_set = it.value();
+        for (const auto &n : notifiers) {
+            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+            if (notifier && (ev.events & n.flags))
+                setSocketNotifierPending(notifier);
+        }
+    }
+
+    return wakeUps;
+}
+
+/*!
+    \internal
+
+    Queues the read and write notifiers of the descriptors in
+    alwaysReadySockets, like poll() reports them.
+*/
+void QEventDispatcherEpollPrivate::markAlwaysReadySockets()
+{
+    for (int sockfd : std::as_const(alwaysReadySockets)) {
+        const auto it = socketNotifiers.constFind(sockfd);
+        if (it == socketNotifiers.cend())
+            continue;
+        for (auto type : { QSocketNotifier::Read, QSocketNotifier::Write }) {
+            if (QSocketNotifier *notifier = it.value().notifiers[type])
+                setSocketNotifierPending(notifier);
+        }
+    }
+}
+
+/*!
+    \internal
+    \class QEventDispatcherEpoll
+
+    \brief An event dispatcher for Linux that waits with epoll(7) instead of
+    poll(2).
+
+    QEventDispatcherUNIX builds a fresh pollfd array out of every registered
+    QSocketNotifier each time it blocks, and scans all of it again when poll()
+    returns, so the cost of a single wake-up grows with the number of
+    notifiers. This dispatcher keeps the descriptors registered with the
+    kernel and only looks at the ones that became ready, which makes a wake-up
+    independent of the number of idle sockets.
+
+    Timers, posted events and the thread pipe are shared with
+    QEventDispatcherUNIX. Timeouts are passed to the kernel in nanoseconds
+    with epoll_pwait2(); on kernels older than Linux 5.11 they are rounded up
+    to whole milliseconds, which is coarser than poll() and Qt::PreciseTimer.
+    It is selected by setting the
+    \c QT_EVENT_DISPATCHER_EPOLL environment variable to a positive value, or
+    by installing it with QThread::setEventDispatcher() or
+    QCoreApplication::setEventDispatcher().
+*/
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QEventDispatcherUNIX(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QEventDispatcherUNIX(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{ }
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    QEventDispatcherUNIX::registerSocketNotifier(notifier);
+
+    Q_D(QEventDispatcherEpoll);
+    d->updateRegistration(notifier->socket());
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    QEventDispatcherUNIX::unregisterSocketNotifier(notifier);
+
+    Q_D(QEventDispatcherEpoll);
+    d->updateRegistration(notifier->socket());
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(0);
+
+    // we are awake, broadcast it
+    emit awake();
+
+    auto threadData = d->threadData.loadRelaxed();
+    QCoreApplicationPrivate::sendPostedEvents(nullptr, 0, threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool include_notifiers = (flags & QEventLoop::ExcludeSocketNotifiers) == 0;
+    const bool wait_for_events = (flags & QEventLoop::WaitForMoreEvents) != 0;
+
+    const bool canWait = (threadData->canWaitLocked()
+                          && !d->interrupt.loadRelaxed()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.loadRelaxed())
+        return false;
+
+    timespec *tm = nullptr;
+    timespec wait_tm = { 0, 0 };
+
+    if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
+        tm = &wait_tm;
+
+    // don't block when there are invalid or always ready sockets to report,
+    // like poll() would
+    if (include_notifiers
+            && (!d->invalidSockets.isEmpty() || !d->alwaysReadySockets.isEmpty())) {
+        wait_tm = { 0, 0 };
+        tm = &wait_tm;
+    }
+
+    int nevents = 0;
+
+    if (include_notifiers) {
+        const int nready = d->waitForEvents(tm);
+        if (nready == -1)
+            perror("epoll_wait");
+        else if (nready > 0)
+            nevents += d->processReadyEvents(nready);
+        d->markAlwaysReadySockets();
+        d->disableInvalidSockets();
+        nevents += d->activateSocketNotifiers();
+    } else {
+        // The sockets stay in the epoll set, so only wait on the thread pipe
+        pollfd pipefd = d->threadPipe.prepare();
+        switch (qt_safe_poll(&pipefd, 1, tm)) {
+        case -1:
+            perror("qt_safe_poll");
+            break;
+        case 0:
+            break;
+        default:
+            nevents += d->threadPipe.check(pipefd);
+            break;
+        }
+    }
+
+    if (include_timers)
+        nevents += d->activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_epoll_p.cpp"
@@ -2404,7 +2404,6 @@ bool QMetaMethod::invoke(QObject *object,
 
         auto event = std::make_unique<QMetaCallEvent>(idx_offset, idx_relative, callFunction, nullptr, -1, paramCount);
         QMetaType *types = event->types();
-        void **args = event->args();
 
         int argIndex = 0;
         for (int i = 1; i < paramCount; ++i) {
@@ -2420,11 +2419,10 @@ bool QMetaMethod::invoke(QObject *object,
                     return false;
                 }
             }
-            if (types[i].isValid()) {
-                args[i] = QMetaType(types[i]).create(param[i]);
+            if (types[i].isValid())
                 ++argIndex;
-            }
         }
+        event->copyArguments(param);
 
         QCoreApplication::postEvent(object, event.release());
     } else { // blocking queued connection
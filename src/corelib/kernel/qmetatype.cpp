@@ -44,6 +44,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
+#include "qmutex.h"
 #include "qreadwritelock.h"
 #include "qhash.h"
 #include "qmap.h"
@@ -94,6 +95,8 @@
 #include <bitset>
 #include <new>
 #include <cstring>
+#include <memory>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -103,18 +106,199 @@ QT_IMPL_METATYPE_EXTERN_TAGGED(QtMetaTypePrivate::QPairVariantInterfaceImpl, QPa
 
 namespace {
 
+// Maps the names of custom types to their interfaces. Lookups don't lock:
+// the table is only ever replaced by a larger copy, and its nodes are never
+// removed, only their interface is reset when a type is unregistered.
+// Modifications must be serialized by the caller.
+class QMetaTypeNameIndex
+{
+    struct Node
+    {
+        size_t hash;
+        QByteArray name;
+        QAtomicPointer<const QtPrivate::QMetaTypeInterface> iface;
+    };
+
+    struct Table
+    {
+        explicit Table(size_t capacity)
+            : capacity(capacity), nodes(new QAtomicPointer<Node>[capacity])
+        {}
+
+        size_t capacity;                    // a power of two
+        std::unique_ptr<QAtomicPointer<Node>[]> nodes;
+        std::unique_ptr<Table> previous;    // may still be read by a lookup
+    };
+
+    QAtomicPointer<Table> table;
+    size_t count = 0;
+
+    static Node *find(const Table *t, QByteArrayView name, size_t hash)
+    {
+        const size_t mask = t->capacity - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            Node *node = t->nodes[i].loadAcquire();
+            if (!node || (node->hash == hash && node->name == name))
+                return node;
+        }
+    }
+
+    static void place(Table *t, Node *node)
+    {
+        const size_t mask = t->capacity - 1;
+        size_t i = node->hash & mask;
+        while (t->nodes[i].loadRelaxed())
+            i = (i + 1) & mask;
+        t->nodes[i].storeRelease(node);
+    }
+
+    Table *grow()
+    {
+        Table *old = table.loadRelaxed();
+        Table *t = new Table(old ? 2 * old->capacity : 64);
+        if (old) {
+            for (size_t i = 0; i < old->capacity; ++i) {
+                if (Node *node = old->nodes[i].loadRelaxed())
+                    place(t, node);
+            }
+            t->previous.reset(old);
+        }
+        table.storeRelease(t);
+        return t;
+    }
+
+public:
+    ~QMetaTypeNameIndex()
+    {
+        if (Table *t = table.loadRelaxed()) {
+            for (size_t i = 0; i < t->capacity; ++i)
+                delete t->nodes[i].loadRelaxed();
+            delete t;
+        }
+    }
+
+    const QtPrivate::QMetaTypeInterface *value(QByteArrayView name) const
+    {
+        const Table *t = table.loadAcquire();
+        if (!t)
+            return nullptr;
+        const Node *node = find(t, name, qHash(name));
+        return node ? node->iface.loadAcquire() : nullptr;
+    }
+
+    // Returns the interface already registered under name, or makes it
+    // refer to iface and returns nullptr
+    const QtPrivate::QMetaTypeInterface *tryInsert(const QByteArray &name,
+                                                   const QtPrivate::QMetaTypeInterface *iface)
+    {
+        const size_t hash = qHash(name);
+        Table *t = table.loadRelaxed();
+        if (t) {
+            if (Node *node = find(t, name, hash)) {
+                if (auto existing = node->iface.loadRelaxed())
+                    return existing;
+                node->iface.storeRelease(iface);
+                return nullptr;
+            }
+        }
+        if (!t || 2 * (count + 1) > t->capacity)
+            t = grow();
+        place(t, new Node{hash, name, iface});
+        ++count;
+        return nullptr;
+    }
+
+    // removes all names of iface
+    void remove(const QtPrivate::QMetaTypeInterface *iface)
+    {
+        forEach([iface](Node *node) {
+            if (node->iface.loadRelaxed() == iface)
+                node->iface.storeRelease(nullptr);
+        });
+    }
+
+    template <typename Func>
+    void forEachName(Func func) const
+    {
+        forEach([&func](const Node *node) {
+            if (auto iface = node->iface.loadRelaxed())
+                func(node->name, iface);
+        });
+    }
+
+private:
+    template <typename Func>
+    void forEach(Func func) const
+    {
+        if (const Table *t = table.loadRelaxed()) {
+            for (size_t i = 0; i < t->capacity; ++i) {
+                if (Node *node = t->nodes[i].loadRelaxed())
+                    func(node);
+            }
+        }
+    }
+};
+
+// Custom types by index. The chunks double in size and never move, so that
+// lookups don't lock either. Modifications must be serialized by the caller.
+class QMetaTypeIdTable
+{
+    using Entry = QAtomicPointer<const QtPrivate::QMetaTypeInterface>;
+    static constexpr uint FirstChunkSize = 32;
+    static constexpr int ChunkCount = 27;   // enough for any non-negative int
+
+    QAtomicPointer<Entry> chunks[ChunkCount] = {};
+
+    static std::pair<int, uint> locate(int index)
+    {
+        const int chunk = int(31 - qCountLeadingZeroBits(uint(index) / FirstChunkSize + 1));
+        return { chunk, uint(index) - FirstChunkSize * ((1u << chunk) - 1) };
+    }
+
+public:
+    ~QMetaTypeIdTable()
+    {
+        for (const auto &chunk : chunks)
+            delete[] chunk.loadRelaxed();
+    }
+
+    const QtPrivate::QMetaTypeInterface *value(int index) const
+    {
+        if (index < 0)
+            return nullptr;
+        const auto [chunk, offset] = locate(index);
+        const Entry *entries = chunks[chunk].loadAcquire();
+        return entries ? entries[offset].loadAcquire() : nullptr;
+    }
+
+    void set(int index, const QtPrivate::QMetaTypeInterface *iface)
+    {
+        Q_ASSERT(index >= 0);
+        const auto [chunk, offset] = locate(index);
+        Entry *entries = chunks[chunk].loadRelaxed();
+        if (!entries) {
+            entries = new Entry[FirstChunkSize << chunk];
+            chunks[chunk].storeRelease(entries);
+        }
+        entries[offset].storeRelease(iface);
+    }
+};
+
 struct QMetaTypeCustomRegistry
 {
-    QReadWriteLock lock;
-    QList<const QtPrivate::QMetaTypeInterface *> registry;
-    QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    // serializes registration; lookups by id or name don't take it
+    QMutex lock;
+    QMetaTypeIdTable registry;
+    QMetaTypeNameIndex aliases;
+    // number of entries in registry that have ever been used
+    int size = 0;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
 
     int registerCustomType(const QtPrivate::QMetaTypeInterface *ti)
     {
         {
-            QWriteLocker l(&lock);
+            QMutexLocker l(&lock);
             if (ti->typeId)
                 return ti->typeId;
             QByteArray name =
@@ -126,18 +310,15 @@ struct QMetaTypeCustomRegistry
                 ti->typeId.storeRelaxed(ti2->typeId.loadRelaxed());
                 return ti2->typeId;
             }
-            aliases[name] = ti;
-            int size = registry.size();
-            while (firstEmpty < size && registry[firstEmpty])
+            while (firstEmpty < size && registry.value(firstEmpty))
                 ++firstEmpty;
-            if (firstEmpty < size) {
-                registry[firstEmpty] = ti;
-                ++firstEmpty;
-            } else {
-                registry.append(ti);
-                firstEmpty = registry.size();
-            }
+            registry.set(firstEmpty, ti);
+            if (firstEmpty == size)
+                ++size;
+            ++firstEmpty;
             ti->typeId = firstEmpty + QMetaType::User;
+            // only now can a lookup by name find the type, with its id set
+            aliases.tryInsert(name, ti);
         }
         if (ti->legacyRegisterOp)
             ti->legacyRegisterOp();
@@ -149,27 +330,19 @@ struct QMetaTypeCustomRegistry
         if (!id)
             return;
         Q_ASSERT(id > QMetaType::User);
-        QWriteLocker l(&lock);
+        QMutexLocker l(&lock);
         int idx = id - QMetaType::User - 1;
-        auto &ti = registry[idx];
 
         // We must unregister all names.
-        auto it = aliases.begin();
-        while (it != aliases.end()) {
-            if (it.value() == ti)
-                it = aliases.erase(it);
-            else
-                ++it;
-        }
-
-        ti = nullptr;
+        if (auto ti = registry.value(idx))
+            aliases.remove(ti);
+        registry.set(idx, nullptr);
 
         firstEmpty = std::min(firstEmpty, idx);
     }
 
     const QtPrivate::QMetaTypeInterface *getCustomType(int id)
     {
-        QReadLocker l(&lock);
         return registry.value(id - QMetaType::User - 1);
     }
 };
@@ -188,25 +361,22 @@ const char *QtMetaTypePrivate::typedefNameForType(const QtPrivate::QMetaTypeInte
         return name;
 
     QByteArrayView officialName(type_d->name);
-    QReadLocker l(&r->lock);
-    auto it = r->aliases.constBegin();
-    auto end = r->aliases.constEnd();
-    for ( ; it != end; ++it) {
-        if (it.value() != type_d)
-            continue;
-        if (it.key() == officialName)
-            continue;               // skip the official name
-        name = it.key().constData();
-        ++it;
-        break;
-    }
-
 #ifndef QT_NO_DEBUG
     QByteArrayList otherNames;
-    for ( ; it != end; ++it) {
-        if (it.value() == type_d && it.key() != officialName)
-            otherNames << it.key();
-    }
+#endif
+    QMutexLocker l(&r->lock);
+    r->aliases.forEachName([&](const QByteArray &alias, const QtPrivate::QMetaTypeInterface *iface) {
+        if (iface != type_d || alias == officialName)
+            return;                 // skip the official name
+        if (!name)
+            name = alias.constData();
+#ifndef QT_NO_DEBUG
+        else
+            otherNames << alias;
+#endif
+    });
+
+#ifndef QT_NO_DEBUG
     if (!otherNames.isEmpty())
         qWarning("QMetaType: type %s has more than one typedef alias: %s, %s",
                  type_d->name, name, otherNames.join(", ").constData());
@@ -2574,18 +2744,13 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 
 /*
     Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
-
+    types. This doesn't lock.
 */
-static int qMetaTypeCustomType_unlocked(const char *typeName, int length)
+static int qMetaTypeCustomType(const char *typeName, int length)
 {
     if (auto reg = customTypeRegistry()) {
-#if QT_CONFIG(thread)
-        Q_ASSERT(!reg->lock.tryLockForWrite());
-#endif
-        if (auto ti = reg->aliases.value(QByteArray(typeName, length), nullptr)) {
+        if (auto ti = reg->aliases.value(QByteArrayView(typeName, length)))
             return ti->typeId;
-        }
     }
     return QMetaType::UnknownType;
 }
@@ -2603,11 +2768,8 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
     if (!metaType.isValid())
         return;
     if (auto reg = customTypeRegistry()) {
-        QWriteLocker lock(&reg->lock);
-        auto &al = reg->aliases[normalizedTypeName];
-        if (al)
-            return;
-        al = metaType.d_ptr;
+        QMutexLocker lock(&reg->lock);
+        reg->aliases.tryInsert(normalizedTypeName, metaType.d_ptr);
     }
 }
 
@@ -2629,16 +2791,15 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
-        type = qMetaTypeCustomType_unlocked(typeName, length);
+        type = qMetaTypeCustomType(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
             const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
             type = qMetaTypeStaticType(normalizedTypeName.constData(),
                                        normalizedTypeName.size());
             if (type == QMetaType::UnknownType) {
-                type = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                                    normalizedTypeName.size());
+                type = qMetaTypeCustomType(normalizedTypeName.constData(),
+                                           normalizedTypeName.size());
             }
         }
 #endif
@@ -523,6 +523,115 @@ QAbstractMetaCallEvent::~QAbstractMetaCallEvent()
 #endif
 }
 
+namespace {
+// QMetaCallEvents are usually created in one thread and deleted in another.
+// Each thread keeps the memory of the events it deleted for the next ones it
+// creates, and hands batches of it to other threads through a shared depot,
+// so that a thread which only emits doesn't go to the allocator every time.
+enum { MetaCallEventBatchSize = 32, MetaCallEventDepotSize = 16 };
+
+struct MetaCallEventCache
+{
+    void *blocks[2 * MetaCallEventBatchSize] = {};
+    int count = 0;
+
+    MetaCallEventCache() noexcept;
+    ~MetaCallEventCache();
+};
+
+struct MetaCallEventDepot
+{
+    QBasicMutex mutex;
+    void *batches[MetaCallEventDepotSize][MetaCallEventBatchSize];
+    int count;
+};
+}
+
+Q_CONSTINIT static MetaCallEventDepot metaCallEventDepot = {};
+// Points to the thread's cache while it exists. Events can still be deleted
+// after the cache has been destroyed at thread exit, when the thread's
+// QThreadData is torn down; they see nullptr.
+Q_CONSTINIT static thread_local MetaCallEventCache *metaCallEventCache = nullptr;
+Q_CONSTINIT static thread_local bool metaCallEventCacheDestroyed = false;
+
+MetaCallEventCache::MetaCallEventCache() noexcept
+{
+    metaCallEventCache = this;
+}
+
+MetaCallEventCache::~MetaCallEventCache()
+{
+    metaCallEventCache = nullptr;
+    metaCallEventCacheDestroyed = true;
+    while (count)
+        ::operator delete(blocks[--count]);
+}
+
+static MetaCallEventCache *currentMetaCallEventCache() noexcept
+{
+    // don't create the cache again once it has been destroyed
+    if (Q_LIKELY(metaCallEventCache) || metaCallEventCacheDestroyed)
+        return metaCallEventCache;
+    static thread_local MetaCallEventCache cache;
+    return &cache;
+}
+
+/*!
+    \internal
+ */
+void *QMetaCallEvent::operator new(size_t size)
+{
+    // classes derived from QMetaCallEvent get plain allocations
+    MetaCallEventCache *cache = size == sizeof(QMetaCallEvent)
+            ? currentMetaCallEventCache() : nullptr;
+    if (!cache)
+        return ::operator new(size);
+    if (Q_LIKELY(cache->count))
+        return cache->blocks[--cache->count];
+
+    MetaCallEventDepot &depot = metaCallEventDepot;
+    QMutexLocker locker(&depot.mutex);
+    if (depot.count) {
+        --depot.count;
+        memcpy(cache->blocks, depot.batches[depot.count], sizeof(depot.batches[0]));
+        cache->count = MetaCallEventBatchSize - 1;
+        return cache->blocks[MetaCallEventBatchSize - 1];
+    }
+    locker.unlock();
+    return ::operator new(size);
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr, size_t size) noexcept
+{
+    MetaCallEventCache *cache = size == sizeof(QMetaCallEvent)
+            ? currentMetaCallEventCache() : nullptr;
+    if (!cache) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    if (Q_UNLIKELY(cache->count == 2 * MetaCallEventBatchSize)) {
+        // pass the older half on; free it if nobody has been taking any
+        cache->count -= MetaCallEventBatchSize;
+        MetaCallEventDepot &depot = metaCallEventDepot;
+        QMutexLocker locker(&depot.mutex);
+        if (depot.count < MetaCallEventDepotSize) {
+            memcpy(depot.batches[depot.count], cache->blocks, sizeof(depot.batches[0]));
+            ++depot.count;
+        } else {
+            locker.unlock();
+            for (int i = 0; i < MetaCallEventBatchSize; ++i)
+                ::operator delete(cache->blocks[i]);
+        }
+        memcpy(cache->blocks, cache->blocks + MetaCallEventBatchSize,
+               MetaCallEventBatchSize * sizeof(void *));
+    }
+    cache->blocks[cache->count++] = ptr;
+}
+
 /*!
     \internal
  */
@@ -615,7 +724,11 @@ QMetaCallEvent::~QMetaCallEvent()
     if (d.nargs_) {
         QMetaType *t = types();
         for (int i = 0; i < d.nargs_; ++i) {
-            if (t[i].isValid() && d.args_[i])
+            if (!t[i].isValid() || !d.args_[i])
+                continue;
+            if (isInlineArgument(d.args_[i]))
+                t[i].destruct(d.args_[i]);
+            else
                 t[i].destroy(d.args_[i]);
         }
         if (reinterpret_cast<void *>(d.args_) != reinterpret_cast<void *>(prealloc_))
@@ -625,6 +738,32 @@ QMetaCallEvent::~QMetaCallEvent()
         d.slotObj_->destroyIfLastRef();
 }
 
+/*!
+    \internal
+
+    Copies the values \a argv points to into the event, for each argument
+    whose type is valid. Values that fit are constructed in storage inside
+    the event, the others are allocated.
+ */
+void QMetaCallEvent::copyArguments(const void * const *argv)
+{
+    const QMetaType *t = types();
+    size_t used = 0;
+    for (int n = 1; n < d.nargs_; ++n) {
+        if (!t[n].isValid())
+            continue;
+        const size_t alignment = t[n].alignOf();
+        const size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (alignment <= alignof(std::max_align_t)
+                && offset + t[n].sizeOf() <= sizeof(argStorage_)) {
+            d.args_[n] = t[n].construct(argStorage_ + offset, argv[n]);
+            used = offset + t[n].sizeOf();
+        } else {
+            d.args_[n] = t[n].create(argv[n]);
+        }
+    }
+}
+
 /*!
     \internal
  */
@@ -1132,6 +1271,7 @@ QObjectPrivate::Connection::~Connection()
     }
     if (isSlotObject)
         slotObj->destroyIfLastRef();
+    delete coalescedEvent.loadAcquire();
 }
 
 
@@ -3463,6 +3603,9 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -3480,6 +3623,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3777,6 +3921,42 @@ private:
     QtPrivate::QSlotObjectBase *m_slotObject = nullptr;
 };
 
+/*!
+    \internal
+
+    The event a Qt::CoalescedConnection posts. It holds no arguments itself,
+    but delivers whichever call its connection has stored last.
+*/
+class QCoalescedMetaCallEvent : public QAbstractMetaCallEvent
+{
+public:
+    QCoalescedMetaCallEvent(QObjectPrivate::Connection *c, const QObject *sender, int signalId)
+        : QAbstractMetaCallEvent(sender, signalId), connection(c)
+    {
+        connection->ref();
+    }
+
+    ~QCoalescedMetaCallEvent() override
+    {
+        // Once delivered, a stored call belongs to the next event
+        if (!delivered)
+            delete connection->coalescedEvent.fetchAndStoreOrdered(nullptr);
+        connection->deref();
+    }
+
+    void placeMetaCall(QObject *object) override
+    {
+        delivered = true;
+        std::unique_ptr<QMetaCallEvent> ev(connection->coalescedEvent.fetchAndStoreOrdered(nullptr));
+        if (ev)
+            ev->placeMetaCall(object);
+    }
+
+private:
+    QObjectPrivate::Connection *connection;
+    bool delivered = false;
+};
+
 /*!
     \internal
 
@@ -3826,8 +4006,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         for (int n = 1; n < nargs; ++n)
             types[n] = QMetaType(argumentTypes[n - 1]);
 
-        for (int n = 1; n < nargs; ++n)
-            args[n] = types[n].create(argv[n]);
+        ev->copyArguments(argv);
     }
 
     if (c->isSingleShot && !QObjectPrivate::disconnect(c)) {
@@ -3843,6 +4022,18 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
+    if (c->isCoalesced) {
+        // Only the first emission after a delivery posts an event, later
+        // ones just replace the arguments that event will pick up
+        if (QMetaCallEvent *previous = c->coalescedEvent.fetchAndStoreOrdered(ev)) {
+            locker.unlock();
+            delete previous;
+            return;
+        }
+        QCoreApplication::postEvent(receiver, new QCoalescedMetaCallEvent(c, sender, signal));
+        return;
+    }
+
     QCoreApplication::postEvent(receiver, ev);
 }
 
@@ -5094,6 +5285,9 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -5112,6 +5306,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
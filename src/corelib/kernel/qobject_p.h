@@ -70,6 +70,7 @@ QT_BEGIN_NAMESPACE
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+class QMetaCallEvent;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -181,7 +182,10 @@ public:
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
         ushort isSingleShot : 1;
-        Connection() : ref_(2), ownArgumentTypes(true) {
+        ushort isCoalesced : 1;
+        // the call a coalesced connection has queued but not delivered yet
+        QAtomicPointer<QMetaCallEvent> coalescedEvent;
+        Connection() : ref_(2), ownArgumentTypes(true), isCoalesced(false) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -631,6 +635,10 @@ public:
 
     ~QMetaCallEvent() override;
 
+    // events come from a per-thread pool, see qobject.cpp
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size) noexcept;
+
     inline int id() const { return d.method_offset_ + d.method_relative_; }
     inline const void * const* args() const { return d.args_; }
     inline void ** args() { return d.args_; }
@@ -639,8 +647,17 @@ public:
 
     virtual void placeMetaCall(QObject *object) override;
 
+    // copies the arguments with a valid type after the types have been set
+    void copyArguments(const void * const *argv);
+
 private:
     inline void allocArgs();
+    inline bool isInlineArgument(const void *arg) const noexcept
+    {
+        const quintptr address = quintptr(arg);
+        return address >= quintptr(argStorage_)
+                && address < quintptr(argStorage_) + sizeof(argStorage_);
+    }
 
     struct Data {
         QtPrivate::QSlotObjectBase *slotObj_;
@@ -652,6 +669,8 @@ private:
     } d;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
+    // and for small argument values, so that copying them doesn't allocate
+    alignas(std::max_align_t) char argStorage_[6 * sizeof(void *)];
 };
 
 class QBoolBlocker
@@ -40,6 +40,7 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
@@ -53,6 +54,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
@@ -84,6 +87,7 @@ QTimerInfoList::QTimerInfoList()
 #endif
 
     firstTimerInfo = nullptr;
+    insertionCount = 0;
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -171,17 +175,109 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  The timers are kept in a 4-ary min-heap: the children of the timer at
+  index i are at 4 * i + 1 to 4 * i + 4. Timers with equal timeouts fire in
+  the order they were inserted, as they did when the list was sorted.
 */
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
+static constexpr qsizetype TimerHeapArity = 4;
+
+static inline bool firesBefore(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout.tv_sec != t2->timeout.tv_sec)
+        return t1->timeout.tv_sec < t2->timeout.tv_sec;
+    if (t1->timeout.tv_nsec != t2->timeout.tv_nsec)
+        return t1->timeout.tv_nsec < t2->timeout.tv_nsec;
+    return t1->sequence < t2->sequence;
+}
+
+/*
+  Calls visit for the timers in list in heap order, descending only below
+  those for which it returns true.
+*/
+template <typename Visitor>
+static void visitTimerHeap(const QTimerInfoList &list, Visitor visit)
+{
+    if (list.isEmpty())
+        return;
+    QVarLengthArray<qsizetype, 64> pending;
+    pending.append(0);
+    while (!pending.isEmpty()) {
+        const qsizetype index = pending.last();
+        pending.removeLast();
+        if (!visit(list.at(index)))
+            continue;
+        const qsizetype first = index * TimerHeapArity + 1;
+        const qsizetype last = qMin(first + TimerHeapArity, list.size());
+        for (qsizetype child = first; child < last; ++child)
+            pending.append(child);
+    }
+}
+
+void QTimerInfoList::siftUp(qsizetype index)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    QTimerInfo **timers = data();
+    QTimerInfo * const t = timers[index];
+    while (index > 0) {
+        const qsizetype parent = (index - 1) / TimerHeapArity;
+        if (!firesBefore(t, timers[parent]))
             break;
+        timers[index] = timers[parent];
+        timers[index]->heapIndex = index;
+        index = parent;
     }
-    insert(index+1, ti);
+    timers[index] = t;
+    t->heapIndex = index;
+}
+
+void QTimerInfoList::siftDown(qsizetype index)
+{
+    QTimerInfo **timers = data();
+    QTimerInfo * const t = timers[index];
+    const qsizetype count = size();
+    for (;;) {
+        const qsizetype first = index * TimerHeapArity + 1;
+        if (first >= count)
+            break;
+        const qsizetype last = qMin(first + TimerHeapArity, count);
+        qsizetype earliest = first;
+        for (qsizetype child = first + 1; child < last; ++child) {
+            if (firesBefore(timers[child], timers[earliest]))
+                earliest = child;
+        }
+        if (!firesBefore(timers[earliest], t))
+            break;
+        timers[index] = timers[earliest];
+        timers[index]->heapIndex = index;
+        index = earliest;
+    }
+    timers[index] = t;
+    t->heapIndex = index;
+}
+
+/*
+  insert timer info into list
+*/
+void QTimerInfoList::timerInsert(QTimerInfo *ti)
+{
+    ti->sequence = insertionCount++;
+    append(ti);
+    siftUp(size() - 1);
+}
+
+/*
+  remove timer info from list, without deleting it
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *ti)
+{
+    const qsizetype index = ti->heapIndex;
+    QTimerInfo * const last = takeLast();
+    if (last == ti)
+        return;
+    data()[index] = last;
+    if (index > 0 && firesBefore(last, at((index - 1) / TimerHeapArity)))
+        siftUp(index);
+    else
+        siftDown(index);
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -391,14 +487,16 @@ bool QTimerInfoList::timerWait(timespec &tm)
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
 
-    // Find first waiting timer not already active
+    // Find first waiting timer not already active. Only the active timers
+    // need to be looked past, and there are as many as nested activations.
     QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
-    }
+    visitTimerHeap(*this, [&t](QTimerInfo *candidate) {
+        if (candidate->activateRef)
+            return true;
+        if (!t || firesBefore(candidate, t))
+            t = candidate;
+        return false;
+    });
 
     if (!t)
       return false;
@@ -426,16 +524,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -446,6 +541,28 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     return -1;
 }
 
+void QTimerInfoList::linkToObject(QTimerInfo *t)
+{
+    QTimerInfo *&first = timersByObject[t->obj];
+    t->previousOfObject = nullptr;
+    t->nextOfObject = first;
+    if (first)
+        first->previousOfObject = t;
+    first = t;
+}
+
+void QTimerInfoList::unlinkFromObject(QTimerInfo *t)
+{
+    if (t->nextOfObject)
+        t->nextOfObject->previousOfObject = t->previousOfObject;
+    if (t->previousOfObject)
+        t->previousOfObject->nextOfObject = t->nextOfObject;
+    else if (t->nextOfObject)
+        timersByObject[t->obj] = t->nextOfObject;
+    else
+        timersByObject.remove(t->obj);
+}
+
 void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType timerType, QObject *object)
 {
     QTimerInfo *t = new QTimerInfo;
@@ -497,6 +614,8 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
+    linkToObject(t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -511,56 +630,54 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
+
+    unlinkFromObject(t);
+    timerRemove(t);
+    if (t == firstTimerInfo)
+        firstTimerInfo = nullptr;
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
+    QTimerInfo *next = timersByObject.take(object);
+    while (QTimerInfo *t = next) {
+        next = t->nextOfObject;
+        timersById.remove(t->id);
+        timerRemove(t);
+        if (t == firstTimerInfo)
+            firstTimerInfo = nullptr;
+        if (t->activateRef)
+            *(t->activateRef) = nullptr;
+        delete t;
     }
     return true;
 }
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
+    // report the timers in the order they fire
+    QList<const QTimerInfo *> timers;
+    for (const QTimerInfo *t = timersByObject.value(object); t; t = t->nextOfObject)
+        timers.append(t);
+    std::sort(timers.begin(), timers.end(), firesBefore);
+
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    list.reserve(timers.size());
+    for (const QTimerInfo *t : std::as_const(timers)) {
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -582,11 +699,12 @@ int QTimerInfoList::activateTimers()
 
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
+    visitTimerHeap(*this, [&](const QTimerInfo *t) {
+        if (currentTime < t->timeout)
+            return false;
         maxCount++;
-    }
+        return true;
+    });
 
     //fire the timers.
     while (maxCount--) {
@@ -608,7 +726,7 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        timerRemove(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include <QtCore/qhash.h>
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +70,10 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    qsizetype heapIndex; // - position in QTimerInfoList
+    quint64 sequence; // - keeps timers with equal timeouts in insertion order
+    QTimerInfo *previousOfObject; // - timers of obj, in a doubly-linked list
+    QTimerInfo *nextOfObject;
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -77,6 +82,8 @@ struct QTimerInfo {
 #endif
 };
 
+// The list is kept as a 4-ary min-heap ordered by timeout, so constFirst()
+// is the next timer to fire but the rest is not sorted.
 class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
@@ -92,6 +99,16 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    QHash<int, QTimerInfo *> timersById;
+    QHash<QObject *, QTimerInfo *> timersByObject; // first timer of each object
+    quint64 insertionCount;
+
+    void timerRemove(QTimerInfo *);
+    void linkToObject(QTimerInfo *);
+    void unlinkFromObject(QTimerInfo *);
+    void siftUp(qsizetype index);
+    void siftDown(qsizetype index);
+
 public:
     QTimerInfoList();
 
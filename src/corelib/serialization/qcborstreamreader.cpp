@@ -665,6 +665,8 @@ public:
     };
 
     static QCborStreamReader::StringResultCode appendStringChunk(QCborStreamReader &reader, QByteArray *data);
+    static bool skipUnvalidated(QCborStreamReader &reader, int maxRecursion);
+    bool skipInMemoryContainer(int maxRecursion);
     QCborStreamReader::StringResult<qsizetype> readStringChunk(ReadStringChunk params);
     qsizetype readStringChunk_byte(ReadStringChunk params, qsizetype len);
     qsizetype readStringChunk_unicode(ReadStringChunk params, qsizetype utf8len);
@@ -1458,6 +1460,125 @@ QCborStreamReader::StringResultCode qt_cbor_append_string_chunk(QCborStreamReade
     return QCborStreamReaderPrivate::appendStringChunk(reader, data);
 }
 
+// Returns the end of the CBOR item starting at ptr, or nullptr if it is
+// truncated, malformed or nested more deeply than maxRecursion.
+static const uchar *skipRawItem(const uchar *ptr, const uchar *end, int maxRecursion)
+{
+    if (ptr == end || maxRecursion < 0)
+        return nullptr;
+
+    const uchar majorType = *ptr >> MajorTypeShift;
+    const uchar info = *ptr & SmallValueMask;
+    ++ptr;
+
+    quint64 value = info;
+    if (info >= Value8Bit && info <= Value64Bit) {
+        const qsizetype n = qsizetype(1) << (info - Value8Bit);
+        if (end - ptr < n)
+            return nullptr;
+        value = 0;
+        for (qsizetype i = 0; i < n; ++i)
+            value = (value << 8) | *ptr++;
+    } else if (info == IndefiniteLength) {
+        if (majorType < ByteStringType || majorType > MapType)
+            return nullptr;     // a Break or a reserved value
+        while (ptr != end && *ptr != BreakByte) {
+            // string chunks must be definite-length strings of the same type
+            if (majorType <= TextStringType
+                    && (*ptr >> MajorTypeShift != majorType || (*ptr & SmallValueMask) == IndefiniteLength))
+                return nullptr;
+            ptr = skipRawItem(ptr, end, maxRecursion - 1);
+            if (!ptr)
+                return nullptr;
+        }
+        return ptr == end ? nullptr : ptr + 1;
+    } else if (info > Value64Bit) {
+        return nullptr;
+    }
+
+    switch (majorType) {
+    case ByteStringType:
+    case TextStringType:
+        return value > quint64(end - ptr) ? nullptr : ptr + value;
+    case MapType:
+        if (value > std::numeric_limits<quint64>::max() / 2)
+            return nullptr;
+        value *= 2;
+        Q_FALLTHROUGH();
+    case ArrayType:
+        for ( ; value; --value) {
+            ptr = skipRawItem(ptr, end, maxRecursion - 1);
+            if (!ptr)
+                return nullptr;
+        }
+        return ptr;
+    case TagType:
+        return skipRawItem(ptr, end, maxRecursion);
+    }
+    return ptr;                 // integers, simple types and floating point
+}
+
+// Skips the current item like QCborStreamReader::next(), but without decoding
+// the strings, so their contents are not validated
+bool qt_cbor_stream_skip_unvalidated(QCborStreamReader &reader)
+{
+    return QCborStreamReaderPrivate::skipUnvalidated(reader, 10000);
+}
+
+// If the whole document is in memory, jumps over the bytes of the current
+// container instead of iterating over its contents. Malformed containers are
+// left alone so the caller can report the error like next() does.
+inline bool QCborStreamReaderPrivate::skipInMemoryContainer(int maxRecursion)
+{
+    if (device)
+        return false;
+
+    auto begin = reinterpret_cast<const uchar *>(buffer.constData());
+    auto end = reinterpret_cast<const uchar *>(buffer.constEnd());
+    const uchar *next = skipRawItem(begin + bufferStart, end, maxRecursion);
+    if (!next)
+        return false;
+
+    bufferStart = next - begin;
+    if (CborError err = preparse_next_value(&currentElement))
+        handleError(err);
+    return true;
+}
+
+inline bool QCborStreamReaderPrivate::skipUnvalidated(QCborStreamReader &reader, int maxRecursion)
+{
+    if (reader.lastError() != QCborError::NoError)
+        return false;
+
+    if (!reader.hasNext()) {
+        reader.d->handleError(CborErrorAdvancePastEOF);
+    } else if (maxRecursion < 0) {
+        reader.d->handleError(CborErrorNestingTooDeep);
+    } else if (reader.isContainer() && reader.d->skipInMemoryContainer(maxRecursion)) {
+        // done
+    } else if (reader.isContainer()) {
+        reader.enterContainer();
+        while (reader.lastError() == QCborError::NoError && reader.hasNext())
+            skipUnvalidated(reader, maxRecursion - 1);
+        if (reader.lastError() == QCborError::NoError)
+            reader.leaveContainer();
+    } else if (reader.isByteArray() || reader.isString()) {
+        // like next() does for byte arrays
+        char c;
+        QCborStreamReader::StringResult<qsizetype> r;
+        do {
+            r = reader.readStringChunk(&c, 1);
+        } while (r.status == QCborStreamReader::Ok);
+    } else {
+        CborError err = cbor_value_advance_fixed(&reader.d->currentElement);
+        if (err)
+            reader.d->handleError(err);
+    }
+
+    reader.preparse();
+    return reader.lastError() == QCborError::NoError;
+}
+
 inline QCborStreamReader::StringResultCode
 QCborStreamReaderPrivate::appendStringChunk(QCborStreamReader &reader, QByteArray *data)
 {
@@ -45,6 +45,7 @@
 
 #if QT_CONFIG(cborstreamreader)
 #include "qcborstreamreader.h"
+#include "qmutex.h"
 #endif
 
 #if QT_CONFIG(cborstreamwriter)
@@ -937,6 +938,9 @@ QCborContainerPrivate::~QCborContainerPrivate()
         if (e.flags & Element::IsContainer)
             e.container->deref();
     }
+#if QT_CONFIG(cborstreamreader)
+    delete lazySource.loadRelaxed();
+#endif
 }
 
 void QCborContainerPrivate::compact(qsizetype reserved)
@@ -954,7 +958,7 @@ QCborContainerPrivate *QCborContainerPrivate::clone(QCborContainerPrivate *d, qs
     if (!d) {
         d = new QCborContainerPrivate;
     } else {
-        d = new QCborContainerPrivate(*d);
+        d = new QCborContainerPrivate(*loaded(d));
         if (reserved >= 0) {
             d->elements.reserve(reserved);
             d->compact(reserved);
@@ -971,7 +975,7 @@ QCborContainerPrivate *QCborContainerPrivate::detach(QCborContainerPrivate *d, q
 {
     if (!d || d->ref.loadRelaxed() != 1)
         return clone(d, reserved);
-    return d;
+    return loaded(d);
 }
 
 /*!
@@ -1129,8 +1133,9 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
         return cmp;
 
     if ((e1.flags & Element::IsContainer) || (e2.flags & Element::IsContainer))
-        return compareContainer(e1.flags & Element::IsContainer ? e1.container : nullptr,
-                                e2.flags & Element::IsContainer ? e2.container : nullptr);
+        return compareContainer(
+                e1.flags & Element::IsContainer ? QCborContainerPrivate::loaded(e1.container) : nullptr,
+                e2.flags & Element::IsContainer ? QCborContainerPrivate::loaded(e2.container) : nullptr);
 
     // string data?
     const ByteData *b1 = c1 ? c1->byteData(e1) : nullptr;
@@ -1402,7 +1407,8 @@ static void encodeToCbor(QCborStreamWriter &writer, const QCborContainerPrivate
         case QCborValue::Tag:
             // recurse
             return encodeToCbor(writer,
-                                e.flags & Element::IsContainer ? e.container : nullptr,
+                                e.flags & Element::IsContainer
+                                        ? QCborContainerPrivate::loaded(e.container) : nullptr,
                                 -qsizetype(e.type), opt);
 
         case QCborValue::SimpleType:
@@ -1494,7 +1500,9 @@ static Element decodeBasicValueFromCbor(QCborStreamReader &reader)
     return e;
 }
 
-static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static inline QCborContainerPrivate *
+createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                        const QCborContainerPrivate::LazySource *source = nullptr)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
@@ -1525,7 +1533,7 @@ static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &
         return d;
 
     while (reader.hasNext() && reader.lastError() == QCborError::NoError)
-        d->decodeValueFromCbor(reader, remainingRecursionDepth - 1);
+        d->decodeValueFromCbor(reader, remainingRecursionDepth - 1, source);
 
     if (reader.lastError() == QCborError::NoError)
         reader.leaveContainer();
@@ -1533,7 +1541,8 @@ static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &
     return d;
 }
 
-static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                      const QCborContainerPrivate::LazySource *source = nullptr)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
@@ -1546,7 +1555,7 @@ static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRe
 
     if (reader.lastError() == QCborError::NoError) {
         // decode tagged value
-        d->decodeValueFromCbor(reader, remainingRecursionDepth - 1);
+        d->decodeValueFromCbor(reader, remainingRecursionDepth - 1, source);
     }
 
     QCborValue::Type type;
@@ -1570,6 +1579,7 @@ inline void QCborContainerPrivate::setErrorInReader(QCborStreamReader &reader, Q
 }
 
 extern QCborStreamReader::StringResultCode qt_cbor_append_string_chunk(QCborStreamReader &reader, QByteArray *data);
+extern bool qt_cbor_stream_skip_unvalidated(QCborStreamReader &reader);
 
 void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
 {
@@ -1678,7 +1688,8 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
     }
 }
 
-void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                                const LazySource *source)
 {
     QCborStreamReader::Type t = reader.type();
     switch (t) {
@@ -1698,17 +1709,58 @@ void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int r
 
     case QCborStreamReader::Array:
     case QCborStreamReader::Map:
+        if (source && !(reader.isLengthKnown() && reader.length() == 0)) {
+            // record where it is and skip it; it's decoded when it's used
+            auto d = new QCborContainerPrivate;
+            d->ref.storeRelaxed(1);
+            d->lazySource.storeRelaxed(new LazySource{ source->cbor,
+                                                       source->offset + reader.currentOffset(),
+                                                       remainingRecursionDepth });
+            elements.append(QtCbor::Element(d, t == QCborStreamReader::Array ? QCborValue::Array
+                                                                             : QCborValue::Map));
+            qt_cbor_stream_skip_unvalidated(reader);
+            return;
+        }
         return append(makeValue(t == QCborStreamReader::Array ? QCborValue::Array : QCborValue::Map, -1,
                                 createContainerFromCbor(reader, remainingRecursionDepth),
                                 MoveContainer));
 
     case QCborStreamReader::Tag:
-        return append(taggedValueFromCbor(reader, remainingRecursionDepth));
+        return append(taggedValueFromCbor(reader, remainingRecursionDepth, source));
 
     case QCborStreamReader::Invalid:
         return;                 // probably a decode error
     }
 }
+
+Q_CONSTINIT static QBasicMutex lazyDecodingMutex;
+
+void QCborContainerPrivate::decodeFromLazySource()
+{
+    QMutexLocker locker(&lazyDecodingMutex);
+    LazySource *source = lazySource.loadRelaxed();
+    if (!source)
+        return;                 // another thread got here first
+
+    Q_ASSERT(elements.isEmpty());
+    QCborStreamReader reader(QByteArray::fromRawData(source->cbor.constData() + source->offset,
+                                                     source->cbor.size() - source->offset));
+    if (reader.isLengthKnown()) {
+        // same clamping as createContainerFromCbor()
+        quint64 len = qMin(reader.length(), quint64(1024 * 1024 - 1));
+        elements.reserve(qsizetype(len) << (reader.isMap() ? 1 : 0));
+    }
+
+    // containers nested too deeply are left empty, as they would be if the
+    // whole document had been decoded at once
+    if (source->remainingRecursionDepth > 0 && reader.enterContainer()) {
+        while (reader.hasNext() && reader.lastError() == QCborError::NoError)
+            decodeValueFromCbor(reader, source->remainingRecursionDepth - 1, source);
+    }
+
+    lazySource.storeRelease(nullptr);
+    delete source;
+}
 #endif // QT_CONFIG(cborstreamreader)
 
 /*!
@@ -2299,6 +2351,8 @@ template<typename KeyType> QCborValueRef
 QCborContainerPrivate::findOrAddMapKey(QCborValueRef self, KeyType key)
 {
     auto &e = self.d->elements[self.i];
+    if (e.flags & QtCbor::Element::IsContainer)
+        loaded(e.container);
 
     // we need a map, so convert if necessary
     if (e.type == QCborValue::Array) {
@@ -2487,6 +2541,54 @@ QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error)
     return result;
 }
 
+/*!
+    \since 6.4
+
+    Decodes one item from the CBOR stream found in the byte array \a ba, like
+    fromCbor(), but without decoding the arrays and maps nested in it until
+    they are used. Those containers keep a reference to \a ba and are decoded
+    one level at a time, the first time their contents are accessed, so the
+    time and memory spent are proportional to the parts of the document that
+    are actually used. This is useful for large, read-mostly documents such
+    as memory-mapped caches:
+
+    \snippet code/src_corelib_serialization_qcborvalue.cpp 7
+
+    If \a ba was created with QByteArray::fromRawData(), the data it points to
+    must remain valid and unmodified for as long as the returned value or any
+    array or map obtained from it exists. The strings of a container are
+    copied when the container is decoded.
+
+    Errors in the structure of the document are stored in \a error, as with
+    fromCbor(). Errors inside nested containers that are only found while
+    decoding their contents, such as invalid UTF-8 in a string, are not
+    reported; the affected container holds the elements decoded before the
+    error.
+
+    \sa fromCbor(), QFile::map()
+*/
+QCborValue QCborValue::fromRawCbor(const QByteArray &ba, QCborParserError *error)
+{
+    QCborStreamReader reader(ba);
+    const QCborContainerPrivate::LazySource source = { ba, 0, MaximumRecursionDepth };
+    QCborValue result;
+    if (reader.lastError() == QCborError::NoError && (reader.isArray() || reader.isMap())) {
+        result.n = -1;
+        result.t = reader.isArray() ? Array : Map;
+        result.container = createContainerFromCbor(reader, MaximumRecursionDepth, &source);
+    } else if (reader.lastError() == QCborError::NoError && reader.isTag()) {
+        result = taggedValueFromCbor(reader, MaximumRecursionDepth, &source);
+    } else {
+        result = fromCbor(reader);
+    }
+
+    if (error) {
+        error->error = reader.lastError();
+        error->offset = reader.currentOffset();
+    }
+    return result;
+}
+
 /*!
     \fn QCborValue QCborValue::fromCbor(const char *data, qsizetype len, QCborParserError *error)
     \fn QCborValue QCborValue::fromCbor(const quint8 *data, qsizetype len, QCborParserError *error)
@@ -2841,6 +2943,8 @@ QCborValueRef QCborValueRef::operator[](QLatin1StringView key)
 QCborValueRef QCborValueRef::operator[](qint64 key)
 {
     auto &e = d->elements[i];
+    if (e.flags & QtCbor::Element::IsContainer)
+        QCborContainerPrivate::loaded(e.container);
     if (shouldArrayRemainArray(key, e.type, e.container)) {
         e.container = maybeGrow(e.container, key);
         e.flags |= QtCbor::Element::IsContainer;
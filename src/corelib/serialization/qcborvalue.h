@@ -289,6 +289,9 @@ public:
     { return fromCbor(QByteArray(data, int(len)), error); }
     static QCborValue fromCbor(const quint8 *data, qsizetype len, QCborParserError *error = nullptr)
     { return fromCbor(QByteArray(reinterpret_cast<const char *>(data), int(len)), error); }
+    static QCborValue fromRawCbor(const QByteArray &ba, QCborParserError *error = nullptr);
+    static QCborValue fromRawCbor(const char *data, qsizetype len, QCborParserError *error = nullptr)
+    { return fromRawCbor(QByteArray::fromRawData(data, len), error); }
 #endif // QT_CONFIG(cborstreamreader)
 #if QT_CONFIG(cborstreamwriter)
     QByteArray toCbor(EncodingOptions opt = NoTransformation) const;
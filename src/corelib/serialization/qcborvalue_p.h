@@ -138,6 +138,30 @@ public:
     QByteArray data;
     QList<QtCbor::Element> elements;
 
+#if QT_CONFIG(cborstreamreader)
+    // Where to decode this array or map from, for containers nested in a
+    // value returned by QCborValue::fromRawCbor(). Cleared once decoded.
+    struct LazySource {
+        QByteArray cbor;
+        qsizetype offset;
+        int remainingRecursionDepth;
+    };
+    QAtomicPointer<LazySource> lazySource;
+
+    void decodeFromLazySource();
+#endif
+
+    // Returns d, decoding it first if it hasn't been decoded yet. Must be
+    // used before looking at the elements of a nested container.
+    static QCborContainerPrivate *loaded(QCborContainerPrivate *d)
+    {
+#if QT_CONFIG(cborstreamreader)
+        if (d && Q_UNLIKELY(d->lazySource.loadAcquire()))
+            d->decodeFromLazySource();
+#endif
+        return d;
+    }
+
     void deref() { if (!ref.deref()) delete this; }
     void compact(qsizetype reserved);
     static QCborContainerPrivate *clone(QCborContainerPrivate *d, qsizetype reserved = -1);
@@ -193,7 +217,7 @@ public:
         const QtCbor::Element &e = elements.at(idx);
         if (e.type != type || (e.flags & QtCbor::Element::IsContainer) == 0)
             return nullptr;
-        return e.container;
+        return loaded(e.container);
     }
 
     void replaceAt_complex(QtCbor::Element &e, const QCborValue &value, ContainerDisposition disp);
@@ -312,7 +336,7 @@ public:
     {
         QCborValue result(type);
         result.n = n;
-        result.container = d;
+        result.container = loaded(d);
         if (d && disp == CopyContainer)
             d->ref.ref();
         return result;
@@ -476,7 +500,8 @@ public:
     template <typename KeyType> static QCborValueRef findOrAddMapKey(QCborValueRef self, KeyType key);
 
 #if QT_CONFIG(cborstreamreader)
-    void decodeValueFromCbor(QCborStreamReader &reader, int remainingStackDepth);
+    void decodeValueFromCbor(QCborStreamReader &reader, int remainingStackDepth,
+                             const LazySource *source = nullptr);
     void decodeStringFromCbor(QCborStreamReader &reader);
     static inline void setErrorInReader(QCborStreamReader &reader, QCborError error);
 #endif
@@ -302,8 +302,9 @@ QJsonValue qt_convertToJson(QCborContainerPrivate *d, qsizetype idx, ConversionM
     case QCborValue::Url:
     case QCborValue::Uuid:
         // recurse
-        return qt_convertToJson(e.flags & Element::IsContainer ? e.container : nullptr, -e.type,
-                                mode);
+        return qt_convertToJson(e.flags & Element::IsContainer
+                                        ? QCborContainerPrivate::loaded(e.container) : nullptr,
+                                -e.type, mode);
 
     case QCborValue::Null:
     case QCborValue::Undefined:
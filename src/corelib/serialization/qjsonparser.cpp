@@ -47,6 +47,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -60,8 +61,6 @@ static int indent = 0;
 #define DEBUG if (1) ; else qDebug()
 #endif
 
-static const int nestingLimit = 1024;
-
 QT_BEGIN_NAMESPACE
 
 // error strings for the JSON parser
@@ -272,6 +271,92 @@ enum {
     Quote = 0x22
 };
 
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(__AVX2__) && !defined(QT_BOOTSTRAPPED)
+// From qjsonparser_avx2.cpp, used when the baseline doesn't include AVX2
+#  define QT_JSONPARSER_DISPATCH_AVX2
+const char *qt_json_skip_plain_ascii_avx2(const char *json, const char *end) noexcept;
+#endif
+
+// Returns the first character in [json, end) that needs a closer look when
+// scanning a string: a quote, a backslash or a non-ASCII byte.
+static inline const char *skipPlainAscii(const char *json, const char *end)
+{
+    auto isPlain = [](char c) { return c != '"' && c != '\\' && uchar(c) < 0x80; };
+    if (json == end || !isPlain(*json))
+        return json;    // cheap exit for runs of non-ASCII text
+#ifdef QT_JSONPARSER_DISPATCH_AVX2
+    if (end - json >= 32 && qCpuHasFeature(ArchHaswell))
+        return qt_json_skip_plain_ascii_avx2(json, end);
+#endif
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for ( ; end - json >= 16; json += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                             _mm_cmpeq_epi8(data, backslash));
+        // the sign bit of each byte marks the non-ASCII ones
+        const uint mask = _mm_movemask_epi8(_mm_or_si128(special, data));
+        if (mask)
+            return json + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t maxAscii = vdupq_n_u8(0x7f);
+    for ( ; end - json >= 16; json += 16) {
+        const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(json));
+        const uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, quote), vceqq_u8(data, backslash)),
+                                            vcgtq_u8(data, maxAscii));
+        if (vmaxvq_u8(special))
+            break;      // the scalar loop below finds it
+    }
+#endif
+    while (json < end && isPlain(*json))
+        ++json;
+    return json;
+}
+
+// Skips insignificant whitespace. Indented documents have runs of it between
+// all tokens, so look at 16 bytes at a time once past the first one.
+static inline const char *skipWhitespace(const char *json, const char *end)
+{
+    auto isSpace = [](char c) {
+        return c == Space || c == Tab || c == LineFeed || c == Return;
+    };
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+    const __m128i carriageReturn = _mm_set1_epi8(Return);
+    while (end - json >= 16 && isSpace(*json)) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                                     _mm_cmpeq_epi8(data, tab)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed),
+                                                     _mm_cmpeq_epi8(data, carriageReturn)));
+        const uint mask = ~_mm_movemask_epi8(ws) & 0xffff;
+        if (mask)
+            return json + qCountTrailingZeroBits(mask);
+        json += 16;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    while (end - json >= 16 && isSpace(*json)) {
+        const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(json));
+        const uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(data, vdupq_n_u8(Space)),
+                                                vceqq_u8(data, vdupq_n_u8(Tab))),
+                                       vorrq_u8(vceqq_u8(data, vdupq_n_u8(LineFeed)),
+                                                vceqq_u8(data, vdupq_n_u8(Return))));
+        if (vminvq_u8(ws) == 0)
+            break;      // the scalar loop below finds the end
+        json += 16;
+    }
+#endif
+    while (json < end && isSpace(*json))
+        ++json;
+    return json;
+}
+
 void Parser::eatBOM()
 {
     // eat UTF-8 byte order mark
@@ -285,16 +370,7 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
+    json = skipWhitespace(json, end);
     return (json < end);
 }
 
@@ -809,78 +885,6 @@ bool Parser::parseNumber()
 
         unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
  */
-static inline bool addHexDigit(char digit, char32_t *result)
-{
-    *result <<= 4;
-    if (digit >= '0' && digit <= '9')
-        *result |= (digit - '0');
-    else if (digit >= 'a' && digit <= 'f')
-        *result |= (digit - 'a') + 10;
-    else if (digit >= 'A' && digit <= 'F')
-        *result |= (digit - 'A') + 10;
-    else
-        return false;
-    return true;
-}
-
-static inline bool scanEscapeSequence(const char *&json, const char *end, char32_t *ch)
-{
-    ++json;
-    if (json >= end)
-        return false;
-
-    DEBUG << "scan escape" << (char)*json;
-    uchar escaped = *json++;
-    switch (escaped) {
-    case '"':
-        *ch = '"'; break;
-    case '\\':
-        *ch = '\\'; break;
-    case '/':
-        *ch = '/'; break;
-    case 'b':
-        *ch = 0x8; break;
-    case 'f':
-        *ch = 0xc; break;
-    case 'n':
-        *ch = 0xa; break;
-    case 'r':
-        *ch = 0xd; break;
-    case 't':
-        *ch = 0x9; break;
-    case 'u': {
-        *ch = 0;
-        if (json > end - 4)
-            return false;
-        for (int i = 0; i < 4; ++i) {
-            if (!addHexDigit(*json, ch))
-                return false;
-            ++json;
-        }
-        return true;
-    }
-    default:
-        // this is not as strict as one could be, but allows for more Json files
-        // to be parsed correctly.
-        *ch = escaped;
-        return true;
-    }
-    return true;
-}
-
-static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *result)
-{
-    const auto *usrc = reinterpret_cast<const uchar *>(json);
-    const auto *uend = reinterpret_cast<const uchar *>(end);
-    const uchar b = *usrc++;
-    int res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, result, usrc, uend);
-    if (res < 0)
-        return false;
-
-    json = reinterpret_cast<const char *>(usrc);
-    return true;
-}
-
 bool Parser::parseString()
 {
     const char *start = json;
@@ -891,6 +895,9 @@ bool Parser::parseString()
     bool isUtf8 = true;
     bool isAscii = true;
     while (json < end) {
+        json = skipPlainAscii(json, end);
+        if (json >= end)
+            break;
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -933,6 +940,12 @@ bool Parser::parseString()
 
     QString ucs4;
     while (json < end) {
+        if (const char *plain = skipPlainAscii(json, end); plain != json) {
+            ucs4.append(QLatin1StringView(json, plain - json));
+            json = plain;
+            if (json >= end)
+                break;
+        }
         char32_t ch = 0;
         if (*json == '"')
             break;
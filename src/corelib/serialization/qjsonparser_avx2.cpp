@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qalgorithms.h>
+#include <private/qsimd_p.h>
+
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+
+QT_BEGIN_NAMESPACE
+
+// Selected at runtime by qjsonparser.cpp when qCpuHasFeature(ArchHaswell) is
+// true. Returns the first quote, backslash or non-ASCII byte in [json, end),
+// or end. Requires at least 32 bytes: the final, partial block is handled by
+// reloading the last 32 bytes.
+const char *qt_json_skip_plain_ascii_avx2(const char *json, const char *end) noexcept
+{
+    Q_ASSERT(end - json >= 32);
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    auto specialMask = [&](const char *ptr) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote),
+                                                _mm256_cmpeq_epi8(data, backslash));
+        // the sign bit of each byte marks the non-ASCII ones
+        return uint(_mm256_movemask_epi8(_mm256_or_si256(special, data)));
+    };
+
+    for ( ; end - json >= 32; json += 32) {
+        if (uint mask = specialMask(json))
+            return json + qCountTrailingZeroBits(mask);
+    }
+    if (json == end)
+        return end;
+
+    // everything before json is plain, so the first match is at or after it
+    json = end - 32;
+    if (uint mask = specialMask(json))
+        return json + qCountTrailingZeroBits(mask);
+    return end;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_AVX2
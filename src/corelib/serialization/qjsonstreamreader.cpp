@@ -0,0 +1,916 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamreader.h"
+
+#include <private/qjsonparser_p.h>
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+#include <qcoreapplication.h>
+#include <qiodevice.h>
+#include <qjsonarray.h>
+#include <qjsonobject.h>
+#include <qvarlengtharray.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.4
+
+    \brief The QJsonStreamReader class is a simple pull parser for JSON
+    documents.
+
+    QJsonStreamReader reads a JSON document from a QIODevice or from data
+    passed to addData() and reports it as a stream of tokens, without
+    building the QJsonDocument in memory. It is the JSON counterpart of
+    QXmlStreamReader and QCborStreamReader and accepts the same documents as
+    QJsonDocument::fromJson(): the top-level value must be an object or an
+    array.
+
+    Each call to readNext() returns the next token. Object members are
+    reported as a Name token followed by the tokens of the value. The
+    contents of the current token are available from text(), toDouble(),
+    toInteger(), toBool() and value().
+
+    \snippet code/src_corelib_serialization_qjsonstreamreader.cpp 0
+
+    If the reader runs out of data in the middle of the document,
+    readNext() returns Invalid and error() returns
+    PrematureEndOfDocumentError. This is not fatal: once more data is
+    available, either from the device or through addData(), calling
+    readNext() again resumes at the token that was cut short. Syntax errors
+    are reported as NotWellFormedError, with the details in parseError().
+    They are fatal and the reader has to be clear()ed before it can be used
+    again.
+
+    readCurrentValue() can be used to read a single element, such as one
+    record of a large array, into a QJsonValue.
+
+    \sa QJsonDocument, QCborStreamReader, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken      The reader has not read anything yet.
+    \value Invalid      An error occurred, see error().
+    \value StartObject  The beginning of an object.
+    \value EndObject    The end of an object.
+    \value StartArray   The beginning of an array.
+    \value EndArray     The end of an array.
+    \value Name         The name of an object member, see text().
+    \value String       A string value, see text().
+    \value Number       A number, see isInteger(), toInteger() and toDouble().
+    \value Bool         The literal \c true or \c false, see toBool().
+    \value Null         The literal \c null.
+    \value EndDocument  The end of the top-level object or array.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the error the reader encountered.
+
+    \value NoError                      No error occurred.
+    \value PrematureEndOfDocumentError  The input ended before the end of
+                                        the document. Parsing resumes once
+                                        more data is available.
+    \value NotWellFormedError           The input is not valid JSON. See
+                                        parseError() for details.
+*/
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum State : quint8 {
+        ExpectDocument,
+        ExpectValue,
+        ExpectValueOrEndArray,
+        ExpectName,
+        ExpectNameOrEndObject,
+        ExpectNameSeparator,
+        ExpectValueSeparatorOrEnd,
+        DocumentDone,
+        Finished
+    };
+    enum Result { GotToken, NeedData, Failed };
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;
+    qint64 bufferOffset = 0;        // stream offset of buffer[0]
+    qint64 tokenOffset = 0;
+
+    // '[' or '{' for each open container
+    QVarLengthArray<char, 32> containers;
+    State state = ExpectDocument;
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QJsonParseError::ParseError parseError = QJsonParseError::NoError;
+
+    // how much of an incomplete string has been scanned, so that it isn't
+    // scanned again from the start each time more data arrives
+    qsizetype stringScanned = 0;
+    bool stringHasEscapes = false;
+
+    QString text;
+    double number = 0;
+    qint64 integer = 0;
+    bool isInteger = false;
+    bool boolean = false;
+
+    void reset()
+    {
+        buffer.clear();
+        pos = 0;
+        bufferOffset = tokenOffset = 0;
+        containers.clear();
+        state = ExpectDocument;
+        type = QJsonStreamReader::NoToken;
+        error = QJsonStreamReader::NoError;
+        parseError = QJsonParseError::NoError;
+        stringScanned = 0;
+        stringHasEscapes = false;
+        text.clear();
+    }
+
+    void compact()
+    {
+        if (pos == 0)
+            return;
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        pos = 0;
+    }
+
+    bool fillBuffer();
+    bool skipSpace();
+    Result parseNext();
+    Result fail(QJsonParseError::ParseError e)
+    {
+        parseError = e;
+        return Failed;
+    }
+
+    Result startContainer(char c);
+    Result endContainer();
+    Result parseString(QJsonStreamReader::TokenType tokenType);
+    Result parseLiteral(const char *literal, qsizetype len);
+    Result parseNumber();
+    Result parseValue();
+    void valueDone()
+    {
+        state = ExpectValueSeparatorOrEnd;
+    }
+};
+
+bool QJsonStreamReaderPrivate::fillBuffer()
+{
+    if (!device)
+        return false;
+
+    compact();
+    // bytesAvailable() of a file is the rest of it, so never read more than
+    // a chunk at a time
+    constexpr qint64 ChunkSize = 64 * 1024;
+    const qint64 available = device->bytesAvailable();
+    const qint64 toRead = available > 0 ? qMin(available, ChunkSize) : ChunkSize;
+    const qsizetype oldSize = buffer.size();
+    buffer.resize(oldSize + toRead);
+    const qint64 n = device->read(buffer.data() + oldSize, toRead);
+    buffer.resize(oldSize + qMax(n, qint64(0)));
+    return n > 0;
+}
+
+// skips JSON whitespace and returns true if there's a character left to look at
+bool QJsonStreamReaderPrivate::skipSpace()
+{
+    const char *ptr = buffer.constData() + pos;
+    const char *end = buffer.constData() + buffer.size();
+    while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\n' || *ptr == '\r'))
+        ++ptr;
+    pos = ptr - buffer.constData();
+    return ptr < end;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::startContainer(char c)
+{
+    if (containers.size() >= QJsonPrivate::nestingLimit)
+        return fail(QJsonParseError::DeepNesting);
+    ++pos;
+    containers.append(c);
+    if (c == '[') {
+        type = QJsonStreamReader::StartArray;
+        state = ExpectValueOrEndArray;
+    } else {
+        type = QJsonStreamReader::StartObject;
+        state = ExpectNameOrEndObject;
+    }
+    return GotToken;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::endContainer()
+{
+    ++pos;
+    type = containers.last() == '[' ? QJsonStreamReader::EndArray : QJsonStreamReader::EndObject;
+    containers.removeLast();
+    state = containers.isEmpty() ? DocumentDone : ExpectValueSeparatorOrEnd;
+    return GotToken;
+}
+
+QJsonStreamReaderPrivate::Result
+QJsonStreamReaderPrivate::parseString(QJsonStreamReader::TokenType tokenType)
+{
+    const char *begin = buffer.constData() + pos + 1;
+    const char *end = buffer.constData() + buffer.size();
+
+    // find the closing quote before decoding anything, so an incomplete
+    // string can be retried once more data has arrived, continuing where
+    // the previous attempt stopped
+    bool hasEscapes = stringHasEscapes;
+    const char *ptr = begin + stringScanned;
+    while (ptr < end && *ptr != '"') {
+        if (*ptr == '\\') {
+            if (end - ptr < 2)
+                break;      // resume at the escape
+            hasEscapes = true;
+            ++ptr;
+        }
+        ++ptr;
+    }
+    if (ptr == end || *ptr != '"') {
+        stringScanned = ptr - begin;
+        stringHasEscapes = hasEscapes;
+        return NeedData;
+    }
+    stringScanned = 0;
+    stringHasEscapes = false;
+
+    if (!hasEscapes) {
+        const QByteArrayView utf8(begin, ptr - begin);
+        const auto validity = QUtf8::isValidUtf8(utf8);
+        if (!validity.isValidUtf8)
+            return fail(QJsonParseError::IllegalUTF8String);
+        text = validity.isValidAscii ? QString::fromLatin1(utf8) : QString::fromUtf8(utf8);
+    } else {
+        text.clear();
+        text.reserve(ptr - begin);
+        const char *json = begin;
+        while (json < ptr) {
+            char32_t ch = 0;
+            if (*json == '\\') {
+                if (!QJsonPrivate::scanEscapeSequence(json, ptr, &ch))
+                    return fail(QJsonParseError::IllegalEscapeSequence);
+            } else if (!QJsonPrivate::scanUtf8Char(json, ptr, &ch)) {
+                return fail(QJsonParseError::IllegalUTF8String);
+            }
+            text.append(QChar::fromUcs4(ch));
+        }
+    }
+
+    pos = ptr + 1 - buffer.constData();
+    type = tokenType;
+    return GotToken;
+}
+
+QJsonStreamReaderPrivate::Result
+QJsonStreamReaderPrivate::parseLiteral(const char *literal, qsizetype len)
+{
+    const qsizetype available = qMin(len, buffer.size() - pos);
+    if (memcmp(buffer.constData() + pos, literal, available) != 0)
+        return fail(QJsonParseError::IllegalValue);
+    if (available < len)
+        return NeedData;
+    pos += len;
+    return GotToken;
+}
+
+/*
+    Same grammar and conversion as QJsonPrivate::Parser::parseNumber(). A
+    number can't end the document, so running out of data while scanning one
+    means we need more.
+*/
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseNumber()
+{
+    const char *start = buffer.constData() + pos;
+    const char *end = buffer.constData() + buffer.size();
+    const char *json = start;
+    bool isInt = true;
+
+    auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+
+    // minus
+    if (json < end && *json == '-')
+        ++json;
+
+    // int = zero / ( digit1-9 *DIGIT )
+    if (json < end && *json == '0') {
+        ++json;
+    } else {
+        while (json < end && isDigit(*json))
+            ++json;
+    }
+
+    // frac = decimal-point 1*DIGIT
+    if (json < end && *json == '.') {
+        ++json;
+        while (json < end && isDigit(*json)) {
+            isInt = isInt && *json == '0';
+            ++json;
+        }
+    }
+
+    // exp = e [ minus / plus ] 1*DIGIT
+    if (json < end && (*json == 'e' || *json == 'E')) {
+        isInt = false;
+        ++json;
+        if (json < end && (*json == '-' || *json == '+'))
+            ++json;
+        while (json < end && isDigit(*json))
+            ++json;
+    }
+
+    if (json >= end)
+        return NeedData;
+
+    const QByteArray numberText = QByteArray::fromRawData(start, json - start);
+    bool ok = false;
+    if (isInt) {
+        integer = numberText.toLongLong(&ok);
+        if (ok) {
+            number = double(integer);
+            isInteger = true;
+        }
+    }
+    if (!ok) {
+        number = numberText.toDouble(&ok);
+        if (!ok)
+            return fail(QJsonParseError::IllegalNumber);
+        isInteger = convertDoubleTo(number, &integer);
+    }
+
+    pos += json - start;
+    type = QJsonStreamReader::Number;
+    return GotToken;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseValue()
+{
+    Result r;
+    switch (buffer.at(pos)) {
+    case '[':
+    case '{':
+        return startContainer(buffer.at(pos));
+    case '"':
+        r = parseString(QJsonStreamReader::String);
+        break;
+    case 't':
+        r = parseLiteral("true", 4);
+        type = QJsonStreamReader::Bool;
+        boolean = true;
+        break;
+    case 'f':
+        r = parseLiteral("false", 5);
+        type = QJsonStreamReader::Bool;
+        boolean = false;
+        break;
+    case 'n':
+        r = parseLiteral("null", 4);
+        type = QJsonStreamReader::Null;
+        break;
+    case ',':
+        // Essentially missing value, but after a colon, not after a comma
+        // like the other MissingObject errors.
+        return fail(QJsonParseError::IllegalValue);
+    case ']':
+    case '}':
+        return fail(QJsonParseError::MissingObject);
+    default:
+        r = parseNumber();
+        break;
+    }
+    if (r == GotToken)
+        valueDone();
+    return r;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseNext()
+{
+    for (;;) {
+        if (!skipSpace())
+            return NeedData;
+
+        const char c = buffer.at(pos);
+        tokenOffset = bufferOffset + pos;
+        switch (state) {
+        case ExpectDocument:
+            if (tokenOffset == 0 && c == '\xef') {
+                // UTF-8 byte order mark
+                if (buffer.size() - pos < 3)
+                    return NeedData;
+                if (buffer.at(pos + 1) == '\xbb' && buffer.at(pos + 2) == '\xbf') {
+                    pos += 3;
+                    continue;
+                }
+            }
+            if (c != '[' && c != '{')
+                return fail(QJsonParseError::IllegalValue);
+            return startContainer(c);
+
+        case ExpectValueOrEndArray:
+            if (c == ']')
+                return endContainer();
+            Q_FALLTHROUGH();
+        case ExpectValue:
+            return parseValue();
+
+        case ExpectNameOrEndObject:
+            if (c == '}')
+                return endContainer();
+            Q_FALLTHROUGH();
+        case ExpectName:
+            if (c == '"') {
+                Result r = parseString(QJsonStreamReader::Name);
+                if (r == GotToken)
+                    state = ExpectNameSeparator;
+                return r;
+            }
+            return fail(c == '}' ? QJsonParseError::MissingObject
+                                 : QJsonParseError::UnterminatedObject);
+
+        case ExpectNameSeparator:
+            if (c != ':')
+                return fail(QJsonParseError::MissingNameSeparator);
+            ++pos;
+            state = ExpectValue;
+            continue;
+
+        case ExpectValueSeparatorOrEnd: {
+            const bool inArray = containers.last() == '[';
+            if (c == ',') {
+                ++pos;
+                state = inArray ? ExpectValue : ExpectName;
+                continue;
+            }
+            if (c == (inArray ? ']' : '}'))
+                return endContainer();
+            return fail(inArray ? QJsonParseError::MissingValueSeparator
+                                : QJsonParseError::UnterminatedObject);
+        }
+
+        case DocumentDone:
+            return fail(QJsonParseError::GarbageAtEnd);
+
+        case Finished:
+            Q_UNREACHABLE();
+        }
+    }
+}
+
+/*!
+    Constructs a QJsonStreamReader object with no data to read. Use
+    setDevice() or addData() to supply the document.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a QJsonStreamReader object that reads the JSON document in \a
+    data. This is the same as constructing an empty reader and calling
+    addData().
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    d->buffer = data;
+}
+
+/*!
+    Constructs a QJsonStreamReader object that reads the JSON document from
+    \a device. The device must be open for reading.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    d->device = device;
+}
+
+/*!
+    Destroys the reader. The device, if any, is not closed.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the device to read from to \a device and restarts parsing from the
+    current position of the device. Any data added with addData() is
+    discarded.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->reset();
+    d->device = device;
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr if it only reads
+    data added with addData().
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Appends \a data to the data being parsed. This can be used to feed the
+    reader with data as it arrives, for example from a network socket. If
+    readNext() had stopped with PrematureEndOfDocumentError, the next call
+    resumes where it left off.
+
+    Calling this function on a reader that reads from a device is not
+    supported.
+
+    \sa readNext(), error()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+    \overload
+
+    Appends \a len bytes starting at \a data to the data being parsed.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->compact();
+    d->buffer.append(data, len);
+}
+
+/*!
+    Removes the device or data from the reader and resets it to its initial
+    state.
+
+    \sa setDevice(), addData()
+*/
+void QJsonStreamReader::clear()
+{
+    d->reset();
+    d->device = nullptr;
+}
+
+/*!
+    Returns \c true if the reader has read the whole document or stopped
+    because of an error, \c false otherwise.
+
+    If error() is PrematureEndOfDocumentError, reading can be resumed by
+    calling readNext() once more data is available.
+
+    \sa readNext(), error()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    return d->type == EndDocument || d->error != NoError;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    Returns Invalid if an error occurred. If the error is
+    PrematureEndOfDocumentError, the call can be repeated once more data is
+    available. Once the whole document has been read, this function returns
+    EndDocument. Trailing data other than whitespace is reported as
+    QJsonParseError::GarbageAtEnd.
+
+    \sa tokenType(), atEnd()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    if (d->error == NotWellFormedError)
+        return Invalid;
+    if (d->state == QJsonStreamReaderPrivate::Finished)
+        return EndDocument;
+
+    d->error = NoError;
+    for (;;) {
+        QJsonStreamReaderPrivate::Result r;
+        if (d->state == QJsonStreamReaderPrivate::DocumentDone) {
+            // report the end of the document, but look at what follows
+            // first so garbage at the end is not silently ignored
+            r = d->skipSpace() ? d->parseNext() : QJsonStreamReaderPrivate::NeedData;
+            if (r == QJsonStreamReaderPrivate::NeedData && d->fillBuffer())
+                continue;
+            if (r == QJsonStreamReaderPrivate::NeedData) {
+                d->state = QJsonStreamReaderPrivate::Finished;
+                d->type = EndDocument;
+                return EndDocument;
+            }
+        } else {
+            r = d->parseNext();
+            if (r == QJsonStreamReaderPrivate::NeedData && d->fillBuffer())
+                continue;
+        }
+
+        switch (r) {
+        case QJsonStreamReaderPrivate::GotToken:
+            return d->type;
+        case QJsonStreamReaderPrivate::NeedData:
+            d->error = PrematureEndOfDocumentError;
+            break;
+        case QJsonStreamReaderPrivate::Failed:
+            d->error = NotWellFormedError;
+            d->tokenOffset = d->bufferOffset + d->pos;
+            break;
+        }
+        d->type = Invalid;
+        return Invalid;
+    }
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa readNext()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->type;
+}
+
+/*!
+    Returns the number of objects and arrays that enclose the current token.
+    For StartObject and StartArray, that includes the container that just
+    started; for EndObject and EndArray, it no longer includes the one that
+    just ended.
+*/
+int QJsonStreamReader::depth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns the offset in bytes from the beginning of the document of the
+    current token, or of the error if hasError() is \c true.
+*/
+qint64 QJsonStreamReader::offset() const
+{
+    return d->tokenOffset;
+}
+
+/*!
+    Returns the member name if the current token is Name, or the string if
+    it is String. Returns an empty string otherwise.
+*/
+QString QJsonStreamReader::text() const
+{
+    if (d->type == Name || d->type == String)
+        return d->text;
+    return QString();
+}
+
+/*!
+    Returns \c true if the current token is a Number that can be represented
+    exactly as a 64-bit integer, in the same way as QJsonValue.
+
+    \sa toInteger(), toDouble()
+*/
+bool QJsonStreamReader::isInteger() const
+{
+    return d->type == Number && d->isInteger;
+}
+
+/*!
+    Returns the current Number token as a 64-bit integer, or 0 if it is not
+    an integer.
+
+    \sa isInteger(), toDouble()
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    return isInteger() ? d->integer : 0;
+}
+
+/*!
+    Returns the current Number token as a double, or 0 if the current token
+    is not a number.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    return d->type == Number ? d->number : 0;
+}
+
+/*!
+    Returns the value of the current Bool token, or \c false if the current
+    token is not a Bool.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return d->type == Bool && d->boolean;
+}
+
+/*!
+    Returns the current String, Number, Bool or Null token as a QJsonValue.
+    For all other tokens, returns an undefined QJsonValue.
+
+    \sa readCurrentValue()
+*/
+QJsonValue QJsonStreamReader::value() const
+{
+    switch (d->type) {
+    case String:
+        return d->text;
+    case Number:
+        return d->isInteger ? QJsonValue(d->integer) : QJsonValue(d->number);
+    case Bool:
+        return d->boolean;
+    case Null:
+        return QJsonValue::Null;
+    default:
+        return QJsonValue::Undefined;
+    }
+}
+
+/*!
+    Reads the value that starts at the current token into a QJsonValue. If
+    the current token is StartObject or StartArray, this reads up to and
+    including the matching EndObject or EndArray token. For scalar values,
+    this is the same as value().
+
+    This is useful to process one element of a large document at a time.
+    On error, this function returns an undefined QJsonValue and the reader
+    is left at the token where the error occurred. In particular, after a
+    PrematureEndOfDocumentError the part of the value that was already read
+    is lost.
+
+    \sa skipCurrentValue()
+*/
+QJsonValue QJsonStreamReader::readCurrentValue()
+{
+    switch (d->type) {
+    case StartObject: {
+        QJsonObject object;
+        while (readNext() == Name) {
+            const QString name = d->text;
+            readNext();
+            QJsonValue v = readCurrentValue();
+            if (hasError())
+                return QJsonValue::Undefined;
+            object.insert(name, v);
+        }
+        if (d->type != EndObject)
+            return QJsonValue::Undefined;
+        return object;
+    }
+    case StartArray: {
+        QJsonArray array;
+        while (readNext() != EndArray) {
+            QJsonValue v = readCurrentValue();
+            if (hasError())
+                return QJsonValue::Undefined;
+            array.append(v);
+        }
+        return array;
+    }
+    default:
+        return value();
+    }
+}
+
+/*!
+    Skips the value that starts at the current token. If the current token
+    is StartObject or StartArray, this reads up to and including the
+    matching EndObject or EndArray token. Returns \c false if an error
+    occurred before the end of the value was reached.
+
+    \sa readCurrentValue()
+*/
+bool QJsonStreamReader::skipCurrentValue()
+{
+    if (d->type != StartObject && d->type != StartArray)
+        return !hasError();
+
+    const qsizetype targetDepth = d->containers.size() - 1;
+    for (;;) {
+        switch (readNext()) {
+        case EndObject:
+        case EndArray:
+            if (d->containers.size() == targetDepth)
+                return true;
+            break;
+        case Invalid:
+            return false;
+        default:
+            break;
+        }
+    }
+}
+
+/*!
+    Returns the type of the current error, or NoError if no error occurred.
+
+    \sa parseError(), errorString(), hasError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    return d->error;
+}
+
+/*!
+    Returns the details of the syntax error if error() is
+    NotWellFormedError, QJsonParseError::NoError otherwise.
+*/
+QJsonParseError::ParseError QJsonStreamReader::parseError() const
+{
+    return d->error == NotWellFormedError ? d->parseError : QJsonParseError::NoError;
+}
+
+/*!
+    Returns a human-readable description of the current error.
+
+    \sa error()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    switch (d->error) {
+    case NoError:
+        break;
+    case PrematureEndOfDocumentError:
+        return QCoreApplication::translate("QJsonStreamReader", "premature end of document");
+    case NotWellFormedError: {
+        // QJsonParseError only has room for an int offset; offset() has all of it
+        const int offset = int(qMin<qint64>(d->tokenOffset, std::numeric_limits<int>::max()));
+        return QJsonParseError{ offset, d->parseError }.errorString();
+    }
+    }
+    return QJsonParseError{ 0, QJsonParseError::NoError }.errorString();
+}
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if an error occurred, \c false otherwise.
+
+    \sa error()
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
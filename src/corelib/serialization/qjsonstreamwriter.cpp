@@ -0,0 +1,498 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamwriter.h"
+
+#include <private/qjsonwriter_p.h>
+#include <private/qnumeric_p.h>
+#include <qcborvalue.h>
+#include <qiodevice.h>
+#include <qjsonarray.h>
+#include <qjsonobject.h>
+#include <qjsonvalue.h>
+#include <qlocale.h>
+#include <qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.4
+
+    \brief The QJsonStreamWriter class is a simple JSON encoder operating on
+    a one-way stream.
+
+    QJsonStreamWriter writes a JSON document to a QIODevice or a QByteArray
+    as it is being produced, without building a QJsonDocument first. Like
+    QCborStreamWriter, it is told about the start and end of each array and
+    object, and the values in between are written with append(). Inside an
+    object, the appended values alternate between member names, which must
+    be strings, and member values.
+
+    \snippet code/src_corelib_serialization_qjsonstreamwriter.cpp 0
+
+    The output is either QJsonDocument::Indented or QJsonDocument::Compact
+    and is identical to what QJsonDocument::toJson() produces for the same
+    document. If more than one top-level value is written in the compact
+    format, they are separated by newlines.
+
+    When writing to a device, the writer keeps a small buffer and writes it
+    to the device when it fills up, when the top-level value is complete,
+    when flush() is called and when the writer is destroyed. Memory use
+    therefore does not depend on the size of the document.
+
+    Structural errors are not written to the output: endArray() and
+    endObject() return \c false if the current container does not match,
+    and appending anything but a string where a member name is expected
+    prints a warning and is ignored.
+
+    \sa QJsonStreamReader, QJsonDocument::toJson(), QCborStreamWriter
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    static constexpr qsizetype BufferSize = 16 * 1024;
+
+    struct Level {
+        bool isObject;
+        bool hasElements = false;
+        bool expectingValue = false;    // a member name has been written
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Level, 32> levels;
+    QJsonDocument::JsonFormat format;
+    bool documentWritten = false;
+    bool error = false;
+
+    QJsonStreamWriterPrivate(QJsonDocument::JsonFormat format)
+        : format(format)
+    {
+    }
+
+    QByteArray &output()
+    {
+        return data ? *data : buffer;
+    }
+
+    void flush()
+    {
+        if (!device || buffer.isEmpty())
+            return;
+        if (device->write(buffer) != buffer.size())
+            error = true;
+        buffer.clear();
+    }
+
+    void writeIndent(qsizetype depth)
+    {
+        QByteArray &out = output();
+        out += '\n';
+        out.append(4 * depth, ' ');
+    }
+
+    void beginElement();
+    bool beginValue();
+    void endValue();
+    void writeString(QStringView str);
+};
+
+// Writes the separator and the indentation in front of an array element or
+// an object member.
+void QJsonStreamWriterPrivate::beginElement()
+{
+    Level &level = levels.last();
+    QByteArray &out = output();
+    if (level.hasElements)
+        out += ',';
+    if (format == QJsonDocument::Indented)
+        writeIndent(levels.size());
+    level.hasElements = true;
+}
+
+bool QJsonStreamWriterPrivate::beginValue()
+{
+    if (levels.isEmpty()) {
+        if (documentWritten && format == QJsonDocument::Compact)
+            output() += '\n';
+        return true;
+    }
+
+    Level &level = levels.last();
+    if (!level.isObject) {
+        beginElement();
+        return true;
+    }
+    if (!level.expectingValue) {
+        qWarning("QJsonStreamWriter: object member names must be strings");
+        return false;
+    }
+    level.expectingValue = false;
+    return true;
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (!levels.isEmpty()) {
+        if (buffer.size() >= BufferSize)
+            flush();
+        return;
+    }
+
+    // end of the top-level value
+    if (format == QJsonDocument::Indented)
+        output() += '\n';
+    documentWritten = true;
+    flush();
+}
+
+void QJsonStreamWriterPrivate::writeString(QStringView str)
+{
+    QByteArray &out = output();
+    out += '"';
+    out += QJsonPrivate::Writer::escapedString(str);
+    out += '"';
+}
+
+/*!
+    Constructs a QJsonStreamWriter that writes to \a device in the given \a
+    format. The device must be open for writing. The writer does not take
+    ownership of the device.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device, QJsonDocument::JsonFormat format)
+    : d(new QJsonStreamWriterPrivate(format))
+{
+    d->device = device;
+}
+
+/*!
+    Constructs a QJsonStreamWriter that appends to \a data in the given \a
+    format. The data is appended directly, without intermediate buffering.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data, QJsonDocument::JsonFormat format)
+    : d(new QJsonStreamWriterPrivate(format))
+{
+    d->data = data;
+}
+
+/*!
+    Destroys the writer, writing any buffered data to the device. Containers
+    that are still open are not closed.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Makes the writer write to \a device from now on. Buffered data is written
+    to the previous device first. The structure of the document being
+    written is not reset.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if it writes to a
+    QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the output format to \a format. Changing the format while a
+    document is being written produces valid but inconsistently formatted
+    JSON.
+
+    \sa format()
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->format = format;
+}
+
+/*!
+    Returns the output format.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->format;
+}
+
+/*!
+    \overload
+
+    Appends the integer \a i.
+*/
+void QJsonStreamWriter::append(qint64 i)
+{
+    if (!d->beginValue())
+        return;
+    d->output() += QByteArray::number(i);
+    d->endValue();
+}
+
+/*!
+    \overload
+
+    Appends the number \a d. Infinities and NaN can't be represented in JSON
+    and are written as \c null, like QJsonDocument::toJson() does.
+*/
+void QJsonStreamWriter::append(double d)
+{
+    if (!this->d->beginValue())
+        return;
+    if (qIsFinite(d))
+        this->d->output() += QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
+    else
+        this->d->output() += "null";
+    this->d->endValue();
+}
+
+/*!
+    \overload
+
+    Appends the literal \c true or \c false, depending on \a b.
+*/
+void QJsonStreamWriter::append(bool b)
+{
+    if (!d->beginValue())
+        return;
+    d->output() += b ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(std::nullptr_t)
+    \overload
+
+    Appends the literal \c null.
+*/
+
+/*!
+    Appends the literal \c null.
+*/
+void QJsonStreamWriter::appendNull()
+{
+    if (!d->beginValue())
+        return;
+    d->output() += "null";
+    d->endValue();
+}
+
+/*!
+    Appends the string \a str. Inside an object, this writes the name of the
+    next member if a value was written last, and the value of the current
+    member otherwise.
+*/
+void QJsonStreamWriter::append(QStringView str)
+{
+    if (!d->levels.isEmpty()) {
+        QJsonStreamWriterPrivate::Level &level = d->levels.last();
+        if (level.isObject && !level.expectingValue) {
+            d->beginElement();
+            d->writeString(str);
+            d->output() += d->format == QJsonDocument::Compact ? ":" : ": ";
+            level.expectingValue = true;
+            return;
+        }
+    }
+
+    if (!d->beginValue())
+        return;
+    d->writeString(str);
+    d->endValue();
+}
+
+/*!
+    \overload
+*/
+void QJsonStreamWriter::append(QLatin1StringView str)
+{
+    append(QStringView(QString(str)));
+}
+
+/*!
+    \overload
+
+    Appends \a value, including all the elements of arrays and objects.
+    Undefined values are written as \c null.
+*/
+void QJsonStreamWriter::append(const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        appendNull();
+        break;
+    case QJsonValue::Bool:
+        append(value.toBool());
+        break;
+    case QJsonValue::Double:
+        // QJsonValue keeps integers apart from doubles, and so does toJson()
+        if (const QCborValue v = QCborValue::fromJsonValue(value); v.isInteger())
+            append(v.toInteger());
+        else
+            append(v.toDouble());
+        break;
+    case QJsonValue::String:
+        append(QStringView(value.toString()));
+        break;
+    case QJsonValue::Array: {
+        startArray();
+        const QJsonArray array = value.toArray();
+        for (const QJsonValue &v : array)
+            append(v);
+        endArray();
+        break;
+    }
+    case QJsonValue::Object: {
+        startObject();
+        const QJsonObject object = value.toObject();
+        for (auto it = object.constBegin(), end = object.constEnd(); it != end; ++it) {
+            append(QStringView(it.key()));
+            append(it.value());
+        }
+        endObject();
+        break;
+    }
+    }
+}
+
+/*!
+    Starts an array. The elements are written with append() and the array is
+    closed with endArray().
+
+    \sa endArray(), startObject()
+*/
+void QJsonStreamWriter::startArray()
+{
+    if (!d->beginValue())
+        return;
+    d->output() += '[';
+    d->levels.append({ false });
+}
+
+/*!
+    Ends the current array. Returns \c false and writes nothing if the
+    current container is not an array.
+
+    \sa startArray()
+*/
+bool QJsonStreamWriter::endArray()
+{
+    if (d->levels.isEmpty() || d->levels.last().isObject)
+        return false;
+    d->levels.removeLast();
+    if (d->format == QJsonDocument::Indented)
+        d->writeIndent(d->levels.size());
+    d->output() += ']';
+    d->endValue();
+    return true;
+}
+
+/*!
+    Starts an object. The members are written by alternately appending the
+    name and the value of each member, and the object is closed with
+    endObject().
+
+    \sa endObject(), startArray()
+*/
+void QJsonStreamWriter::startObject()
+{
+    if (!d->beginValue())
+        return;
+    d->output() += '{';
+    d->levels.append({ true });
+}
+
+/*!
+    Ends the current object. Returns \c false and writes nothing if the
+    current container is not an object or if the value of the last member
+    is missing.
+
+    \sa startObject()
+*/
+bool QJsonStreamWriter::endObject()
+{
+    if (d->levels.isEmpty() || !d->levels.last().isObject || d->levels.last().expectingValue)
+        return false;
+    d->levels.removeLast();
+    if (d->format == QJsonDocument::Indented)
+        d->writeIndent(d->levels.size());
+    d->output() += '}';
+    d->endValue();
+    return true;
+}
+
+/*!
+    Writes any buffered data to the device.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+/*!
+    Returns \c true if writing to the device failed.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d->error;
+}
+
+QT_END_NAMESPACE
@@ -58,15 +58,15 @@ static inline uchar hexdig(uint u)
     return (u < 0xa ? '0' + u : 'a' + u - 0xa);
 }
 
-static QByteArray escapedString(const QString &s)
+QByteArray Writer::escapedString(QStringView s)
 {
     // give it a minimum size to ensure the resize() below always adds enough space
-    QByteArray ba(qMax(s.length(), 16), Qt::Uninitialized);
+    QByteArray ba(qMax(s.size(), qsizetype(16)), Qt::Uninitialized);
 
     uchar *cursor = reinterpret_cast<uchar *>(const_cast<char *>(ba.constData()));
     const uchar *ba_end = cursor + ba.length();
-    const char16_t *src = reinterpret_cast<const char16_t *>(s.constBegin());
-    const char16_t *const end = reinterpret_cast<const char16_t *>(s.constEnd());
+    const char16_t *src = s.utf16();
+    const char16_t *const end = src + s.size();
 
     while (src != end) {
         if (cursor >= ba_end - 6) {
@@ -151,7 +151,7 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
     }
     case QCborValue::String:
         json += '"';
-        json += escapedString(v.toString());
+        json += Writer::escapedString(v.toString());
         json += '"';
         break;
     case QCborValue::Array:
@@ -209,7 +209,7 @@ static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json
         QCborValue e = o->valueAt(i);
         json += indentString;
         json += '"';
-        json += escapedString(o->valueAt(i).toString());
+        json += Writer::escapedString(o->valueAt(i).toString());
         json += compact ? "\":" : "\": ";
         valueToJson(o->valueAt(i + 1), json, indent, compact);
 
@@ -3561,6 +3561,11 @@ QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
     if (width < 0)
         width = 0;
 
+    // Without any of the flags that need locale data, the C locale formats
+    // exactly as QString::number() does, so skip the intermediate strings
+    if (this == c() && (flags & ~CapitalEorX) == ZeroPadExponent)
+        return qdtoBasicLatin(d, form, precision, flags & CapitalEorX);
+
     int decpt;
     int bufSize = 1;
     if (precision == QLocale::FloatingPointShortest)
@@ -3901,10 +3906,22 @@ bool QLocaleData::numberToCLocale(QStringView s, QLocale::NumberOptions number_o
     int start_of_digits_idx = -1;
     int exponent_idx = -1;
 
+    // All of the C locale's numeric symbols are single ASCII characters, so
+    // they can be recognized without looking each of them up
+    const bool isC = this == c();
+    auto cLocaleNumericToAscii = [](char16_t ch) -> char {
+        if ((ch >= '0' && ch <= '9') || ch == '+' || ch == '-' || ch == '.' || ch == ',')
+            return char(ch);
+        if (ch == 'e' || ch == 'E')
+            return 'e';
+        return 0;
+    };
+
     while (idx < length) {
         const QStringView in = QStringView(uc + idx, uc[idx].isHighSurrogate() ? 2 : 1);
 
-        char out = numericToCLocale(in);
+        char out = isC && uc[idx].unicode() < 0x80 ? cLocaleNumericToAscii(uc[idx].unicode())
+                                                   : numericToCLocale(in);
         if (out == 0) {
             const QChar simple = in.size() == 1 ? in.front() : QChar::Null;
             if (in == listSeparator())
@@ -56,6 +56,11 @@
 #include <limits>
 #include <charconv>
 
+#if defined(__cpp_lib_to_chars) && !defined(QT_BOOTSTRAPPED)
+// std::to_chars() and std::from_chars() for floating point
+#  define QT_USE_FLOATING_POINT_CHARCONV
+#endif
+
 #if defined(Q_OS_LINUX) && !defined(__UCLIBC__)
 #    include <fenv.h>
 #endif
@@ -116,6 +121,31 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#ifdef QT_USE_FLOATING_POINT_CHARCONV
+    if (precision == QLocale::FloatingPointShortest) {
+        // std::to_chars() produces the same shortest round-tripping digits as
+        // double-conversion's SHORTEST mode, only faster. The other modes
+        // round ties differently, so they stay with double-conversion.
+        char target[32];    // "-d.dddddddddddddddde-XXX"
+        const auto result = std::to_chars(target, target + sizeof(target), d,
+                                          std::chars_format::scientific);
+        Q_ASSERT(result.ec == std::errc());
+        const char *p = target;
+        sign = *p == '-';
+        if (sign)
+            ++p;
+        length = 0;
+        for ( ; *p != 'e'; ++p) {
+            if (*p != '.' && length < bufSize)
+                buf[length++] = *p;
+        }
+        int exponent = 0;
+        std::from_chars(p + 2, result.ptr, exponent);
+        decpt = (p[1] == '-' ? -exponent : exponent) + 1;
+        return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -278,6 +308,32 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
         --length;
 }
 
+#ifdef QT_USE_FLOATING_POINT_CHARCONV
+// std::from_chars() is as exact as double-conversion and much faster, so use
+// it whenever it accepts the whole input. Everything else (a leading '+',
+// infinities, out-of-range values, junk) takes the regular path, so results
+// don't change.
+static bool fastAsciiToDouble(const char *num, qsizetype numLen, double &d,
+                              StrayCharacterMode strayCharMode)
+{
+    const char *begin = num;
+    const char *end = num + numLen;
+    if (strayCharMode == TrailingJunkAllowed) {
+        return false;
+    } else if (strayCharMode == WhitespacesAllowed) {
+        while (begin < end && ascii_isspace(*begin))
+            ++begin;
+        while (begin < end && ascii_isspace(end[-1]))
+            --end;
+    }
+
+    if (begin == end || int(numLen) != numLen)
+        return false;
+    const auto result = std::from_chars(begin, end, d);
+    return result.ec == std::errc() && result.ptr == end && qIsFinite(d);
+}
+#endif
+
 double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &processed,
                         StrayCharacterMode strayCharMode)
 {
@@ -320,6 +376,13 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
     }
 
     double d = 0.0;
+#ifdef QT_USE_FLOATING_POINT_CHARCONV
+    // Zero is left to the underflow check below
+    if (fastAsciiToDouble(num, numLen, d, strayCharMode) && !isZero(d)) {
+        processed = int(numLen);
+        return d;
+    }
+#endif
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
     if (strayCharMode == TrailingJunkAllowed) {
@@ -0,0 +1,260 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qstring.h>
+
+#include <new>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+template <typename String, typename View, size_t Size>
+class QSmallStringBase
+{
+public:
+    typedef typename View::storage_type storage_type;
+    typedef typename View::value_type value_type;
+    typedef qsizetype size_type;
+    typedef const storage_type *const_iterator;
+
+    // one byte is left for inlineSize(), one character for the terminator
+    static constexpr qsizetype InlineCapacity = qsizetype((Size - 1) / sizeof(storage_type)) - 1;
+
+    QSmallStringBase() noexcept { inlineSize() = 0; inlineChars()[0] = 0; }
+    QSmallStringBase(View view) { assign(view); }
+    template <size_t N>
+    QSmallStringBase(const storage_type (&string)[N]) { assign(View(string)); }
+    QSmallStringBase(const String &string)
+    {
+        if (string.size() > InlineCapacity) {
+            new (m_storage) String(string);
+            inlineSize() = HeapMarker;
+        } else {
+            assign(string);
+        }
+    }
+    QSmallStringBase(String &&string)
+    {
+        if (string.size() > InlineCapacity) {
+            new (m_storage) String(std::move(string));
+            inlineSize() = HeapMarker;
+        } else {
+            assign(string);
+        }
+    }
+    QSmallStringBase(const QSmallStringBase &other)
+    {
+        if (other.isInline()) {
+            memcpy(m_storage, other.m_storage, Size);
+        } else {
+            new (m_storage) String(other.heapString());
+            inlineSize() = HeapMarker;
+        }
+    }
+    QSmallStringBase(QSmallStringBase &&other) noexcept
+    {
+        // String is relocatable, so the bytes can simply be taken over
+        memcpy(m_storage, other.m_storage, Size);
+        other.inlineSize() = 0;
+        other.inlineChars()[0] = 0;
+    }
+    QSmallStringBase &operator=(const QSmallStringBase &other)
+    {
+        QSmallStringBase copy(other);
+        swap(copy);
+        return *this;
+    }
+    QSmallStringBase &operator=(QSmallStringBase &&other) noexcept
+    {
+        QSmallStringBase moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    ~QSmallStringBase()
+    {
+        if (!isInline())
+            heapString().~String();
+    }
+
+    void swap(QSmallStringBase &other) noexcept
+    {
+        uchar tmp[Size];
+        memcpy(tmp, m_storage, Size);
+        memcpy(m_storage, other.m_storage, Size);
+        memcpy(other.m_storage, tmp, Size);
+    }
+
+    bool isInline() const noexcept { return inlineSize() != HeapMarker; }
+    qsizetype size() const noexcept { return isInline() ? qsizetype(inlineSize()) : heapString().size(); }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    const storage_type *data() const noexcept
+    {
+        return isInline() ? inlineChars() : reinterpret_cast<const storage_type *>(heapString().constData());
+    }
+    const storage_type *constData() const noexcept { return data(); }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator cbegin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    View view() const noexcept { return View(data(), size()); }
+
+    void clear() noexcept
+    {
+        if (!isInline())
+            heapString().~String();
+        inlineSize() = 0;
+        inlineChars()[0] = 0;
+    }
+
+    QSmallStringBase &append(View view)
+    {
+        const qsizetype oldSize = size();
+        if (isInline() && oldSize + view.size() <= InlineCapacity) {
+            memmove(inlineChars() + oldSize, view.data(), view.size() * sizeof(storage_type));
+            inlineSize() = quint8(oldSize + view.size());
+            inlineChars()[inlineSize()] = 0;
+        } else if (isInline()) {
+            // view may point into inlineChars()
+            String string;
+            string.reserve(oldSize + view.size());
+            string.append(this->view()).append(view);
+            new (m_storage) String(std::move(string));
+            inlineSize() = HeapMarker;
+        } else {
+            heapString().append(view);
+        }
+        return *this;
+    }
+    QSmallStringBase &operator+=(View view) { return append(view); }
+
+    friend bool operator==(const QSmallStringBase &lhs, const QSmallStringBase &rhs) noexcept
+    { return lhs.view() == rhs.view(); }
+    friend bool operator!=(const QSmallStringBase &lhs, const QSmallStringBase &rhs) noexcept
+    { return !(lhs == rhs); }
+    friend bool operator<(const QSmallStringBase &lhs, const QSmallStringBase &rhs) noexcept
+    { return lhs.view() < rhs.view(); }
+    friend bool operator<=(const QSmallStringBase &lhs, const QSmallStringBase &rhs) noexcept
+    { return !(rhs < lhs); }
+    friend bool operator>(const QSmallStringBase &lhs, const QSmallStringBase &rhs) noexcept
+    { return rhs < lhs; }
+    friend bool operator>=(const QSmallStringBase &lhs, const QSmallStringBase &rhs) noexcept
+    { return !(lhs < rhs); }
+
+protected:
+    String toOwning() const
+    {
+        if (isInline())
+            return String(reinterpret_cast<const typename String::value_type *>(inlineChars()), size());
+        return heapString();
+    }
+
+private:
+    enum : quint8 { HeapMarker = 0xff };
+    static_assert(InlineCapacity < HeapMarker);
+
+    void assign(View view)
+    {
+        if (view.size() > InlineCapacity) {
+            new (m_storage) String(reinterpret_cast<const typename String::value_type *>(view.data()),
+                                   view.size());
+            inlineSize() = HeapMarker;
+        } else {
+            if (view.size())
+                memcpy(inlineChars(), view.data(), view.size() * sizeof(storage_type));
+            inlineSize() = quint8(view.size());
+            inlineChars()[inlineSize()] = 0;
+        }
+    }
+
+    // the inline size lives in the last byte, which String never covers
+    static_assert(sizeof(String) < Size);
+    String &heapString() noexcept
+    { return *std::launder(reinterpret_cast<String *>(m_storage)); }
+    const String &heapString() const noexcept
+    { return *std::launder(reinterpret_cast<const String *>(m_storage)); }
+    storage_type *inlineChars() noexcept { return reinterpret_cast<storage_type *>(m_storage); }
+    const storage_type *inlineChars() const noexcept
+    { return reinterpret_cast<const storage_type *>(m_storage); }
+    uchar &inlineSize() noexcept { return m_storage[Size - 1]; }
+    uchar inlineSize() const noexcept { return m_storage[Size - 1]; }
+
+    alignas(String) uchar m_storage[Size];
+};
+
+} // namespace QtPrivate
+
+class QSmallString : public QtPrivate::QSmallStringBase<QString, QStringView, 40>
+{
+public:
+    using QSmallStringBase::QSmallStringBase;
+
+    QString toString() const { return toOwning(); }
+
+    // hashes like QString, so that QHash keys can be migrated without surprises
+    friend size_t qHash(const QSmallString &key, size_t seed = 0) noexcept
+    { return qHash(key.view(), seed); }
+};
+static_assert(sizeof(QSmallString) == 40);
+Q_DECLARE_TYPEINFO(QSmallString, Q_RELOCATABLE_TYPE);
+
+class QSmallByteArray : public QtPrivate::QSmallStringBase<QByteArray, QByteArrayView, 32>
+{
+public:
+    using QSmallStringBase::QSmallStringBase;
+
+    QByteArray toByteArray() const { return toOwning(); }
+
+    friend size_t qHash(const QSmallByteArray &key, size_t seed = 0) noexcept
+    { return qHash(key.view(), seed); }
+};
+static_assert(sizeof(QSmallByteArray) == 32);
+Q_DECLARE_TYPEINFO(QSmallByteArray, Q_RELOCATABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
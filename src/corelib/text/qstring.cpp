@@ -360,6 +360,16 @@ extern "C" void qt_fromlatin1_mips_asm_unroll8 (char16_t*, const char*, uint);
 extern "C" void qt_toLatin1_mips_dsp_asm(uchar *dst, const char16_t *src, int length);
 #endif
 
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(__AVX2__) && !defined(QT_BOOTSTRAPPED)
+// From qstring_avx2.cpp, used when the baseline doesn't include AVX2
+#  define QT_STRING_DISPATCH_AVX2
+void qt_from_latin1_avx2(char16_t *dst, const char *str, size_t size) noexcept;
+void qt_to_latin1_avx2(uchar *dst, const char16_t *src, qsizetype length) noexcept;
+void qt_to_latin1_unchecked_avx2(uchar *dst, const char16_t *src, qsizetype length) noexcept;
+const char16_t *qt_qustrchr_avx2(const char16_t *n, const char16_t *e, char16_t c) noexcept;
+size_t qt_ucstrncmp_avx2(const char16_t *a, const char16_t *b, size_t l) noexcept;
+#endif
+
 #if defined(__SSE2__) && defined(Q_CC_GNU) && !defined(Q_CC_INTEL)
 #  if defined(__SANITIZE_ADDRESS__) && Q_CC_GNU < 800 && !defined(Q_CC_CLANG)
 #     warning "The __attribute__ on below will likely cause a build failure with your GCC version. Your choices are:"
@@ -474,6 +484,11 @@ const char16_t *QtPrivate::qustrchr(QStringView str, char16_t c) noexcept
     const char16_t *n = str.utf16();
     const char16_t *e = n + str.size();
 
+#ifdef QT_STRING_DISPATCH_AVX2
+    if (e - n >= 16 && qCpuHasFeature(ArchHaswell))
+        return qt_qustrchr_avx2(n, e, c);
+#endif
+
 #ifdef __SSE2__
     bool loops = true;
     // Using the PMOVMSKB instruction, we get two bits for each character
@@ -811,6 +826,10 @@ Q_CORE_EXPORT void qt_from_latin1(char16_t *dst, const char *str, size_t size) n
      * The same method gives no improvement with NEON. On Aarch64, clang will do the vectorization
      * itself in exactly the same way as one would do it with intrinsics.
      */
+#ifdef QT_STRING_DISPATCH_AVX2
+    if (size >= 16 && qCpuHasFeature(ArchHaswell))
+        return qt_from_latin1_avx2(dst, str, size);
+#endif
 #if defined(__SSE2__)
     const char *e = str + size;
     qptrdiff offset = 0;
@@ -1021,11 +1040,19 @@ static void qt_to_latin1_internal(uchar *dst, const char16_t *src, qsizetype len
 
 void qt_to_latin1(uchar *dst, const char16_t *src, qsizetype length)
 {
+#ifdef QT_STRING_DISPATCH_AVX2
+    if (length >= 16 && qCpuHasFeature(ArchHaswell))
+        return qt_to_latin1_avx2(dst, src, length);
+#endif
     qt_to_latin1_internal<true>(dst, src, length);
 }
 
 void qt_to_latin1_unchecked(uchar *dst, const char16_t *src, qsizetype length)
 {
+#ifdef QT_STRING_DISPATCH_AVX2
+    if (length >= 16 && qCpuHasFeature(ArchHaswell))
+        return qt_to_latin1_unchecked_avx2(dst, src, length);
+#endif
     qt_to_latin1_internal<false>(dst, src, length);
 }
 
@@ -1114,6 +1141,16 @@ extern "C" int qt_ucstrncmp_mips_dsp_asm(const char16_t *a,
 template <StringComparisonMode Mode>
 static int ucstrncmp(const char16_t *a, const char16_t *b, size_t l)
 {
+#ifdef QT_STRING_DISPATCH_AVX2
+    if (l >= 16 && qCpuHasFeature(ArchHaswell)) {
+        size_t idx = qt_ucstrncmp_avx2(a, b, l);
+        if (idx == l)
+            return 0;
+        if (Mode == CompareStringsForEquality)
+            return 1;
+        return a[idx] - b[idx];
+    }
+#endif
 #ifndef __OPTIMIZE_SIZE__
 #  if defined(__mips_dsp)
     static_assert(sizeof(uint) == sizeof(size_t));
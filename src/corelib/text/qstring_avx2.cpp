@@ -0,0 +1,259 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qglobal.h>
+#include <private/qsimd_p.h>
+
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+
+QT_BEGIN_NAMESPACE
+
+// The kernels in this file are compiled for the Haswell architecture level
+// and selected at runtime by qstring.cpp and qstringconverter.cpp when
+// qCpuHasFeature(ArchHaswell) is true. The ones that convert or search a
+// whole range require at least 16 characters, so the final, partial block can
+// be handled by reloading the last 16 characters instead of a scalar tail.
+
+static inline __m256i loadu256(const void *ptr)
+{
+    return _mm256_loadu_si256(static_cast<const __m256i *>(ptr));
+}
+
+static inline void storeu256(void *ptr, __m256i data)
+{
+    _mm256_storeu_si256(static_cast<__m256i *>(ptr), data);
+}
+
+// Latin-1 -> UTF-16 (requires size >= 16)
+void qt_from_latin1_avx2(char16_t *dst, const char *str, size_t size) noexcept
+{
+    size_t offset = 0;
+    for ( ; offset + 32 <= size; offset += 32) {
+        const __m256i chunk = loadu256(str + offset);
+        storeu256(dst + offset, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(chunk)));
+        storeu256(dst + offset + 16, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(chunk, 1)));
+    }
+    if (offset + 16 <= size) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + offset));
+        storeu256(dst + offset, _mm256_cvtepu8_epi16(chunk));
+        offset += 16;
+    }
+    if (offset < size) {
+        // redo the last 16 characters, overlapping what we've already written
+        offset = size - 16;
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + offset));
+        storeu256(dst + offset, _mm256_cvtepu8_epi16(chunk));
+    }
+}
+
+// UTF-16 -> Latin-1 (requires length >= 16)
+template <bool Checked>
+static void toLatin1(uchar *dst, const char16_t *src, qsizetype length) noexcept
+{
+    const __m256i questionMark = _mm256_set1_epi16('?');
+    const __m256i outOfRange = _mm256_set1_epi16(0x100);
+    auto mergeQuestionMarks = [=](__m256i chunk) {
+        if (Checked) {
+            // unsigned min with 0x100, then replace everything equal to it
+            chunk = _mm256_min_epu16(chunk, outOfRange);
+            const __m256i offLimitMask = _mm256_cmpeq_epi16(chunk, outOfRange);
+            chunk = _mm256_blendv_epi8(chunk, questionMark, offLimitMask);
+        }
+        return chunk;
+    };
+    auto pack16 = [=](qsizetype offset) {
+        const __m256i chunk = mergeQuestionMarks(loadu256(src + offset));
+        const __m128i result = _mm_packus_epi16(_mm256_castsi256_si128(chunk),
+                                                _mm256_extracti128_si256(chunk, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset), result);
+    };
+
+    qsizetype offset = 0;
+    for ( ; offset + 32 <= length; offset += 32) {
+        const __m256i chunk1 = mergeQuestionMarks(loadu256(src + offset));
+        const __m256i chunk2 = mergeQuestionMarks(loadu256(src + offset + 16));
+
+        // VPACKUSWB packs within each 128-bit lane, so restore the order
+        // of the 64-bit quarters afterwards
+        __m256i result = _mm256_packus_epi16(chunk1, chunk2);
+        result = _mm256_permute4x64_epi64(result, _MM_SHUFFLE(3, 1, 2, 0));
+        storeu256(dst + offset, result);
+    }
+    if (offset + 16 <= length) {
+        pack16(offset);
+        offset += 16;
+    }
+    if (offset < length)
+        pack16(length - 16);
+}
+
+void qt_to_latin1_avx2(uchar *dst, const char16_t *src, qsizetype length) noexcept
+{
+    toLatin1<true>(dst, src, length);
+}
+
+void qt_to_latin1_unchecked_avx2(uchar *dst, const char16_t *src, qsizetype length) noexcept
+{
+    toLatin1<false>(dst, src, length);
+}
+
+// Search for c in [n, e) (requires e - n >= 16); returns e if not found
+const char16_t *qt_qustrchr_avx2(const char16_t *n, const char16_t *e, char16_t c) noexcept
+{
+    const __m256i mch = _mm256_set1_epi16(short(c));
+    for ( ; e - n >= 32; n += 32) {
+        const __m256i result1 = _mm256_cmpeq_epi16(loadu256(n), mch);
+        const __m256i result2 = _mm256_cmpeq_epi16(loadu256(n + 16), mch);
+        const __m256i any = _mm256_or_si256(result1, result2);
+        if (_mm256_testz_si256(any, any))
+            continue;
+        if (uint mask = uint(_mm256_movemask_epi8(result1)))
+            return n + qCountTrailingZeroBits(mask) / 2;
+        return n + 16 + qCountTrailingZeroBits(uint(_mm256_movemask_epi8(result2))) / 2;
+    }
+
+    auto find16 = [mch](const char16_t *ptr) -> const char16_t * {
+        const __m256i result = _mm256_cmpeq_epi16(loadu256(ptr), mch);
+        if (uint mask = uint(_mm256_movemask_epi8(result)))
+            return ptr + qCountTrailingZeroBits(mask) / 2;
+        return nullptr;
+    };
+    if (e - n >= 16) {
+        if (const char16_t *found = find16(n))
+            return found;
+        n += 16;
+    }
+    if (n != e) {
+        // the overlapping part has already been searched, so the first match
+        // in the last 16 characters is also the first one in the string
+        if (const char16_t *found = find16(e - 16))
+            return found;
+    }
+    return e;
+}
+
+// Returns the index of the first difference between a and b, or l if the
+// first l characters are equal (requires l >= 16)
+size_t qt_ucstrncmp_avx2(const char16_t *a, const char16_t *b, size_t l) noexcept
+{
+    size_t offset = 0;
+    for ( ; offset + 32 <= l; offset += 32) {
+        const __m256i result1 = _mm256_cmpeq_epi16(loadu256(a + offset), loadu256(b + offset));
+        const __m256i result2 = _mm256_cmpeq_epi16(loadu256(a + offset + 16),
+                                                   loadu256(b + offset + 16));
+        const __m256i both = _mm256_and_si256(result1, result2);
+        if (uint(_mm256_movemask_epi8(both)) == 0xffffffffU)
+            continue;
+        if (uint mask = ~uint(_mm256_movemask_epi8(result1)))
+            return offset + qCountTrailingZeroBits(mask) / 2;
+        return offset + 16 + qCountTrailingZeroBits(~uint(_mm256_movemask_epi8(result2))) / 2;
+    }
+
+    auto compare16 = [a, b](size_t offset) {
+        const __m256i result = _mm256_cmpeq_epi16(loadu256(a + offset), loadu256(b + offset));
+        if (uint mask = ~uint(_mm256_movemask_epi8(result)))
+            return offset + qCountTrailingZeroBits(mask) / 2;
+        return size_t(-1);
+    };
+    if (offset + 16 <= l) {
+        size_t idx = compare16(offset);
+        if (idx != size_t(-1))
+            return idx;
+        offset += 16;
+    }
+    if (offset < l) {
+        size_t idx = compare16(l - 16);
+        if (idx != size_t(-1))
+            return idx;
+    }
+    return l;
+}
+
+// The UTF-8 helpers below only consume whole 32-character blocks of US-ASCII
+// and return how many characters they consumed; the caller continues with
+// its own code at the first block containing a non-ASCII character.
+
+qsizetype qt_utf8_encode_ascii_avx2(uchar *dst, const char16_t *src, qsizetype len) noexcept
+{
+    const __m256i nonAsciiMask = _mm256_set1_epi16(short(0xff80));
+    qsizetype offset = 0;
+    for ( ; offset + 32 <= len; offset += 32) {
+        const __m256i data1 = loadu256(src + offset);
+        const __m256i data2 = loadu256(src + offset + 16);
+        if (!_mm256_testz_si256(_mm256_or_si256(data1, data2), nonAsciiMask))
+            break;
+        __m256i packed = _mm256_packus_epi16(data1, data2);
+        packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        storeu256(dst + offset, packed);
+    }
+    return offset;
+}
+
+qsizetype qt_utf8_decode_ascii_avx2(char16_t *dst, const uchar *src, qsizetype len) noexcept
+{
+    const __m256i nonAsciiMask = _mm256_set1_epi8(char(0x80));
+    qsizetype offset = 0;
+    for ( ; offset + 32 <= len; offset += 32) {
+        const __m256i data = loadu256(src + offset);
+        if (!_mm256_testz_si256(data, nonAsciiMask))
+            break;
+        storeu256(dst + offset, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(data)));
+        storeu256(dst + offset + 16, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(data, 1)));
+    }
+    return offset;
+}
+
+const uchar *qt_utf8_skip_ascii_avx2(const uchar *src, const uchar *end) noexcept
+{
+    const __m256i nonAsciiMask = _mm256_set1_epi8(char(0x80));
+    for ( ; end - src >= 64; src += 64) {
+        const __m256i data = _mm256_or_si256(loadu256(src), loadu256(src + 32));
+        if (!_mm256_testz_si256(data, nonAsciiMask))
+            break;
+    }
+    for ( ; end - src >= 32; src += 32) {
+        if (!_mm256_testz_si256(loadu256(src), nonAsciiMask))
+            break;
+    }
+    return src;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_AVX2
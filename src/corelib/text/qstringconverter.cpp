@@ -86,9 +86,26 @@ static Q_ALWAYS_INLINE uint qBitScanReverse(unsigned v) noexcept
 }
 #endif
 
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(__AVX2__) && !defined(QT_BOOTSTRAPPED)
+// From qstring_avx2.cpp, used when the baseline doesn't include AVX2
+#  define QT_STRINGCONVERTER_DISPATCH_AVX2
+qsizetype qt_utf8_encode_ascii_avx2(uchar *dst, const char16_t *src, qsizetype len) noexcept;
+qsizetype qt_utf8_decode_ascii_avx2(char16_t *dst, const uchar *src, qsizetype len) noexcept;
+const uchar *qt_utf8_skip_ascii_avx2(const uchar *src, const uchar *end) noexcept;
+#endif
+
 #if defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
 static inline bool simdEncodeAscii(uchar *&dst, const char16_t *&nextAscii, const char16_t *&src, const char16_t *end)
 {
+#ifdef QT_STRINGCONVERTER_DISPATCH_AVX2
+    // consume the pure US-ASCII blocks, the loop below handles the rest
+    if (end - src >= 32 && qCpuHasFeature(ArchHaswell)) {
+        qsizetype n = qt_utf8_encode_ascii_avx2(dst, src, end - src);
+        dst += n;
+        src += n;
+    }
+#endif
+
     // do sixteen characters at a time
     for ( ; end - src >= 16; src += 16, dst += 16) {
 #  ifdef __AVX2__
@@ -153,6 +170,15 @@ static inline bool simdEncodeAscii(uchar *&dst, const char16_t *&nextAscii, cons
 
 static inline bool simdDecodeAscii(char16_t *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end)
 {
+#ifdef QT_STRINGCONVERTER_DISPATCH_AVX2
+    // consume the pure US-ASCII blocks, the loop below handles the rest
+    if (end - src >= 32 && qCpuHasFeature(ArchHaswell)) {
+        qsizetype n = qt_utf8_decode_ascii_avx2(dst, src, end - src);
+        dst += n;
+        src += n;
+    }
+#endif
+
     // do sixteen characters at a time
     for ( ; end - src >= 16; src += 16, dst += 16) {
         __m128i data = _mm_loadu_si128((const __m128i*)src);
@@ -220,6 +246,12 @@ static inline bool simdDecodeAscii(char16_t *&dst, const uchar *&nextAscii, cons
 
 static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end, const uchar *&nextAscii)
 {
+#ifdef QT_STRINGCONVERTER_DISPATCH_AVX2
+    // skip the pure US-ASCII blocks, the loops below find the exact position
+    if (end - src >= 32 && qCpuHasFeature(ArchHaswell))
+        src = qt_utf8_skip_ascii_avx2(src, end);
+#endif
+
 #ifdef __AVX2__
     // do 32 characters at a time
     // (this is similar to simdTestMask in qstring.cpp)
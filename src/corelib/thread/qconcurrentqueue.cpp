@@ -0,0 +1,272 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qconcurrentqueue.h"
+
+#include "private/qfutex_p.h"
+#ifndef QT_ALWAYS_USE_FUTEX
+#  include "qmutex.h"
+#  include "qwaitcondition.h"
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QConcurrentQueue
+    \inmodule QtCore
+    \since 6.4
+    \brief The QConcurrentQueue class is a bounded queue that any number of
+           threads can push to and pop from without locking.
+    \threadsafe
+    \ingroup thread
+
+    QConcurrentQueue hands items from producer threads over to consumer
+    threads. It stores up to capacity() items in a ring allocated when the
+    queue is constructed, so pushing and popping never allocate memory.
+
+    tryPush() and tryPop() never block: they return \c false if the queue
+    is full or empty, respectively. push() and pop() wait until they can
+    complete. A waiting thread sleeps, and threads that push or pop only
+    make a system call to wake it if some thread is actually waiting.
+
+    \snippet code/src_corelib_thread_qconcurrentqueue.cpp 0
+
+    Items are popped in the order they were pushed by any one producer.
+    Items from different producers can be interleaved in any order.
+
+    If there is only one producer and one consumer, QSpscQueue is faster.
+
+    \sa QSpscQueue, QSemaphore
+*/
+
+/*!
+    \fn template <typename T> QConcurrentQueue<T>::QConcurrentQueue(qsizetype capacity)
+
+    Constructs an empty queue that can hold at least \a capacity items.
+    The capacity is rounded up to a power of two.
+*/
+
+/*!
+    \fn template <typename T> QConcurrentQueue<T>::~QConcurrentQueue()
+
+    Destroys the queue and the items it still holds. No other thread may
+    use the queue at this point.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QConcurrentQueue<T>::capacity() const
+
+    Returns the number of items the queue can hold.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QConcurrentQueue<T>::size() const
+
+    Returns the number of items in the queue. If other threads use the
+    queue at the same time, the result may be outdated when it's returned.
+*/
+
+/*!
+    \fn template <typename T> bool QConcurrentQueue<T>::isEmpty() const
+
+    Returns \c true if the queue holds no items. If other threads use the
+    queue at the same time, the result may be outdated when it's returned.
+*/
+
+/*!
+    \fn template <typename T> bool QConcurrentQueue<T>::tryPush(const T &value)
+    \fn template <typename T> bool QConcurrentQueue<T>::tryPush(T &&value)
+
+    Appends \a value to the queue and returns \c true, or returns \c false
+    without blocking if the queue is full. \a value is only moved from if
+    it was appended.
+
+    If copying or moving \a value into the queue throws an exception, the
+    exception is passed on and nothing is appended. The place in the queue
+    that was reserved for the item stays in use until a consumer skips it.
+*/
+
+/*!
+    \fn template <typename T> bool QConcurrentQueue<T>::tryPop(T &value)
+
+    Moves the oldest item of the queue into \a value, removes it, and
+    returns \c true. Returns \c false without blocking if the queue is
+    empty.
+*/
+
+/*!
+    \fn template <typename T> void QConcurrentQueue<T>::push(const T &value)
+    \fn template <typename T> void QConcurrentQueue<T>::push(T &&value)
+
+    Appends \a value to the queue, waiting for room if the queue is full.
+    Exceptions are handled like in tryPush().
+*/
+
+/*!
+    \fn template <typename T> T QConcurrentQueue<T>::pop()
+
+    Removes the oldest item of the queue and returns it, waiting for an
+    item if the queue is empty.
+*/
+
+/*!
+    \class QSpscQueue
+    \inmodule QtCore
+    \since 6.4
+    \brief The QSpscQueue class is a bounded queue for exactly one producer
+           and one consumer thread.
+    \ingroup thread
+
+    QSpscQueue has the same API as QConcurrentQueue, but only one thread
+    may push and only one other thread may pop at any time. With that
+    restriction, no atomic read-modify-write operations are needed, and
+    each side reads the other side's position only when the queue looks
+    full or empty.
+
+    \sa QConcurrentQueue
+*/
+
+/*!
+    \fn template <typename T> QSpscQueue<T>::QSpscQueue(qsizetype capacity)
+
+    Constructs an empty queue that can hold at least \a capacity items.
+    The capacity is rounded up to a power of two.
+*/
+
+/*!
+    \fn template <typename T> QSpscQueue<T>::~QSpscQueue()
+
+    Destroys the queue and the items it still holds.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QSpscQueue<T>::capacity() const
+
+    Returns the number of items the queue can hold.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QSpscQueue<T>::size() const
+    \fn template <typename T> bool QSpscQueue<T>::isEmpty() const
+
+    Returns the number of items in the queue, or whether it is empty. The
+    result may be outdated by the time it's returned.
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::tryPush(const T &value)
+    \fn template <typename T> bool QSpscQueue<T>::tryPush(T &&value)
+    \fn template <typename T> bool QSpscQueue<T>::tryPop(T &value)
+    \fn template <typename T> void QSpscQueue<T>::push(const T &value)
+    \fn template <typename T> void QSpscQueue<T>::push(T &&value)
+    \fn template <typename T> T QSpscQueue<T>::pop()
+
+    These work like the functions of the same name in QConcurrentQueue.
+    The push functions may only be called by the producer thread, \a value
+    being the item to append; the pop functions only by the consumer thread.
+*/
+
+namespace QtPrivate {
+
+// Starts a new epoch and clears the waiter bit, unless another thread
+// already did since the caller saw the bit set. Returns true if it did.
+static bool advance(QBasicAtomicInteger<quint32> &state) noexcept
+{
+    quint32 value = state.loadRelaxed();
+    while (value & 1) {
+        // odd + 1 clears the bit and carries into the epoch
+        if (state.testAndSetRelease(value, value + 1, value))
+            return true;
+    }
+    return false;
+}
+
+#ifdef QT_ALWAYS_USE_FUTEX
+void QEventCount::wait(quint32 ticket) noexcept
+{
+    while (m_state.loadAcquire() == ticket)
+        QtFutex::futexWait(m_state, ticket);
+}
+
+void QEventCount::wake() noexcept
+{
+    if (advance(m_state))
+        QtFutex::futexWakeAll(m_state);
+}
+#else
+// Event counts share a few mutexes and wait conditions; a thread woken for
+// another event count sharing its bucket just checks its epoch again.
+namespace {
+struct WaitBucket
+{
+    QMutex mutex;
+    QWaitCondition condition;
+};
+struct WaitBuckets
+{
+    WaitBucket buckets[16];
+    WaitBucket &operator[](const void *address)
+    { return buckets[(quintptr(address) / 64) % std::size(buckets)]; }
+};
+}
+Q_GLOBAL_STATIC(WaitBuckets, waitBuckets)
+
+void QEventCount::wait(quint32 ticket) noexcept
+{
+    WaitBucket &bucket = (*waitBuckets)[this];
+    {
+        QMutexLocker locker(&bucket.mutex);
+        while (m_state.loadAcquire() == ticket)
+            bucket.condition.wait(&bucket.mutex);
+    }
+}
+
+void QEventCount::wake() noexcept
+{
+    WaitBucket &bucket = (*waitBuckets)[this];
+    if (!advance(m_state))
+        return;
+    QMutexLocker locker(&bucket.mutex);
+    bucket.condition.wakeAll();
+}
+#endif
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
@@ -0,0 +1,375 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTQUEUE_H
+#define QCONCURRENTQUEUE_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qscopeguard.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <optional>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// Lets threads sleep until a condition they polled for may have changed.
+// A waiter takes a ticket with prepareWait(), checks its condition once more
+// and then calls wait() if it still has to. The lowest bit of the state says
+// whether anybody took a ticket since the last wake, so notifyAll() is cheap
+// both when nobody waits and when the waiters were already woken.
+class Q_CORE_EXPORT QEventCount
+{
+public:
+    quint32 prepareWait() noexcept
+    {
+        const quint32 ticket = m_state.fetchAndOrOrdered(1) | 1;
+        // fetchAndOrOrdered() is only acquire-release; the fence pairs with
+        // the one in notifyAll()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return ticket;
+    }
+    void wait(quint32 ticket) noexcept;
+
+    void notifyAll() noexcept
+    {
+        // pairs with the fence in prepareWait(): either the
+        // waiter sees the new state or we see the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_state.loadRelaxed() & 1)
+            wake();
+    }
+
+private:
+    void wake() noexcept;
+
+    // epoch in the upper 31 bits, "has waiters" in the lowest bit
+    QBasicAtomicInteger<quint32> m_state = Q_BASIC_ATOMIC_INITIALIZER(0);
+};
+
+template <typename T>
+union QConcurrentQueueSlot
+{
+    QConcurrentQueueSlot() noexcept {}
+    ~QConcurrentQueueSlot() {}
+    T value;
+};
+
+// keeps indices written by different threads on separate cache lines
+constexpr size_t QConcurrentQueueAlignment = 64;
+
+} // namespace QtPrivate
+
+template <typename T>
+class QConcurrentQueue
+{
+    struct Cell
+    {
+        QAtomicInteger<quintptr> sequence;
+        bool abandoned = false; // published without a value
+        QtPrivate::QConcurrentQueueSlot<T> slot;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    quintptr m_mask;
+    alignas(QtPrivate::QConcurrentQueueAlignment) QAtomicInteger<quintptr> m_enqueuePos;
+    alignas(QtPrivate::QConcurrentQueueAlignment) QAtomicInteger<quintptr> m_dequeuePos;
+    alignas(QtPrivate::QConcurrentQueueAlignment) QtPrivate::QEventCount m_notEmpty;
+    QtPrivate::QEventCount m_notFull;
+
+    // Each cell's sequence number tells which lap of the ring it's ready
+    // for: pos when it can be written, pos + 1 once it holds a value.
+    // A claimed cell must be published even if constructing the value
+    // throws, or the consumer of that cell would wait forever; it's then
+    // marked as abandoned for the consumer to skip.
+    template <typename U>
+    bool enqueue(U &&value)
+    {
+        quintptr pos = m_enqueuePos.loadRelaxed();
+        Cell *cell;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            const qintptr diff = qintptr(cell->sequence.loadAcquire() - pos);
+            if (diff == 0) {
+                if (m_enqueuePos.testAndSetRelaxed(pos, pos + 1, pos))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueuePos.loadRelaxed();
+            }
+        }
+        const auto publish = qScopeGuard([this, cell, pos] {
+            cell->sequence.storeRelease(pos + 1);
+            m_notEmpty.notifyAll();
+        });
+        if constexpr (std::is_nothrow_constructible_v<T, U &&>) {
+            new (&cell->slot.value) T(std::forward<U>(value));
+        } else {
+            QT_TRY {
+                new (&cell->slot.value) T(std::forward<U>(value));
+            } QT_CATCH(...) {
+                cell->abandoned = true;
+                QT_RETHROW;
+            }
+        }
+        return true;
+    }
+
+    template <typename Consumer>
+    bool dequeue(Consumer consumer)
+    {
+        quintptr pos = m_dequeuePos.loadRelaxed();
+        Cell *cell;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            const qintptr diff = qintptr(cell->sequence.loadAcquire() - (pos + 1));
+            if (diff == 0) {
+                if (m_dequeuePos.testAndSetRelaxed(pos, pos + 1, pos)) {
+                    if (!cell->abandoned)
+                        break;
+                    cell->abandoned = false;
+                    release(cell, pos);
+                    ++pos;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeuePos.loadRelaxed();
+            }
+        }
+        const auto cleanup = qScopeGuard([this, cell, pos] {
+            cell->slot.value.~T();
+            release(cell, pos);
+        });
+        consumer(cell->slot.value);
+        return true;
+    }
+
+    // lets producers write the cell on the next lap
+    void release(Cell *cell, quintptr pos) noexcept
+    {
+        cell->sequence.storeRelease(pos + m_mask + 1);
+        m_notFull.notifyAll();
+    }
+
+public:
+    using value_type = T;
+
+    explicit QConcurrentQueue(qsizetype capacity)
+        : m_mask(1), m_enqueuePos(0), m_dequeuePos(0)
+    {
+        Q_ASSERT(capacity > 0);
+        while (m_mask + 1 < quintptr(capacity))
+            m_mask = m_mask * 2 + 1;
+        m_cells.reset(new Cell[m_mask + 1]);
+        for (quintptr i = 0; i <= m_mask; ++i)
+            m_cells[i].sequence.storeRelaxed(i);
+    }
+    ~QConcurrentQueue()
+    {
+        while (dequeue([](T &) {}))
+            ;
+    }
+
+    qsizetype capacity() const noexcept { return qsizetype(m_mask + 1); }
+    qsizetype size() const noexcept
+    {
+        const qintptr n = qintptr(m_enqueuePos.loadRelaxed() - m_dequeuePos.loadRelaxed());
+        return qBound(qsizetype(0), qsizetype(n), capacity());
+    }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool tryPush(const T &value) { return enqueue(value); }
+    bool tryPush(T &&value) { return enqueue(std::move(value)); }
+    bool tryPop(T &value) { return dequeue([&value](T &item) { value = std::move(item); }); }
+
+    void push(const T &value)
+    {
+        while (!enqueue(value)) {
+            const quint32 ticket = m_notFull.prepareWait();
+            if (enqueue(value))
+                return;
+            m_notFull.wait(ticket);
+        }
+    }
+    void push(T &&value)
+    {
+        // enqueue() only moves from value once it has claimed a cell
+        while (!enqueue(std::move(value))) {
+            const quint32 ticket = m_notFull.prepareWait();
+            if (enqueue(std::move(value)))
+                return;
+            m_notFull.wait(ticket);
+        }
+    }
+    T pop()
+    {
+        std::optional<T> result;
+        const auto take = [&result](T &item) { result.emplace(std::move(item)); };
+        while (!dequeue(take)) {
+            const quint32 ticket = m_notEmpty.prepareWait();
+            if (dequeue(take))
+                break;
+            m_notEmpty.wait(ticket);
+        }
+        return std::move(*result);
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentQueue)
+};
+
+template <typename T>
+class QSpscQueue
+{
+    using Slot = QtPrivate::QConcurrentQueueSlot<T>;
+
+    std::unique_ptr<Slot[]> m_slots;
+    quintptr m_mask;
+    // written by the consumer
+    alignas(QtPrivate::QConcurrentQueueAlignment) QAtomicInteger<quintptr> m_head;
+    quintptr m_cachedTail = 0;
+    // written by the producer
+    alignas(QtPrivate::QConcurrentQueueAlignment) QAtomicInteger<quintptr> m_tail;
+    quintptr m_cachedHead = 0;
+    alignas(QtPrivate::QConcurrentQueueAlignment) QtPrivate::QEventCount m_notEmpty;
+    QtPrivate::QEventCount m_notFull;
+
+    template <typename U>
+    bool enqueue(U &&value)
+    {
+        const quintptr tail = m_tail.loadRelaxed();
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.loadAcquire();
+            if (tail - m_cachedHead > m_mask)
+                return false;
+        }
+        new (&m_slots[tail & m_mask].value) T(std::forward<U>(value));
+        m_tail.storeRelease(tail + 1);
+        m_notEmpty.notifyAll();
+        return true;
+    }
+
+    template <typename Consumer>
+    bool dequeue(Consumer consumer)
+    {
+        const quintptr head = m_head.loadRelaxed();
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.loadAcquire();
+            if (head == m_cachedTail)
+                return false;
+        }
+        T &item = m_slots[head & m_mask].value;
+        consumer(item);
+        item.~T();
+        m_head.storeRelease(head + 1);
+        m_notFull.notifyAll();
+        return true;
+    }
+
+public:
+    using value_type = T;
+
+    explicit QSpscQueue(qsizetype capacity)
+        : m_mask(1), m_head(0), m_tail(0)
+    {
+        Q_ASSERT(capacity > 0);
+        while (m_mask + 1 < quintptr(capacity))
+            m_mask = m_mask * 2 + 1;
+        m_slots.reset(new Slot[m_mask + 1]);
+    }
+    ~QSpscQueue()
+    {
+        while (dequeue([](T &) {}))
+            ;
+    }
+
+    qsizetype capacity() const noexcept { return qsizetype(m_mask + 1); }
+    qsizetype size() const noexcept
+    { return qsizetype(m_tail.loadAcquire() - m_head.loadAcquire()); }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool tryPush(const T &value) { return enqueue(value); }
+    bool tryPush(T &&value) { return enqueue(std::move(value)); }
+    bool tryPop(T &value) { return dequeue([&value](T &item) { value = std::move(item); }); }
+
+    void push(const T &value)
+    {
+        while (!enqueue(value)) {
+            const quint32 ticket = m_notFull.prepareWait();
+            if (enqueue(value))
+                return;
+            m_notFull.wait(ticket);
+        }
+    }
+    void push(T &&value)
+    {
+        while (!enqueue(std::move(value))) {
+            const quint32 ticket = m_notFull.prepareWait();
+            if (enqueue(std::move(value)))
+                return;
+            m_notFull.wait(ticket);
+        }
+    }
+    T pop()
+    {
+        std::optional<T> result;
+        const auto take = [&result](T &item) { result.emplace(std::move(item)); };
+        while (!dequeue(take)) {
+            const quint32 ticket = m_notEmpty.prepareWait();
+            if (dequeue(take))
+                break;
+            m_notEmpty.wait(ticket);
+        }
+        return std::move(*result);
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QSpscQueue)
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTQUEUE_H
@@ -44,6 +44,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -60,15 +61,25 @@ public:
     void run() override;
     void registerThreadInactive();
 
+    QRunnable *takeLocalTask();
+    bool takeLocalTask(QRunnable *task);
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // Tasks started from within this thread while the pool was saturated.
+    // The owner takes them from the front, idle threads steal from the back.
+    QMutex localMutex;
+    QList<QRunnable *> localQueue;
 };
 
 /*
     QThreadPool private class.
 */
 
+// the pool thread running on the current thread, if any
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
 
 /*!
     \internal
@@ -84,6 +95,8 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
+
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -91,27 +104,35 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+
+                // Run the task, followed by the ones it queued locally, without
+                // going through the pool until a more urgent task shows up.
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        locker.relock();
+                        manager->requeueLocalTasks(this);
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+                } while (!manager->hasUrgentTasks.loadRelaxed() && (r = takeLocalTask()));
+
                 locker.relock();
             }
 
@@ -120,17 +141,11 @@ void QThreadPoolThread::run()
                 break;
 
             // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
-                break;
+            r = manager->takeNextTask(this);
+        } while (r);
 
-            QueuePage *page = manager->queue.first();
-            r = page->pop();
-
-            if (page->isFinished()) {
-                manager->queue.removeFirst();
-                delete page;
-            }
-        } while (true);
+        // leave the tasks that are still queued here to the other threads
+        manager->requeueLocalTasks(this);
 
         // this thread is about to be deleted, do not wait or expire
         if (!manager->allThreads.contains(this)) {
@@ -167,6 +182,17 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+QRunnable *QThreadPoolThread::takeLocalTask()
+{
+    QMutexLocker locker(&localMutex);
+    return localQueue.isEmpty() ? nullptr : localQueue.takeFirst();
+}
+
+bool QThreadPoolThread::takeLocalTask(QRunnable *task)
+{
+    QMutexLocker locker(&localMutex);
+    return localQueue.removeOne(task);
+}
 
 /*
     \internal
@@ -216,6 +242,42 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
     return true;
 }
 
+/*!
+    \internal
+
+    Queues \a task on the current thread if it is one of this pool's threads
+    and all threads of the pool are busy, so that neither the caller nor the
+    thread running \a task later needs to take the pool's mutex. Idle threads
+    steal from these local queues before they go to sleep.
+
+    Returns \c false if the task has to go through the pool instead.
+*/
+bool QThreadPoolPrivate::tryPushLocalTask(QRunnable *task)
+{
+    QThreadPoolThread *thread = currentPoolThread;
+    if (!thread || thread->manager != this || !saturated.loadRelaxed())
+        return false;
+
+    {
+        QMutexLocker locker(&thread->localMutex);
+        thread->localQueue.append(task);
+    }
+
+    // A thread that runs out of work clears the flag before it looks at the
+    // local queues. If that happened after it looked at ours, it may sleep
+    // without having seen the task, so hand it out the regular way.
+    if (saturated.loadRelaxed())
+        return true;
+
+    QMutexLocker locker(&mutex);
+    if (thread->takeLocalTask(task)) {
+        if (!tryStart(task))
+            enqueueTask(task);
+        updateSaturation();
+    }
+    return true;
+}
+
 inline bool comparePriority(int priority, const QueuePage *p)
 {
     return p->priority() < priority;
@@ -232,6 +294,85 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updateUrgentTasks();
+}
+
+/*!
+    \internal
+
+    Returns the next task for \a thread to run, or \c nullptr if there is
+    none: queued tasks with a priority above 0 first, then the tasks the
+    thread queued itself, then the rest of the queue and finally a task
+    stolen from another thread.
+*/
+QRunnable *QThreadPoolPrivate::takeNextTask(QThreadPoolThread *thread)
+{
+    if (!hasUrgentTasks.loadRelaxed()) {
+        if (QRunnable *r = thread->takeLocalTask())
+            return r;
+    }
+    if (QRunnable *r = takeQueuedTask())
+        return r;
+
+    // This thread is about to become idle. Clear the flag before looking at
+    // the other threads, see tryPushLocalTask().
+    saturated.storeRelaxed(false);
+    return stealTask(thread);
+}
+
+QRunnable *QThreadPoolPrivate::takeQueuedTask()
+{
+    if (queue.isEmpty())
+        return nullptr;
+
+    QueuePage *page = queue.first();
+    QRunnable *r = page->pop();
+
+    if (page->isFinished()) {
+        queue.removeFirst();
+        delete page;
+        updateUrgentTasks();
+    }
+    return r;
+}
+
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        if (thread == thief)
+            continue;
+        QMutexLocker locker(&thread->localMutex);
+        if (!thread->localQueue.isEmpty())
+            return thread->localQueue.takeLast();
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Moves the tasks left in the local queue of \a thread, which is about to
+    become inactive, to the pool's queue.
+*/
+void QThreadPoolPrivate::requeueLocalTasks(QThreadPoolThread *thread)
+{
+    QList<QRunnable *> tasks;
+    {
+        QMutexLocker locker(&thread->localMutex);
+        tasks.swap(thread->localQueue);
+    }
+    for (QRunnable *task : qAsConst(tasks))
+        enqueueTask(task);
+}
+
+void QThreadPoolPrivate::updateSaturation()
+{
+    saturated.storeRelaxed(!allThreads.isEmpty() && areAllThreadsActive());
+}
+
+void QThreadPoolPrivate::updateUrgentTasks()
+{
+    hasUrgentTasks.storeRelaxed(!queue.isEmpty() && queue.constFirst()->priority() > 0);
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -257,6 +398,17 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updateUrgentTasks();
+
+    // then the tasks that busy threads queued locally
+    while (!allThreads.isEmpty() && !areAllThreadsActive()) {
+        QRunnable *r = stealTask(nullptr);
+        if (!r)
+            break;
+        if (!tryStart(r))
+            enqueueTask(r);
+    }
+    updateSaturation();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -357,6 +509,18 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updateUrgentTasks();
+
+    QList<QRunnable *> localTasks;
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        localTasks.append(std::exchange(thread->localQueue, {}));
+    }
+    locker.unlock();
+    for (QRunnable *r : qAsConst(localTasks)) {
+        if (r->autoDelete())
+            delete r;
+    }
 }
 
 /*!
@@ -389,11 +553,17 @@ bool QThreadPool::tryTake(QRunnable *runnable)
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
+                d->updateUrgentTasks();
             }
             return true;
         }
     }
 
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+        if (thread->takeLocalTask(runnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -531,10 +701,14 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->tryPushLocalTask(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
         d->enqueueTask(runnable, priority);
+    d->updateSaturation();
 }
 
 /*!
@@ -576,10 +750,9 @@ bool QThreadPool::tryStart(QRunnable *runnable)
 
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
-    if (d->tryStart(runnable))
-        return true;
-
-    return false;
+    const bool started = d->tryStart(runnable);
+    d->updateSaturation();
+    return started;
 }
 
 /*!
@@ -602,7 +775,9 @@ bool QThreadPool::tryStart(std::function<void()> functionToRun)
         return false;
 
     QRunnable *runnable = QRunnable::create(std::move(functionToRun));
-    if (d->tryStart(runnable))
+    const bool started = d->tryStart(runnable);
+    d->updateSaturation();
+    if (started)
         return true;
     delete runnable;
     return false;
@@ -704,6 +879,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateSaturation();
 }
 
 /*! \property QThreadPool::stackSize
@@ -810,6 +986,7 @@ void QThreadPool::startOnReservedThread(QRunnable *runnable)
         // and something took the one minimum thread.
         d->enqueueTask(runnable, INT_MAX);
     }
+    d->updateSaturation();
 }
 
 /*!
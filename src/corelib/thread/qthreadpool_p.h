@@ -153,7 +153,14 @@ public:
     QThreadPoolPrivate();
 
     bool tryStart(QRunnable *task);
+    bool tryPushLocalTask(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    QRunnable *takeNextTask(QThreadPoolThread *thread);
+    QRunnable *takeQueuedTask();
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    void requeueLocalTasks(QThreadPoolThread *thread);
+    void updateSaturation();
+    void updateUrgentTasks();
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -178,6 +185,13 @@ public:
     QWaitCondition noActiveThreads;
     QString objectName;
 
+    // Hints read without holding the mutex. saturated is set when all threads
+    // are active, which is when tasks started from a pool thread stay in that
+    // thread's local queue; hasUrgentTasks is set when the first task in the
+    // queue has a priority above 0 and must go before the local queues.
+    QAtomicInt saturated;
+    QAtomicInt hasUrgentTasks;
+
     int expiryTimeout = 30000;
     int requestedMaxThreadCount = QThread::idealThreadCount();  // don't use this directly
     int reservedThreads = 0;
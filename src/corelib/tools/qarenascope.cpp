@@ -0,0 +1,395 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qarenascope.h"
+#include "qarenascope_p.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+
+#include <cstddef>
+#include <new>
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QArenaScope
+    \inmodule QtCore
+    \since 6.4
+    \reentrant
+
+    \brief The QArenaScope class makes the current thread allocate container
+    data from an arena while it exists.
+
+    While a QArenaScope exists, QString, QByteArray and QList take the memory
+    for their data from large chunks owned by the scope, instead of allocating
+    each block with \c malloc(). Freeing a block mostly just lowers a counter
+    in its chunk; only the most recently allocated block, or a chunk that has
+    become empty, is handed out again. A chunk is returned to the system once
+    it is full, or the scope has ended, and all of its blocks have been
+    freed. This suits work that creates many short-lived strings and lists
+    which all die together, such as handling a single request.
+
+    \snippet code/src_corelib_tools_qarenascope.cpp 0
+
+    Data may outlive the scope that allocated it: copies share it and detach
+    from it as usual, and its chunk stays alive until the last block in it has
+    been freed. Such data can be freed from any thread. Keep in mind that a
+    single long-lived block keeps its whole chunk allocated.
+
+    Scopes nest; only the innermost scope of the current thread is used. They
+    must be destroyed in the reverse order of their creation, on the thread
+    that created them. Blocks larger than a quarter of the chunk size are
+    still allocated with \c malloc().
+
+    While no scope exists on any thread, allocating and freeing container
+    data costs no more than without arenas.
+*/
+
+/*!
+    \enum QArenaScope::anonymous
+
+    \value DefaultChunkSize The default size of the chunks, 64 KiB.
+*/
+
+Q_CONSTINIT QBasicAtomicInt QArenaScopePrivate::liveScopes = Q_BASIC_ATOMIC_INITIALIZER(0);
+Q_CONSTINIT QBasicAtomicInt QArenaScopePrivate::liveChunks = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+// A chunk holds one reference per live block, plus ChunkBias while a scope
+// allocates from it. The scope counts its blocks without atomics and settles
+// the count when it retires the chunk, after which the chunk belongs to its
+// blocks alone.
+struct QArenaChunk
+{
+    QAtomicInteger<qsizetype> ref;
+    qsizetype size;
+};
+
+namespace {
+constexpr qsizetype ChunkBias = qsizetype(1) << 30;
+constexpr qsizetype MaximumChunkSize = 256 * 1024 * 1024;
+// chunks are aligned to and made of whole granules
+constexpr int GranuleBits = 12;
+constexpr qsizetype GranuleSize = qsizetype(1) << GranuleBits;
+constexpr qsizetype Alignment = alignof(std::max_align_t);
+constexpr qsizetype ChunkHeaderSize = (sizeof(QArenaChunk) + Alignment - 1) & ~(Alignment - 1);
+
+// Precedes each block, so it can find its chunk again
+struct alignas(std::max_align_t) BlockHeader
+{
+    QArenaChunk *chunk;
+    qsizetype size;             // including this header
+};
+
+constexpr qsizetype blockSize(qsizetype size)
+{
+    return (size + qsizetype(sizeof(BlockHeader)) + Alignment - 1) & ~(Alignment - 1);
+}
+
+// Records which granules of the address space belong to chunks, so that a
+// block can be recognized by its address. It is a radix tree over 48-bit
+// addresses whose nodes are never freed, so lookups don't lock; adding
+// nodes is serialized by a mutex. Chunks beyond 48-bit addresses aren't
+// used.
+constexpr int LevelBits = 12;
+constexpr quint64 LevelMask = (quint64(1) << LevelBits) - 1;
+
+struct GranuleLeaf
+{
+    QBasicAtomicInteger<quint8> inChunk[1 << LevelBits];
+};
+
+struct GranuleNode
+{
+    QBasicAtomicPointer<GranuleLeaf> leaves[1 << LevelBits];
+};
+
+Q_CONSTINIT QBasicAtomicPointer<GranuleNode> granuleMap[1 << LevelBits] = {};
+Q_CONSTINIT QBasicMutex granuleMapMutex;
+
+bool markChunk(const void *chunk, qsizetype size, bool inChunk) noexcept
+{
+    const quint64 first = quint64(quintptr(chunk)) >> GranuleBits;
+    const quint64 last = first + (size >> GranuleBits) - 1;
+    if (last >> (3 * LevelBits))
+        return false;
+
+    QMutexLocker locker(&granuleMapMutex);
+    for (quint64 g = first; g <= last; ++g) {
+        auto &nodePointer = granuleMap[g >> (2 * LevelBits)];
+        GranuleNode *node = nodePointer.loadRelaxed();
+        if (!node) {
+            if (!inChunk || !(node = new (std::nothrow) GranuleNode()))
+                return false;
+            nodePointer.storeRelease(node);
+        }
+        auto &leafPointer = node->leaves[(g >> LevelBits) & LevelMask];
+        GranuleLeaf *leaf = leafPointer.loadRelaxed();
+        if (!leaf) {
+            if (!inChunk || !(leaf = new (std::nothrow) GranuleLeaf()))
+                return false;
+            leafPointer.storeRelease(leaf);
+        }
+        leaf->inChunk[g & LevelMask].storeRelease(inChunk);
+    }
+    return true;
+}
+
+// Keeps a few released chunks of the default size, so that creating a scope
+// for each request doesn't have the allocator map fresh pages every time.
+// Only threads that create scopes have one.
+struct ChunkCache
+{
+    enum { MaximumCount = 16 };
+    QArenaChunk *chunks[MaximumCount] = {};
+    int count = 0;
+
+    ChunkCache() noexcept;
+    ~ChunkCache();
+};
+}
+
+Q_CONSTINIT static thread_local QArenaScope *currentArenaScope = nullptr;
+// Points to the thread's cache while it exists. Blocks can still be freed
+// after the cache has been destroyed at thread exit; they see nullptr.
+Q_CONSTINIT static thread_local ChunkCache *chunkCache = nullptr;
+
+static void freeChunk(QArenaChunk *chunk) noexcept
+{
+    markChunk(chunk, chunk->size, false);
+    QArenaScopePrivate::liveChunks.deref();
+    qFreeAligned(chunk);
+}
+
+ChunkCache::ChunkCache() noexcept
+{
+    chunkCache = this;
+}
+
+ChunkCache::~ChunkCache()
+{
+    chunkCache = nullptr;
+    while (count)
+        freeChunk(chunks[--count]);
+}
+
+static void createChunkCache() noexcept
+{
+    static thread_local ChunkCache cache;
+    Q_UNUSED(cache);
+}
+
+// size includes the header
+static QArenaChunk *allocateChunk(qsizetype size) noexcept
+{
+    QArenaChunk *chunk;
+    ChunkCache *cache = chunkCache;
+    if (size == QArenaScope::DefaultChunkSize && cache && cache->count) {
+        chunk = cache->chunks[--cache->count];
+    } else {
+        chunk = static_cast<QArenaChunk *>(qMallocAligned(size_t(size), GranuleSize));
+        if (!chunk)
+            return nullptr;
+        chunk->size = size;
+        QArenaScopePrivate::liveChunks.ref();
+        if (!markChunk(chunk, size, true)) {
+            freeChunk(chunk);
+            return nullptr;
+        }
+    }
+    chunk->ref.storeRelaxed(ChunkBias);
+    return chunk;
+}
+
+static void releaseChunk(QArenaChunk *chunk) noexcept
+{
+    // a thread without a scope would never reuse the chunk
+    ChunkCache *cache = currentArenaScope ? chunkCache : nullptr;
+    if (chunk->size == QArenaScope::DefaultChunkSize && cache
+            && cache->count < ChunkCache::MaximumCount) {
+        cache->chunks[cache->count++] = chunk;
+    } else {
+        freeChunk(chunk);
+    }
+}
+
+static void retireChunk(QArenaChunk *chunk, qsizetype blocks) noexcept
+{
+    if (chunk->ref.fetchAndAddOrdered(blocks - ChunkBias) == ChunkBias - blocks)
+        releaseChunk(chunk);
+}
+
+/*!
+    Creates an arena scope that allocates chunks of \a chunkSize bytes and
+    makes it the current thread's innermost scope. The size is rounded up to
+    a multiple of 4 KiB.
+*/
+QArenaScope::QArenaScope(qsizetype chunkSize)
+    : m_previous(currentArenaScope),
+      m_chunkSize((qBound(GranuleSize, chunkSize, MaximumChunkSize) + GranuleSize - 1)
+                  & ~(GranuleSize - 1))
+{
+    createChunkCache();
+    currentArenaScope = this;
+    QArenaScopePrivate::liveScopes.ref();
+}
+
+/*!
+    Ends this scope. The chunk it was allocating from is released now if all
+    of its blocks have been freed, or otherwise when the last one is.
+*/
+QArenaScope::~QArenaScope()
+{
+    Q_ASSERT_X(currentArenaScope == this, "QArenaScope",
+               "scopes must be destroyed in reverse order, on the thread that created them");
+    // still current, so that a chunk released here goes to the cache
+    if (m_chunk)
+        retireChunk(m_chunk, m_blocksInChunk);
+    currentArenaScope = m_previous;
+    QArenaScopePrivate::liveScopes.deref();
+}
+
+/*!
+    \fn qsizetype QArenaScope::chunkSize() const
+
+    Returns the size of the chunks this scope allocates.
+*/
+
+/*!
+    \fn qsizetype QArenaScope::bytesAllocated() const
+
+    Returns the number of bytes this scope has handed out, including the
+    blocks that have been freed since.
+*/
+
+/*!
+    Returns the current thread's innermost scope, or \nullptr if there is
+    none.
+*/
+QArenaScope *QArenaScope::current() noexcept
+{
+    return currentArenaScope;
+}
+
+bool QArenaScopePrivate::isInChunk(const void *block) noexcept
+{
+    const quint64 g = quint64(quintptr(block)) >> GranuleBits;
+    if (g >> (3 * LevelBits))
+        return false;
+    const GranuleNode *node = granuleMap[g >> (2 * LevelBits)].loadAcquire();
+    if (!node)
+        return false;
+    const GranuleLeaf *leaf = node->leaves[(g >> LevelBits) & LevelMask].loadAcquire();
+    return leaf && leaf->inChunk[g & LevelMask].loadAcquire();
+}
+
+void *QArenaScopePrivate::allocateFromScope(qsizetype size) noexcept
+{
+    QArenaScope *scope = currentArenaScope;
+    if (Q_LIKELY(!scope))
+        return nullptr;
+
+    // large blocks would waste most of a chunk
+    if (size > scope->m_chunkSize / 4)
+        return nullptr;
+    size = blockSize(size);
+
+    if (scope->m_end - scope->m_ptr < size) {
+        QArenaChunk *chunk = allocateChunk(scope->m_chunkSize);
+        if (!chunk)
+            return nullptr;
+        if (scope->m_chunk)
+            retireChunk(scope->m_chunk, scope->m_blocksInChunk);
+        scope->m_chunk = chunk;
+        scope->m_blocksInChunk = 0;
+        scope->m_ptr = reinterpret_cast<char *>(chunk) + ChunkHeaderSize;
+        scope->m_end = reinterpret_cast<char *>(chunk) + scope->m_chunkSize;
+    }
+
+    auto header = reinterpret_cast<BlockHeader *>(scope->m_ptr);
+    header->chunk = scope->m_chunk;
+    header->size = size;
+    scope->m_ptr += size;
+    scope->m_bytesAllocated += size;
+    ++scope->m_blocksInChunk;
+    return header + 1;
+}
+
+bool QArenaScopePrivate::resize(void *block, qsizetype size) noexcept
+{
+    auto header = static_cast<BlockHeader *>(block) - 1;
+    auto start = reinterpret_cast<char *>(header);
+    QArenaScope *scope = currentArenaScope;
+    if (!scope || header->chunk != scope->m_chunk || start + header->size != scope->m_ptr)
+        return false;           // not the block this thread allocated last
+
+    if (size > scope->m_end - start - qsizetype(sizeof(BlockHeader)))
+        return false;
+    size = blockSize(size);
+    if (size > header->size)
+        scope->m_bytesAllocated += size - header->size;
+    header->size = size;
+    scope->m_ptr = start + size;
+    return true;
+}
+
+void QArenaScopePrivate::deallocate(void *block) noexcept
+{
+    auto header = static_cast<BlockHeader *>(block) - 1;
+    QArenaChunk *chunk = header->chunk;
+    QArenaScope *scope = currentArenaScope;
+    if (scope && chunk == scope->m_chunk) {
+        // This thread is still allocating from the chunk, so it can settle
+        // the block without atomics. The space is handed out again if it was
+        // the last block allocated, or if the chunk is now empty.
+        --scope->m_blocksInChunk;
+        auto start = reinterpret_cast<char *>(header);
+        if (start + header->size == scope->m_ptr)
+            scope->m_ptr = start;
+        if (scope->m_blocksInChunk == 0 && chunk->ref.loadAcquire() == ChunkBias)
+            scope->m_ptr = reinterpret_cast<char *>(chunk) + ChunkHeaderSize;
+        return;
+    }
+
+    if (!chunk->ref.deref())
+        releaseChunk(chunk);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QARENASCOPE_P_H
+#define QARENASCOPE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qarenascope.h>
+#include <QtCore/qbasicatomic.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QArenaScopePrivate
+{
+    // Returns a block of at least size bytes, aligned like malloc(), from the
+    // current thread's innermost QArenaScope. Returns nullptr if there is no
+    // scope or if the block is too large to be worth taking from the arena.
+    static void *allocate(qsizetype size) noexcept
+    {
+        // spare threads without a scope the thread_local lookup
+        return liveScopes.loadRelaxed() ? allocateFromScope(size) : nullptr;
+    }
+
+    // Returns true if the block lies in an arena chunk. This looks at the
+    // address only: QArrayData's flags are copied wholesale by inline code
+    // compiled into existing binaries, so they can't tell.
+    static bool owns(const void *block) noexcept
+    {
+        return liveChunks.loadRelaxed() && isInChunk(block);
+    }
+
+    // Resizes the block in place, if it is the last one the current thread
+    // allocated and the chunk has room
+    static bool resize(void *block, qsizetype size) noexcept;
+
+    // Releases a block returned by allocate(), from any thread
+    static void deallocate(void *block) noexcept;
+
+    static QBasicAtomicInt liveScopes;
+    static QBasicAtomicInt liveChunks;
+
+private:
+    static void *allocateFromScope(qsizetype size) noexcept;
+    static bool isInChunk(const void *block) noexcept;
+};
+
+QT_END_NAMESPACE
+
+#endif // QARENASCOPE_P_H
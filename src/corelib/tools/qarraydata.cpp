@@ -46,6 +46,10 @@
 #include <QtCore/qbytearray.h>  // QBA::value_type
 #include <QtCore/qstring.h>  // QString::value_type
 
+#ifndef QT_BOOTSTRAPPED
+#include <QtCore/private/qarenascope_p.h>
+#endif
+
 #include <stdlib.h>
 
 QT_BEGIN_NAMESPACE
@@ -175,7 +179,14 @@ static inline qsizetype calculateBlockSize(qsizetype &capacity, qsizetype object
 
 static QArrayData *allocateData(qsizetype allocSize)
 {
-    QArrayData *header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    void *block = nullptr;
+#ifndef QT_BOOTSTRAPPED
+    block = QArenaScopePrivate::allocate(allocSize);
+    if (!block)
+#endif
+        block = ::malloc(size_t(allocSize));
+
+    QArrayData *header = static_cast<QArrayData *>(block);
     if (header) {
         header->ref_.storeRelaxed(1);
         header->flags = {};
@@ -184,6 +195,15 @@ static QArrayData *allocateData(qsizetype allocSize)
     return header;
 }
 
+static void deallocateData(QArrayData *data)
+{
+#ifndef QT_BOOTSTRAPPED
+    if (data && QArenaScopePrivate::owns(data))
+        return QArenaScopePrivate::deallocate(data);
+#endif
+    ::free(data);
+}
+
 
 namespace {
 // QArrayData with strictest alignment requirements supported by malloc()
@@ -257,7 +277,27 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
     if (Q_UNLIKELY(allocSize < 0))  // handle overflow. cannot reallocate reliably
         return qMakePair(data, dataPointer);
 
-    QArrayData *header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    QArrayData *header = nullptr;
+#ifndef QT_BOOTSTRAPPED
+    const bool inArena = data && QArenaScopePrivate::owns(data);
+    if (inArena && QArenaScopePrivate::resize(data, allocSize)) {
+        header = data;
+    } else if (inArena) {
+        // move the contents to a new block
+        header = allocateData(allocSize);
+        if (header) {
+            const qsizetype oldSize = reserveExtraBytes(headerSize + data->alloc * objectSize);
+            memcpy(reinterpret_cast<char *>(header) + sizeof(QArrayData),
+                   reinterpret_cast<char *>(data) + sizeof(QArrayData),
+                   qMin(oldSize, allocSize) - sizeof(QArrayData));
+            header->flags = data->flags;
+            deallocateData(data);
+        }
+    } else
+#endif
+    {
+        header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    }
     if (header) {
         header->alloc = capacity;
         dataPointer = reinterpret_cast<char *>(header) + offset;
@@ -276,7 +316,7 @@ void QArrayData::deallocate(QArrayData *data, qsizetype objectSize,
     Q_UNUSED(objectSize);
     Q_UNUSED(alignment);
 
-    ::free(data);
+    deallocateData(data);
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,287 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTHASH_H
+#define QCONCURRENTHASH_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <limits>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+template <typename Key, typename T>
+class QConcurrentHash
+{
+    // each shard on a cache line of its own, so that threads reading
+    // different shards don't contend on the lock word
+    struct alignas(64) Shard
+    {
+        mutable QReadWriteLock lock;
+        QHash<Key, T> hash;
+    };
+
+    std::unique_ptr<Shard[]> m_shards;
+    uint m_shardBits;
+    size_t m_seed = QHashSeed::globalSeed();
+
+    Shard &shardFor(const Key &key) const noexcept
+    {
+        // QHash picks buckets with the low bits of the hash; use the high ones
+        const size_t hash = QHashPrivate::calculateHash(key, m_seed);
+        const uint shift = std::numeric_limits<size_t>::digits - m_shardBits;
+        return m_shards[m_shardBits ? hash >> shift : 0];
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    enum { DefaultShardCount = 64 };
+
+    class Snapshot
+    {
+        friend class QConcurrentHash;
+        QVarLengthArray<QHash<Key, T>, DefaultShardCount> m_shards;
+
+    public:
+        class const_iterator
+        {
+            friend class Snapshot;
+            using ShardIterator = typename QHash<Key, T>::const_iterator;
+
+            const Snapshot *s = nullptr;
+            qsizetype shard = 0;
+            ShardIterator it;
+
+            const_iterator(const Snapshot *snapshot, qsizetype index) noexcept
+                : s(snapshot), shard(index)
+            {
+                if (shard < s->m_shards.size())
+                    it = s->m_shards.at(shard).constBegin();
+                skipExhausted();
+            }
+            bool atEnd() const noexcept { return !s || shard == s->m_shards.size(); }
+            void skipExhausted() noexcept
+            {
+                while (shard < s->m_shards.size() && it == s->m_shards.at(shard).constEnd()) {
+                    if (++shard < s->m_shards.size())
+                        it = s->m_shards.at(shard).constBegin();
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = qptrdiff;
+            using value_type = T;
+            using pointer = const T *;
+            using reference = const T &;
+
+            const_iterator() noexcept = default;
+
+            const Key &key() const noexcept { return it.key(); }
+            const T &value() const noexcept { return it.value(); }
+            const T &operator*() const noexcept { return it.value(); }
+            const T *operator->() const noexcept { return &it.value(); }
+
+            const_iterator &operator++() noexcept
+            {
+                ++it;
+                skipExhausted();
+                return *this;
+            }
+            const_iterator operator++(int) noexcept
+            {
+                const_iterator r = *this;
+                ++*this;
+                return r;
+            }
+
+            friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) noexcept
+            { return lhs.shard == rhs.shard && (lhs.atEnd() || lhs.it == rhs.it); }
+            friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) noexcept
+            { return !(lhs == rhs); }
+        };
+        using iterator = const_iterator;
+
+        qsizetype size() const noexcept
+        {
+            qsizetype n = 0;
+            for (const auto &shard : m_shards)
+                n += shard.size();
+            return n;
+        }
+        qsizetype count() const noexcept { return size(); }
+        bool isEmpty() const noexcept { return size() == 0; }
+
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator constBegin() const noexcept { return begin(); }
+        const_iterator end() const noexcept { return const_iterator(this, m_shards.size()); }
+        const_iterator cend() const noexcept { return end(); }
+        const_iterator constEnd() const noexcept { return end(); }
+
+        QHash<Key, T> toHash() const
+        {
+            QHash<Key, T> result;
+            result.reserve(size());
+            for (const auto &shard : m_shards) {
+                for (auto it = shard.cbegin(), end = shard.cend(); it != end; ++it)
+                    result.insert(it.key(), it.value());
+            }
+            return result;
+        }
+    };
+
+    explicit QConcurrentHash(qsizetype shardCount = DefaultShardCount)
+        : m_shardBits(0)
+    {
+        Q_ASSERT(shardCount > 0);
+        while ((qsizetype(1) << m_shardBits) < shardCount)
+            ++m_shardBits;
+        m_shards.reset(new Shard[size_t(1) << m_shardBits]);
+    }
+
+    qsizetype shardCount() const noexcept { return qsizetype(1) << m_shardBits; }
+
+    qsizetype size() const
+    {
+        qsizetype n = 0;
+        for (qsizetype i = 0; i < shardCount(); ++i) {
+            QReadLocker locker(&m_shards[i].lock);
+            n += m_shards[i].hash.size();
+        }
+        return n;
+    }
+    qsizetype count() const { return size(); }
+    bool isEmpty() const { return size() == 0; }
+
+    bool contains(const Key &key) const
+    {
+        const Shard &shard = shardFor(key);
+        QReadLocker locker(&shard.lock);
+        return shard.hash.contains(key);
+    }
+
+    T value(const Key &key) const
+    {
+        const Shard &shard = shardFor(key);
+        QReadLocker locker(&shard.lock);
+        return shard.hash.value(key);
+    }
+    T value(const Key &key, const T &defaultValue) const
+    {
+        const Shard &shard = shardFor(key);
+        QReadLocker locker(&shard.lock);
+        return shard.hash.value(key, defaultValue);
+    }
+
+    bool insert(const Key &key, const T &value)
+    {
+        Shard &shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        const qsizetype oldSize = shard.hash.size();
+        shard.hash.insert(key, value);
+        return shard.hash.size() != oldSize;
+    }
+
+    bool tryInsert(const Key &key, const T &value)
+    {
+        Shard &shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        if (shard.hash.contains(key))
+            return false;
+        shard.hash.insert(key, value);
+        return true;
+    }
+
+    template <typename Function>
+    void update(const Key &key, Function function)
+    {
+        Shard &shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        function(shard.hash[key]);
+    }
+
+    bool remove(const Key &key)
+    {
+        Shard &shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        return shard.hash.remove(key);
+    }
+
+    T take(const Key &key)
+    {
+        Shard &shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        return shard.hash.take(key);
+    }
+
+    void clear()
+    {
+        for (qsizetype i = 0; i < shardCount(); ++i) {
+            // release the old contents outside of the lock
+            QHash<Key, T> old;
+            QWriteLocker locker(&m_shards[i].lock);
+            old.swap(m_shards[i].hash);
+        }
+    }
+
+    Snapshot snapshot() const
+    {
+        Snapshot result;
+        result.m_shards.reserve(shardCount());
+        for (qsizetype i = 0; i < shardCount(); ++i) {
+            QReadLocker locker(&m_shards[i].lock);
+            result.m_shards.append(m_shards[i].hash);
+        }
+        return result;
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentHash)
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTHASH_H
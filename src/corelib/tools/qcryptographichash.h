@@ -43,6 +43,7 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qbytearraylist.h>
 #include <QtCore/qobjectdefs.h>
 
 QT_BEGIN_NAMESPACE
@@ -50,6 +51,9 @@ QT_BEGIN_NAMESPACE
 
 class QCryptographicHashPrivate;
 class QIODevice;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 class Q_CORE_EXPORT QCryptographicHash
 {
@@ -121,6 +125,11 @@ public:
     static QByteArray hash(const QByteArray &data, Algorithm method);
 #endif
     static QByteArray hash(QByteArrayView data, Algorithm method);
+    static QByteArrayList hashMany(const QList<QByteArrayView> &data, Algorithm method);
+    static QByteArrayList hash(QIODevice *device, const QList<Algorithm> &methods);
+#if QT_CONFIG(future)
+    static QFuture<QByteArrayList> hashFile(const QString &fileName, const QList<Algorithm> &methods);
+#endif
     static int hashLength(Algorithm method);
 private:
     Q_DISABLE_COPY(QCryptographicHash)
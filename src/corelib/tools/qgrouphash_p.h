@@ -0,0 +1,546 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGROUPHASH_P_H
+#define QGROUPHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qhash.h"
+#include "private/qglobal_p.h"
+#include "private/qsimd_p.h"
+
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QGroupHash is an open addressing hash table in the style of SwissTable.
+
+  Next to the slots there is an array with one control byte per slot. A
+  control byte is Empty, Deleted or, for a used slot, the lowest 7 bits of
+  the key's hash. The remaining hash bits pick a group of 16 slots to start
+  probing from; the control bytes of a whole group are compared against the
+  7 hash bits at once (with SSE2 or NEON when available), so the keys are
+  only compared for slots that very likely match. A lookup stops at the
+  first group that has an Empty slot.
+
+  Unlike QHash, QGroupHash is not implicitly shared, and inserting or
+  removing elements invalidates all iterators. It uses qHash() and the
+  global seed the same way QHash does.
+*/
+
+namespace QGroupHashPrivate {
+
+enum : qint8 {
+    Empty = -128,
+    Deleted = -2,
+};
+
+constexpr size_t GroupWidth = 16;
+
+struct MatchMask
+{
+#if defined(__SSE2__) || !defined(__ARM_NEON__)
+    using Bits = uint;
+    static constexpr uint Shift = 0;  // one bit per slot
+#else
+    using Bits = quint64;
+    static constexpr uint Shift = 2;  // one bit in each nibble of the narrowed comparison
+#endif
+    Bits bits;
+
+    explicit operator bool() const noexcept { return bits != 0; }
+    uint lowest() const noexcept { return qCountTrailingZeroBits(bits) >> Shift; }
+    void removeLowest() noexcept { bits &= bits - 1; }
+};
+
+struct Group
+{
+#if defined(__SSE2__)
+    __m128i ctrl;
+
+    explicit Group(const qint8 *p) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+
+    MatchMask match(qint8 h2) const noexcept
+    { return { uint(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)))) }; }
+    MatchMask matchEmptyOrDeleted() const noexcept
+    { return { uint(_mm_movemask_epi8(ctrl)) }; }
+#elif defined(__ARM_NEON__)
+    int8x16_t ctrl;
+
+    explicit Group(const qint8 *p) noexcept : ctrl(vld1q_s8(p)) {}
+
+    static MatchMask toMask(uint8x16_t cmp) noexcept
+    {
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+        return { vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & Q_UINT64_C(0x8888888888888888) };
+    }
+    MatchMask match(qint8 h2) const noexcept
+    { return toMask(vceqq_s8(ctrl, vdupq_n_s8(h2))); }
+    MatchMask matchEmptyOrDeleted() const noexcept
+    { return toMask(vcltq_s8(ctrl, vdupq_n_s8(0))); }
+#else
+    const qint8 *ctrl;
+
+    explicit Group(const qint8 *p) noexcept : ctrl(p) {}
+
+    MatchMask match(qint8 h2) const noexcept
+    {
+        uint bits = 0;
+        for (size_t i = 0; i < GroupWidth; ++i)
+            bits |= uint(ctrl[i] == h2) << i;
+        return { bits };
+    }
+    MatchMask matchEmptyOrDeleted() const noexcept
+    {
+        uint bits = 0;
+        for (size_t i = 0; i < GroupWidth; ++i)
+            bits |= uint(ctrl[i] < 0) << i;
+        return { bits };
+    }
+#endif
+    MatchMask matchEmpty() const noexcept { return match(Empty); }
+};
+
+// visits every group exactly once, as the number of groups is a power of two
+struct ProbeSequence
+{
+    size_t group;
+    size_t mask;
+    size_t step = 0;
+
+    ProbeSequence(size_t hash, size_t capacity) noexcept
+        : group((hash >> 7) & (capacity / GroupWidth - 1)), mask(capacity / GroupWidth - 1)
+    {}
+
+    size_t offset() const noexcept { return group * GroupWidth; }
+    void next() noexcept
+    {
+        ++step;
+        group = (group + step) & mask;
+    }
+};
+
+inline qint8 h2(size_t hash) noexcept { return qint8(hash & 0x7f); }
+
+// the table is kept at most 7/8 full
+constexpr size_t maximumLoad(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+inline size_t capacityForSize(size_t size) noexcept
+{
+    size_t capacity = GroupWidth;
+    while (maximumLoad(capacity) < size)
+        capacity *= 2;
+    return capacity;
+}
+
+} // namespace QGroupHashPrivate
+
+template <typename Key, typename T>
+class QGroupHash
+{
+    struct Node
+    {
+        Key key;
+        T value;
+    };
+    static_assert(alignof(Node) <= alignof(std::max_align_t));
+
+    static constexpr size_t npos = ~size_t(0);
+
+    qint8 *m_ctrl = nullptr;
+    Node *m_slots = nullptr;
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+    size_t m_growthLeft = 0;
+    size_t m_seed = QHashSeed::globalSeed();
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    template <bool Const>
+    class Iterator
+    {
+        friend class QGroupHash;
+        using Table = std::conditional_t<Const, const QGroupHash, QGroupHash>;
+
+        Table *t = nullptr;
+        size_t i = 0;
+
+        Iterator(Table *table, size_t index) noexcept : t(table), i(index) {}
+        void skipUnused() noexcept
+        {
+            while (i < t->m_capacity && t->m_ctrl[i] < 0)
+                ++i;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        Iterator() noexcept = default;
+        template <bool C = Const, std::enable_if_t<C, bool> = true>
+        Iterator(const Iterator<false> &other) noexcept : t(other.t), i(other.i) {}
+
+        const Key &key() const noexcept { return t->m_slots[i].key; }
+        reference value() const noexcept { return t->m_slots[i].value; }
+        reference operator*() const noexcept { return value(); }
+        pointer operator->() const noexcept { return &value(); }
+
+        Iterator &operator++() noexcept
+        {
+            ++i;
+            skipUnused();
+            return *this;
+        }
+        Iterator operator++(int) noexcept
+        {
+            Iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        friend bool operator==(const Iterator &lhs, const Iterator &rhs) noexcept
+        { return lhs.i == rhs.i; }
+        friend bool operator!=(const Iterator &lhs, const Iterator &rhs) noexcept
+        { return lhs.i != rhs.i; }
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    QGroupHash() noexcept = default;
+    QGroupHash(std::initializer_list<std::pair<Key, T>> list)
+    {
+        reserve(qsizetype(list.size()));
+        for (const auto &entry : list)
+            insert(entry.first, entry.second);
+    }
+    QGroupHash(const QGroupHash &other)
+        : m_size(other.m_size), m_growthLeft(other.m_growthLeft), m_seed(other.m_seed)
+    {
+        if (!other.m_capacity)
+            return;
+        allocate(other.m_capacity);
+        memcpy(m_ctrl, other.m_ctrl, m_capacity);
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0)
+                new (m_slots + i) Node(other.m_slots[i]);
+        }
+    }
+    QGroupHash(QGroupHash &&other) noexcept
+        : m_ctrl(std::exchange(other.m_ctrl, nullptr)),
+          m_slots(std::exchange(other.m_slots, nullptr)),
+          m_capacity(std::exchange(other.m_capacity, 0)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_growthLeft(std::exchange(other.m_growthLeft, 0)),
+          m_seed(other.m_seed)
+    {}
+    QGroupHash &operator=(const QGroupHash &other)
+    {
+        QGroupHash copy(other);
+        swap(copy);
+        return *this;
+    }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QGroupHash)
+    ~QGroupHash()
+    {
+        destroyAll();
+        ::operator delete(m_ctrl);
+    }
+
+    void swap(QGroupHash &other) noexcept
+    {
+        qSwap(m_ctrl, other.m_ctrl);
+        qSwap(m_slots, other.m_slots);
+        qSwap(m_capacity, other.m_capacity);
+        qSwap(m_size, other.m_size);
+        qSwap(m_growthLeft, other.m_growthLeft);
+        qSwap(m_seed, other.m_seed);
+    }
+
+    qsizetype size() const noexcept { return qsizetype(m_size); }
+    qsizetype count() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return m_size == 0; }
+    qsizetype capacity() const noexcept { return qsizetype(QGroupHashPrivate::maximumLoad(m_capacity)); }
+
+    void reserve(qsizetype size)
+    {
+        if (size > capacity())
+            rehash(QGroupHashPrivate::capacityForSize(size_t(size)));
+    }
+
+    void clear() noexcept
+    {
+        if (!m_size)
+            return;
+        destroyAll();
+        memset(m_ctrl, QGroupHashPrivate::Empty, m_capacity);
+        m_size = 0;
+        m_growthLeft = QGroupHashPrivate::maximumLoad(m_capacity);
+    }
+
+    bool contains(const Key &key) const noexcept { return findIndex(key) != npos; }
+
+    T value(const Key &key) const noexcept
+    {
+        const size_t i = findIndex(key);
+        return i == npos ? T() : m_slots[i].value;
+    }
+    T value(const Key &key, const T &defaultValue) const noexcept
+    {
+        const size_t i = findIndex(key);
+        return i == npos ? defaultValue : m_slots[i].value;
+    }
+
+    T &operator[](const Key &key)
+    {
+        // tryEmplace() may rehash, so don't read m_slots before it returns
+        const size_t i = tryEmplace(key).first;
+        return m_slots[i].value;
+    }
+    const T operator[](const Key &key) const noexcept { return value(key); }
+
+    iterator insert(const Key &key, const T &value) { return emplace(key, value); }
+    iterator insert(const Key &key, T &&value) { return emplace(key, std::move(value)); }
+
+    template <typename... Args>
+    iterator emplace(const Key &key, Args &&...args)
+    {
+        const auto result = tryEmplace(key, std::forward<Args>(args)...);
+        if (!result.second)
+            m_slots[result.first].value = T(std::forward<Args>(args)...);
+        return iterator(this, result.first);
+    }
+
+    bool remove(const Key &key)
+    {
+        const size_t i = findIndex(key);
+        if (i == npos)
+            return false;
+        eraseAt(i);
+        return true;
+    }
+
+    T take(const Key &key)
+    {
+        const size_t i = findIndex(key);
+        if (i == npos)
+            return T();
+        T value = std::move(m_slots[i].value);
+        eraseAt(i);
+        return value;
+    }
+
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it != constEnd());
+        eraseAt(it.i);
+        iterator next(this, it.i);
+        next.skipUnused();
+        return next;
+    }
+
+    iterator find(const Key &key) noexcept
+    {
+        const size_t i = findIndex(key);
+        return i == npos ? end() : iterator(this, i);
+    }
+    const_iterator find(const Key &key) const noexcept { return constFind(key); }
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        const size_t i = findIndex(key);
+        return i == npos ? constEnd() : const_iterator(this, i);
+    }
+
+    iterator begin() noexcept
+    {
+        iterator it(this, 0);
+        it.skipUnused();
+        return it;
+    }
+    const_iterator begin() const noexcept { return constBegin(); }
+    const_iterator cbegin() const noexcept { return constBegin(); }
+    const_iterator constBegin() const noexcept
+    {
+        const_iterator it(this, 0);
+        it.skipUnused();
+        return it;
+    }
+    iterator end() noexcept { return iterator(this, m_capacity); }
+    const_iterator end() const noexcept { return constEnd(); }
+    const_iterator cend() const noexcept { return constEnd(); }
+    const_iterator constEnd() const noexcept { return const_iterator(this, m_capacity); }
+
+private:
+    void allocate(size_t capacity)
+    {
+        // one allocation: the control bytes, then the slots
+        m_ctrl = static_cast<qint8 *>(::operator new(capacity * (1 + sizeof(Node))));
+        m_slots = reinterpret_cast<Node *>(m_ctrl + capacity);
+        m_capacity = capacity;
+        memset(m_ctrl, QGroupHashPrivate::Empty, capacity);
+    }
+
+    void destroyAll() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<Node>) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (m_ctrl[i] >= 0)
+                    m_slots[i].~Node();
+            }
+        }
+    }
+
+    size_t findIndex(const Key &key) const noexcept
+    {
+        if (!m_size)
+            return npos;
+        return findIndex(key, QHashPrivate::calculateHash(key, m_seed));
+    }
+
+    size_t findIndex(const Key &key, size_t hash) const noexcept
+    {
+        using namespace QGroupHashPrivate;
+        const qint8 tag = h2(hash);
+        for (ProbeSequence seq(hash, m_capacity); ; seq.next()) {
+            const Group group(m_ctrl + seq.offset());
+            for (MatchMask mask = group.match(tag); mask; mask.removeLowest()) {
+                const size_t i = seq.offset() + mask.lowest();
+                if (m_slots[i].key == key)
+                    return i;
+            }
+            if (group.matchEmpty())
+                return npos;
+        }
+    }
+
+    size_t findInsertIndex(size_t hash) const noexcept
+    {
+        using namespace QGroupHashPrivate;
+        for (ProbeSequence seq(hash, m_capacity); ; seq.next()) {
+            if (const MatchMask mask = Group(m_ctrl + seq.offset()).matchEmptyOrDeleted())
+                return seq.offset() + mask.lowest();
+        }
+    }
+
+    template <typename... Args>
+    std::pair<size_t, bool> tryEmplace(const Key &key, Args &&...args)
+    {
+        using namespace QGroupHashPrivate;
+        const size_t hash = QHashPrivate::calculateHash(key, m_seed);
+        if (m_size) {
+            const size_t i = findIndex(key, hash);
+            if (i != npos)
+                return { i, false };
+        }
+
+        size_t i = m_capacity ? findInsertIndex(hash) : npos;
+        if (i == npos || (m_growthLeft == 0 && m_ctrl[i] == Empty)) {
+            // if enough of the used slots are tombstones, there is no need to grow
+            const size_t live = m_size + 1;
+            rehash(m_capacity && live <= m_capacity * 25 / 32
+                   ? m_capacity : capacityForSize(qMax(live, m_capacity)));
+            i = findInsertIndex(hash);
+        }
+        new (m_slots + i) Node{ key, T(std::forward<Args>(args)...) };
+        if (m_ctrl[i] == Empty)
+            --m_growthLeft;
+        m_ctrl[i] = h2(hash);
+        ++m_size;
+        return { i, true };
+    }
+
+    void eraseAt(size_t i) noexcept
+    {
+        using namespace QGroupHashPrivate;
+        m_slots[i].~Node();
+        --m_size;
+        // a lookup stops at a group with an Empty slot, so no probe sequence
+        // continues past this group and the slot doesn't need a tombstone
+        if (Group(m_ctrl + (i & ~(GroupWidth - 1))).matchEmpty()) {
+            m_ctrl[i] = Empty;
+            ++m_growthLeft;
+        } else {
+            m_ctrl[i] = Deleted;
+        }
+    }
+
+    void rehash(size_t capacity)
+    {
+        using namespace QGroupHashPrivate;
+        qint8 *oldCtrl = m_ctrl;
+        Node *oldSlots = m_slots;
+        const size_t oldCapacity = m_capacity;
+
+        allocate(capacity);
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] < 0)
+                continue;
+            const size_t hash = QHashPrivate::calculateHash(oldSlots[i].key, m_seed);
+            const size_t j = findInsertIndex(hash);
+            new (m_slots + j) Node(std::move(oldSlots[i]));
+            oldSlots[i].~Node();
+            m_ctrl[j] = h2(hash);
+        }
+        m_growthLeft = maximumLoad(m_capacity) - m_size;
+        ::operator delete(oldCtrl);
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QGROUPHASH_P_H
@@ -144,6 +144,41 @@ ci.ifa_prefered = ci.ifa_valid = 0;
 }
 ")
 
+# sendmmsg
+qt_config_compile_test(sendmmsg
+    LABEL "sendmmsg() and recvmmsg()"
+    CODE
+"#include <sys/types.h>
+#include <sys/socket.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct mmsghdr msgs[2] = {};
+(void) sendmmsg(-1, msgs, 2, 0);
+(void) recvmmsg(-1, msgs, 2, MSG_DONTWAIT, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
+# sendfile
+qt_config_compile_test(sendfile
+    LABEL "sendfile()"
+    CODE
+"#include <sys/types.h>
+#include <sys/sendfile.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+off_t offset = 0;
+(void) sendfile(-1, -1, &offset, 4096);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # sctp
 qt_config_compile_test(sctp
     LABEL "SCTP support"
@@ -307,6 +342,14 @@ qt_feature("opensslv11" PUBLIC
     LABEL "OpenSSL 1.1"
     CONDITION QT_FEATURE_openssl
 )
+qt_feature("sendmmsg" PRIVATE
+    LABEL "sendmmsg()/recvmmsg()"
+    CONDITION UNIX AND TEST_sendmmsg
+)
+qt_feature("sendfile" PRIVATE
+    LABEL "sendfile()"
+    CONDITION LINUX AND TEST_sendfile
+)
 qt_feature("sctp" PUBLIC
     LABEL "SCTP"
     AUTODETECT OFF
@@ -468,8 +468,13 @@
 #include "qabstractsocket_p.h"
 
 #include "private/qhostinfo_p.h"
+#if QT_CONFIG(sendfile)
+#include "private/qnativesocketengine_p.h"
+#include "private/qcore_unix_p.h"
+#endif
 
 #include <qabstracteventdispatcher.h>
+#include <qfile.h>
 #include <qhostaddress.h>
 #include <qhostinfo.h>
 #include <qmetaobject.h>
@@ -533,6 +538,10 @@ QAbstractSocketPrivate::QAbstractSocketPrivate()
 */
 QAbstractSocketPrivate::~QAbstractSocketPrivate()
 {
+#if QT_CONFIG(sendfile)
+    discardPendingFiles();
+#endif
+    discardStreamedFiles();
 }
 
 /*! \internal
@@ -546,6 +555,9 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+#if QT_CONFIG(sendfile)
+    discardPendingFiles();
+#endif
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -772,7 +784,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (!hasPendingWrites()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -790,11 +802,32 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    qint64 written;
+#if QT_CONFIG(sendfile)
+    if (!pendingFiles.isEmpty() && pendingFiles.constFirst().bufferedBefore == 0) {
+        written = writePendingFile();
+    } else
+#endif
+    {
+        qint64 nextSize = writeBuffer.nextDataBlockSize();
+#if QT_CONFIG(sendfile)
+        // Don't write past the point where the next file range starts.
+        if (!pendingFiles.isEmpty())
+            nextSize = qMin(nextSize, pendingFiles.constFirst().bufferedBefore);
+#endif
+        const char *ptr = writeBuffer.readPointer();
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+        // Attempt to write it all in one chunk.
+        written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+        if (written > 0) {
+            // Remove what we wrote so far.
+            writeBuffer.free(written);
+#if QT_CONFIG(sendfile)
+            for (PendingFile &file : pendingFiles)
+                file.bufferedBefore -= written;
+#endif
+        }
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -811,15 +844,11 @@ bool QAbstractSocketPrivate::writeToSocket()
            written);
 #endif
 
-    if (written > 0) {
-        // Remove what we wrote so far.
-        writeBuffer.free(written);
-
-        // Emit notifications.
+    // Emit notifications.
+    if (written > 0)
         emitBytesWritten(written);
-    }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -837,12 +866,199 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while (hasPendingWrites() && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
 }
 
+/*! \internal
+
+    Queues \a size bytes of \a file, starting at \a offset, for sending
+    after the data already in the write buffer. On a plain socket using the
+    native socket engine the range is transferred with sendfile(); otherwise
+    the data is read from \a file in chunks as the socket drains, see
+    writeStreamedFiles().
+*/
+bool QAbstractSocketPrivate::sendFile(QFile *file, qint64 offset, qint64 size)
+{
+    Q_Q(QAbstractSocket);
+    if (!q->isWritable()) {
+        qWarning("QTcpSocket::sendFile: socket not open for writing");
+        return false;
+    }
+    if (!file || !file->isReadable() || file->isSequential()) {
+        qWarning("QTcpSocket::sendFile: file must be an open, random-access file");
+        return false;
+    }
+    const qint64 fileSize = file->size();
+    if (offset < 0 || offset > fileSize) {
+        qWarning("QTcpSocket::sendFile: offset %lld is outside of the file", offset);
+        return false;
+    }
+    if (size < 0 || size > fileSize - offset)
+        size = fileSize - offset;
+    if (size == 0)
+        return true;
+
+    // make sure the range we send reflects what was written through this QFile
+    if (file->isWritable())
+        file->flush();
+
+#if QT_CONFIG(sendfile)
+    const int fd = file->handle();
+    if (fd != -1 && streamedFiles.isEmpty() && qobject_cast<QNativeSocketEngine *>(socketEngine)) {
+        // keep our own descriptor, so the caller may close the file right away
+        const int dupFd = qt_safe_dup(fd);
+        if (dupFd != -1) {
+            pendingFiles.append({ dupFd, offset, size, writeBuffer.size() });
+            pendingFileBytes += size;
+            socketEngine->setWriteNotificationEnabled(true);
+            return true;
+        }
+    }
+#endif
+
+    // Fallback for encrypted and proxied sockets, and for files without a
+    // native descriptor (e.g. resources). Read through our own QFile when
+    // possible, so the caller may close theirs right away.
+    StreamedFile streamed = { file, false, offset, size, QByteArray() };
+    if (!file->fileName().isEmpty()) {
+        QFile *ownFile = new QFile(file->fileName());
+        if (ownFile->open(QIODevice::ReadOnly)) {
+            streamed.file = ownFile;
+            streamed.ownsFile = true;
+        } else {
+            delete ownFile;
+        }
+    }
+    streamedFiles.append(streamed);
+    streamedFileBytes += size;
+    writeStreamedFiles();
+    return true;
+}
+
+/*! \internal
+
+    Appends \a size bytes of \a data, written while sendFile() ranges are
+    still being streamed, to the last range, so they are sent after it.
+    Returns \c false if the data can be written right away.
+*/
+bool QAbstractSocketPrivate::holdBackWrite(const char *data, qint64 size)
+{
+    if (streamedFiles.isEmpty() || writingStreamedFiles)
+        return false;
+    streamedFiles.last().after.append(data, size);
+    streamedFileBytes += size;
+    return true;
+}
+
+/*! \internal
+
+    Writes the streamed sendFile() ranges, and the data held back behind
+    them, until about one chunk is buffered. Called again whenever
+    bytesWritten() is emitted, so a range is never copied into memory at
+    once.
+*/
+void QAbstractSocketPrivate::writeStreamedFiles()
+{
+    Q_Q(QAbstractSocket);
+    if (writingStreamedFiles)
+        return;
+    QScopedValueRollback<bool> guard(writingStreamedFiles, true);
+
+    while (!streamedFiles.isEmpty()
+           && q->bytesToWrite() - streamedFileBytes < QABSTRACTSOCKET_BUFFERSIZE) {
+        StreamedFile &streamed = streamedFiles.first();
+        QByteArray chunk;
+        if (streamed.remaining > 0) {
+            if (streamed.file && streamed.file->seek(streamed.offset))
+                chunk = streamed.file->read(qMin<qint64>(streamed.remaining,
+                                                         QABSTRACTSOCKET_BUFFERSIZE));
+            if (chunk.isEmpty()) {
+                setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                                QAbstractSocket::tr("Unable to read the file being sent"));
+                q->abort();
+                return;
+            }
+            streamed.offset += chunk.size();
+            streamed.remaining -= chunk.size();
+        } else {
+            chunk = std::move(streamed.after);
+            if (streamed.ownsFile)
+                delete streamed.file.data();
+            streamedFiles.removeFirst();
+        }
+        streamedFileBytes -= chunk.size();
+        // QIODevice::write() would refuse after close(), which still
+        // delivers the pending data
+        if (!chunk.isEmpty() && q->writeData(chunk.constData(), chunk.size()) < 0) {
+            discardStreamedFiles();
+            return;
+        }
+    }
+
+    if (streamedFiles.isEmpty()) {
+        QObject::disconnect(streamedFilesConnection);
+    } else if (!streamedFilesConnection) {
+        streamedFilesConnection = QObject::connect(q, &QIODevice::bytesWritten, q,
+                                                   [this] { writeStreamedFiles(); });
+    }
+}
+
+/*! \internal
+
+    Drops the streamed sendFile() ranges and the data held back behind
+    them.
+*/
+void QAbstractSocketPrivate::discardStreamedFiles()
+{
+    for (const StreamedFile &streamed : qAsConst(streamedFiles)) {
+        if (streamed.ownsFile)
+            delete streamed.file.data();
+    }
+    streamedFiles.clear();
+    streamedFileBytes = 0;
+    if (streamedFilesConnection)
+        QObject::disconnect(streamedFilesConnection);
+}
+
+#if QT_CONFIG(sendfile)
+/*! \internal
+
+    Sends as much as possible of the first pending file range. Returns the
+    number of bytes sent, or -1 on error.
+*/
+qint64 QAbstractSocketPrivate::writePendingFile()
+{
+    PendingFile &file = pendingFiles.first();
+    const qint64 written = static_cast<QNativeSocketEngine *>(socketEngine)
+            ->sendFile(file.fd, file.offset, file.remaining);
+    if (written > 0) {
+        file.offset += written;
+        file.remaining -= written;
+        pendingFileBytes -= written;
+        if (file.remaining == 0) {
+            qt_safe_close(file.fd);
+            pendingFiles.removeFirst();
+        }
+    }
+    return written;
+}
+
+/*! \internal
+
+    Drops all file ranges that have not been sent yet.
+*/
+void QAbstractSocketPrivate::discardPendingFiles()
+{
+    for (const PendingFile &file : qAsConst(pendingFiles))
+        qt_safe_close(file.fd);
+    pendingFiles.clear();
+    pendingFileBytes = 0;
+}
+#endif // QT_CONFIG(sendfile)
+
 #ifndef QT_NO_NETWORKPROXY
 /*! \internal
 
@@ -1762,7 +1978,11 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    qint64 pendingBytes = QIODevice::bytesToWrite();
+#if QT_CONFIG(sendfile)
+    pendingBytes += d_func()->pendingFileBytes;
+#endif
+    pendingBytes += d_func()->streamedFileBytes;
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -1889,6 +2109,7 @@ bool QAbstractSocket::setSocketDescriptor(qintptr socketDescriptor, SocketState
     Q_D(QAbstractSocket);
 
     d->resetSocketLayer();
+    d->discardStreamedFiles();
     d->setReadChannelCount(0);
     d->setWriteChannelCount(0);
     d->socketEngine = QAbstractSocketEngine::createSocketEngine(socketDescriptor, this);
@@ -2190,7 +2411,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2242,7 +2463,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (!d->hasPendingWrites())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2259,7 +2480,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  d->hasPendingWrites(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2339,7 +2560,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2376,6 +2597,10 @@ void QAbstractSocket::abort()
     qDebug("QAbstractSocket::abort()");
 #endif
     d->setWriteChannelCount(0);
+#if QT_CONFIG(sendfile)
+    d->discardPendingFiles();
+#endif
+    d->discardStreamedFiles();
     d->abortCalled = true;
     close();
 }
@@ -2457,8 +2682,12 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
         return -1;
     }
 
+    // keep the order of data written after a streamed sendFile() range
+    if (d->holdBackWrite(data, size))
+        return size;
+
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && !d->hasPendingWrites()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2685,7 +2914,7 @@ void QAbstractSocket::disconnectFromHost()
         }
 
         // Wait for pending data to be written.
-        if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
+        if (d->socketEngine && d->socketEngine->isValid() && (d->hasPendingWrites()
             || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
@@ -2702,6 +2931,7 @@ void QAbstractSocket::disconnectFromHost()
 
     SocketState previousState = d->state;
     d->resetSocketLayer();
+    d->discardStreamedFiles();
     d->state = UnconnectedState;
     emit stateChanged(d->state);
     emit readChannelFinished();       // we got an EOF
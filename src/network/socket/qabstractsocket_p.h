@@ -55,6 +55,7 @@
 #include "QtNetwork/qabstractsocket.h"
 #include "QtCore/qbytearray.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qpointer.h"
 #include "QtCore/qtimer.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
@@ -62,6 +63,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QFile;
 class QHostInfo;
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
@@ -131,6 +133,47 @@ public:
     void resetSocketLayer();
     virtual bool flush();
 
+    bool hasPendingWrites() const
+    {
+#if QT_CONFIG(sendfile)
+        if (!pendingFiles.isEmpty())
+            return true;
+#endif
+        return !allWriteBuffersEmpty();
+    }
+
+    bool sendFile(QFile *file, qint64 offset, qint64 size);
+    // A file range that sendFile() reads and writes in chunks as the
+    // socket drains, followed by the data written after it.
+    struct StreamedFile {
+        QPointer<QFile> file;
+        bool ownsFile;
+        qint64 offset;
+        qint64 remaining;
+        QByteArray after;
+    };
+    QList<StreamedFile> streamedFiles;
+    qint64 streamedFileBytes = 0;
+    QMetaObject::Connection streamedFilesConnection;
+    bool writingStreamedFiles = false;
+    bool holdBackWrite(const char *data, qint64 size);
+    void writeStreamedFiles();
+    void discardStreamedFiles();
+#if QT_CONFIG(sendfile)
+    // A file range queued by sendFile(). bufferedBefore is the number of
+    // bytes at the head of the write buffer that must be sent first.
+    struct PendingFile {
+        int fd;
+        qint64 offset;
+        qint64 remaining;
+        qint64 bufferedBefore;
+    };
+    QList<PendingFile> pendingFiles;
+    qint64 pendingFileBytes = 0;
+    qint64 writePendingFile();
+    void discardPendingFiles();
+#endif
+
     bool initSocketLayer(QAbstractSocket::NetworkLayerProtocol protocol);
     virtual void configureCreatedSocket();
     void startConnectingByName(const QString &host);
@@ -128,6 +128,71 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a count pending datagrams into \a datagrams without
+    blocking. Each datagram is truncated to \a maxSize bytes, unless \a
+    maxSize is negative. The IP header fields requested in \a options are
+    stored along with the data.
+
+    Returns the number of datagrams read, 0 if none was pending or -1 if an
+    error occurred before the first datagram could be read.
+
+    This implementation calls readDatagram() once per datagram. Engines that
+    can receive several datagrams at once should reimplement it.
+*/
+qsizetype QAbstractSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams,
+                                               qsizetype count, qint64 maxSize,
+                                               PacketHeaderOptions options)
+{
+    qsizetype received = 0;
+    while (received < count && hasPendingDatagrams()) {
+        QNetworkDatagramPrivate *datagram = datagrams[received];
+        const qint64 size = maxSize < 0 ? pendingDatagramSize() : maxSize;
+        if (size < 0)
+            break;
+
+        datagram->data.resize(size);
+        const qint64 readBytes = readDatagram(datagram->data.data(), size, &datagram->header,
+                                              options);
+        if (readBytes < 0) {
+            datagram->data.clear();
+            if (readBytes == -1 && received == 0)
+                return -1;
+            break;
+        }
+        datagram->data.truncate(readBytes);
+        ++received;
+    }
+    return received;
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams to the destinations
+    contained in their headers, in order.
+
+    Returns the number of datagrams written, which is smaller than \a count
+    if the socket's send buffer filled up or an error occurred in the
+    middle. If the first datagram could not be written, returns -1 if an
+    error occurred or -2 if the operation would have blocked.
+
+    This implementation calls writeDatagram() once per datagram. Engines that
+    can send several datagrams at once should reimplement it.
+*/
+qsizetype QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                                qsizetype count)
+{
+    for (qsizetype i = 0; i < count; ++i) {
+        const QNetworkDatagramPrivate *datagram = datagrams[i];
+        const qint64 sent = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                          datagram->header);
+        if (sent < 0)
+            return i ? i : qsizetype(sent);
+    }
+    return count;
+}
+#endif // QT_NO_UDPSOCKET
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
@@ -154,6 +154,11 @@ public:
 
     virtual bool hasPendingDatagrams() const = 0;
     virtual qint64 pendingDatagramSize() const = 0;
+
+    virtual qsizetype readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                    qint64 maxSize, PacketHeaderOptions = WantNone);
+    virtual qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                     qsizetype count);
 #endif // QT_NO_UDPSOCKET
 
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
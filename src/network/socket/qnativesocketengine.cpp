@@ -840,6 +840,41 @@ qint64 QNativeSocketEngine::pendingDatagramSize() const
 
     return d->nativePendingDatagramSize();
 }
+
+#if QT_CONFIG(sendmmsg)
+/*!
+    Reads up to \a count pending datagrams with as few system calls as
+    possible. See QAbstractSocketEngine::readDatagrams().
+*/
+qsizetype QNativeSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams,
+                                             qsizetype count, qint64 maxSize,
+                                             PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::readDatagrams(), QAbstractSocket::UdpSocket, -1);
+
+    return d->nativeReceiveDatagrams(datagrams, count, maxSize, options);
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams with as few system calls
+    as possible. See QAbstractSocketEngine::writeDatagrams().
+*/
+qsizetype QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                              qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::UdpSocket, -1);
+
+    return d->nativeSendDatagrams(datagrams, count);
+}
+#endif // QT_CONFIG(sendmmsg)
 #endif // QT_NO_UDPSOCKET
 
 /*!
@@ -916,6 +951,25 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+#if QT_CONFIG(sendfile)
+/*!
+    Writes up to \a maxSize bytes, starting at \a offset, from the file
+    referred to by \a fileDescriptor to the socket without copying the
+    data through user space. Returns the number of bytes written, 0 if
+    the socket cannot accept more data right now, or -1 if an error
+    occurred (including the file ending before \a maxSize bytes were
+    available).
+*/
+qint64 QNativeSocketEngine::sendFile(int fileDescriptor, qint64 offset, qint64 maxSize)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -1);
+    return d->nativeSendFile(fileDescriptor, offset, maxSize);
+}
+#endif
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -146,6 +146,9 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+#if QT_CONFIG(sendfile)
+    qint64 sendFile(int fileDescriptor, qint64 offset, qint64 maxSize);
+#endif
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -159,6 +162,13 @@ public:
 
     bool hasPendingDatagrams() const override;
     qint64 pendingDatagramSize() const override;
+
+#if QT_CONFIG(sendmmsg)
+    qsizetype readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                            qint64 maxSize, PacketHeaderOptions = WantNone) override;
+    qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                             qsizetype count) override;
+#endif
 #endif // QT_NO_UDPSOCKET
 
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
@@ -277,8 +287,16 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#if QT_CONFIG(sendmmsg)
+    qsizetype nativeReceiveDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                     qint64 maxSize, QAbstractSocketEngine::PacketHeaderOptions options);
+    qsizetype nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count);
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#if QT_CONFIG(sendfile)
+    qint64 nativeSendFile(int fileDescriptor, qint64 offset, qint64 length);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
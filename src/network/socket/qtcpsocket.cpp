@@ -118,6 +118,38 @@ QTcpSocket::QTcpSocket(QAbstractSocket::SocketType socketType,
 {
 }
 
+/*!
+    \since 6.4
+
+    Queues \a size bytes of \a file, starting at \a offset, to be written
+    to the socket after any data that has already been written. If \a size
+    is -1, or extends past the end of the file, everything from \a offset to
+    the end of the file is sent. Data written after this call is sent after
+    the file range. Returns \c true if the range was queued; otherwise
+    returns \c false.
+
+    \a file must be open for reading and must not be sequential. The file
+    contents are read when they are sent, so the file must not be truncated
+    until bytesToWrite() no longer includes the range. The transfer is
+    reported through bytesWritten() like any other written data.
+
+    On Linux, when the socket is connected directly (that is, without a
+    proxy and without encryption) the data is passed from the file to the
+    socket by the kernel without being copied into the application. In all
+    other cases, for example for QSslSocket, for proxied connections or for
+    files from the resource system, the range is read in chunks as
+    earlier data is written, so it is never held in memory at once. The
+    file is reopened by name for this; if \a file has no name, it must
+    stay open until the range has been sent, and its position is moved.
+
+    \sa write(), bytesToWrite()
+*/
+bool QTcpSocket::sendFile(QFile *file, qint64 offset, qint64 size)
+{
+    Q_D(QTcpSocket);
+    return d->sendFile(file, offset, size);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qtcpsocket.cpp"
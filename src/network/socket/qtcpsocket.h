@@ -47,7 +47,7 @@
 
 QT_BEGIN_NAMESPACE
 
-
+class QFile;
 class QTcpSocketPrivate;
 
 class Q_NETWORK_EXPORT QTcpSocket : public QAbstractSocket
@@ -64,6 +64,8 @@ public:
     { return bind(QHostAddress(addr), port, mode); }
 #endif
 
+    bool sendFile(QFile *file, qint64 offset = 0, qint64 size = -1);
+
 protected:
     QTcpSocket(QTcpSocketPrivate &dd, QObject *parent = nullptr);
     QTcpSocket(QAbstractSocket::SocketType socketType, QTcpSocketPrivate &dd,
@@ -68,6 +68,9 @@
     that case, hasPendingDatagrams() returns \c true. Call
     pendingDatagramSize() to obtain the size of the first pending
     datagram, and readDatagram() or receiveDatagram() to read it.
+    Applications that exchange large numbers of datagrams can use
+    receiveDatagrams() and writeDatagrams() to transfer several of them at
+    once.
 
     \note An incoming datagram should be read when you receive the readyRead()
     signal, otherwise this signal will not be emitted for the next datagram.
@@ -101,6 +104,7 @@
 #include "qhostaddress.h"
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
+#include "qvarlengtharray.h"
 #include "qabstractsocket_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -431,6 +435,61 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.4
+
+    Sends the datagrams in \a datagrams, in order, like writeDatagram() would
+    for each of them, but with as few calls into the operating system as
+    possible. This reduces the overhead per datagram considerably for
+    applications that send many small datagrams.
+
+    All datagrams should use the same network layer protocol, since the
+    socket is bound according to the destination of the first one if it
+    is not bound yet.
+
+    Returns the number of datagrams sent, which may be less than the number
+    of datagrams passed if the socket's send buffer filled up, or -1 if no
+    datagram could be sent. The bytesWritten() signal is emitted once for
+    every datagram sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lli)", qint64(datagrams.size()));
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.constFirst().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> privates(datagrams.size());
+    for (qsizetype i = 0; i < datagrams.size(); ++i)
+        privates[i] = datagrams.at(i).d;
+
+    const qsizetype sent = d->socketEngine->writeDatagrams(privates.constData(), privates.size());
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent < 0) {
+        if (sent == -2) {
+            // Socket engine reports EAGAIN. Treat as a temporary error.
+            d->setErrorAndEmit(QAbstractSocket::TemporaryError,
+                               tr("Unable to send a datagram"));
+        } else {
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        }
+        return -1;
+    }
+
+    for (qsizetype i = 0; i < sent; ++i)
+        emit bytesWritten(datagrams.at(i).d->data.size());
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -476,6 +535,63 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.4
+
+    Receives up to \a maxCount pending datagrams, each no larger than \a
+    maxSize bytes, and returns them in the order they arrived, along with
+    the same information receiveDatagram() provides. Datagrams that are
+    larger than \a maxSize bytes are truncated. If \a maxSize is -1 (the
+    default), the datagrams are read completely.
+
+    This function does not wait for datagrams to arrive: it returns an
+    empty list if none is pending. It needs fewer calls into the operating
+    system than calling receiveDatagram() in a loop, which matters for
+    applications that receive large numbers of datagrams.
+
+    On failure, returns the datagrams received before the error occurred.
+
+    \sa receiveDatagram(), hasPendingDatagrams(), writeDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(qsizetype maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%lli, %lld)", qint64(maxCount), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    // Grow the list one batch at a time, so that a large maxCount does not
+    // allocate datagrams that never arrive.
+    constexpr qsizetype BatchSize = 64;
+    QList<QNetworkDatagram> result;
+    if (maxCount <= 0)
+        return result;
+
+    qsizetype received = 0;
+    while (result.size() < maxCount) {
+        const qsizetype first = result.size();
+        const qsizetype count = qMin(maxCount - first, BatchSize);
+        result.resize(first + count);
+        QVarLengthArray<QNetworkDatagramPrivate *, BatchSize> privates(count);
+        for (qsizetype i = 0; i < count; ++i)
+            privates[i] = result[first + i].d;
+
+        received = d->socketEngine->readDatagrams(privates.constData(), count, maxSize,
+                                                  QAbstractSocketEngine::WantAll);
+        result.resize(first + qMax(received, qsizetype(0)));
+        if (received < count)
+            break;
+    }
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (received < 0)
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
@@ -835,8 +835,8 @@ qint64 QSslSocket::bytesToWrite() const
 {
     Q_D(const QSslSocket);
     if (d->mode == UnencryptedMode)
-        return d->plainSocket ? d->plainSocket->bytesToWrite() : 0;
-    return d->writeBuffer.size();
+        return (d->plainSocket ? d->plainSocket->bytesToWrite() : 0) + d->streamedFileBytes;
+    return d->writeBuffer.size() + d->streamedFileBytes;
 }
 
 /*!
@@ -1975,6 +1975,10 @@ qint64 QSslSocket::writeData(const char *data, qint64 len)
 #ifdef QSSLSOCKET_DEBUG
     qCDebug(lcSsl) << "QSslSocket::writeData(" << (void *)data << ',' << len << ')';
 #endif
+    // keep the order of data written after a streamed sendFile() range
+    if (d->holdBackWrite(data, len))
+        return len;
+
     if (d->mode == UnencryptedMode && !d->autoStartHandshake)
         return d->plainSocket->write(data, len);
 
@@ -45,7 +45,9 @@
 #include <qdatetime.h>
 #include <qdebug.h>
 #include <qfile.h>
+#include <qhash.h>
 #include <qlist.h>
+#include <qscopeguard.h>
 #include <qsqlerror.h>
 #include <qsqlfield.h>
 #include <qsqlindex.h>
@@ -167,6 +169,7 @@ protected:
 
     bool prepare(const QString &stmt) override;
     bool exec() override;
+    bool execBatch(bool arrayBind = false) override;
 };
 
 class QMYSQLResultPrivate: public QSqlResultPrivate
@@ -201,6 +204,7 @@ public:
     MYSQL_BIND *inBinds = nullptr;
     MYSQL_BIND *outBinds = nullptr;
 
+    QString preparedSql; // the statement text stmt was prepared from
     int rowsAffected = 0;
     bool hasBlobs = false;
     bool preparedQuery = false;
@@ -892,10 +896,95 @@ bool QMYSQLResult::prepare(const QString& query)
     }
 
     setSelect(d->bindInValues());
+    d->preparedSql = query;
     d->preparedQuery = true;
     return true;
 }
 
+/*
+    Describes \a val to MySQL in \a currBind. \a val, \a isNull and the
+    strings and times appended to \a stringVector and \a timeVector must
+    outlive the binding; the caller deletes the times.
+*/
+static void qBindValue(MYSQL_BIND *currBind, const QVariant &val, my_bool *isNull,
+                       QList<QByteArray> *stringVector, QList<MYSQL_TIME *> *timeVector)
+{
+    void *data = const_cast<void *>(val.constData());
+
+    *isNull = static_cast<my_bool>(QSqlResultPrivate::isVariantNull(val));
+    currBind->is_null = isNull;
+    currBind->length = 0;
+    currBind->is_unsigned = 0;
+
+    switch (val.userType()) {
+        case QMetaType::QByteArray:
+            currBind->buffer_type = MYSQL_TYPE_BLOB;
+            currBind->buffer = const_cast<char *>(val.toByteArray().constData());
+            currBind->buffer_length = val.toByteArray().size();
+            break;
+
+        case QMetaType::QTime:
+        case QMetaType::QDate:
+        case QMetaType::QDateTime: {
+            MYSQL_TIME *myTime = toMySqlDate(val.toDate(), val.toTime(), val.userType());
+            timeVector->append(myTime);
+
+            currBind->buffer = myTime;
+            switch (val.userType()) {
+            case QMetaType::QTime:
+                currBind->buffer_type = MYSQL_TYPE_TIME;
+                myTime->time_type = MYSQL_TIMESTAMP_TIME;
+                break;
+            case QMetaType::QDate:
+                currBind->buffer_type = MYSQL_TYPE_DATE;
+                myTime->time_type = MYSQL_TIMESTAMP_DATE;
+                break;
+            case QMetaType::QDateTime:
+                currBind->buffer_type = MYSQL_TYPE_DATETIME;
+                myTime->time_type = MYSQL_TIMESTAMP_DATETIME;
+                break;
+            default:
+                break;
+            }
+            currBind->buffer_length = sizeof(MYSQL_TIME);
+            currBind->length = 0;
+            break; }
+        case QMetaType::UInt:
+        case QMetaType::Int:
+            currBind->buffer_type = MYSQL_TYPE_LONG;
+            currBind->buffer = data;
+            currBind->buffer_length = sizeof(int);
+            currBind->is_unsigned = (val.userType() != QMetaType::Int);
+        break;
+        case QMetaType::Bool:
+            currBind->buffer_type = MYSQL_TYPE_TINY;
+            currBind->buffer = data;
+            currBind->buffer_length = sizeof(bool);
+            currBind->is_unsigned = false;
+            break;
+        case QMetaType::Double:
+            currBind->buffer_type = MYSQL_TYPE_DOUBLE;
+            currBind->buffer = data;
+            currBind->buffer_length = sizeof(double);
+            break;
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+            currBind->buffer_type = MYSQL_TYPE_LONGLONG;
+            currBind->buffer = data;
+            currBind->buffer_length = sizeof(qint64);
+            currBind->is_unsigned = (val.userType() == QMetaType::ULongLong);
+            break;
+        case QMetaType::QString:
+        default: {
+            QByteArray ba = val.toString().toUtf8();
+            stringVector->append(ba);
+            currBind->buffer_type = MYSQL_TYPE_STRING;
+            currBind->buffer = const_cast<char *>(ba.constData());
+            currBind->buffer_length = ba.length();
+            break; }
+    }
+}
+
 bool QMYSQLResult::exec()
 {
     Q_D(QMYSQLResult);
@@ -925,83 +1014,8 @@ bool QMYSQLResult::exec()
 
         nullVector.resize(values.count());
         for (int i = 0; i < values.count(); ++i) {
-            const QVariant &val = boundValues().at(i);
-            void *data = const_cast<void *>(val.constData());
-
-            MYSQL_BIND* currBind = &d->outBinds[i];
-
-            nullVector[i] = static_cast<my_bool>(QSqlResultPrivate::isVariantNull(val));
-            currBind->is_null = &nullVector[i];
-            currBind->length = 0;
-            currBind->is_unsigned = 0;
-
-            switch (val.userType()) {
-                case QMetaType::QByteArray:
-                    currBind->buffer_type = MYSQL_TYPE_BLOB;
-                    currBind->buffer = const_cast<char *>(val.toByteArray().constData());
-                    currBind->buffer_length = val.toByteArray().size();
-                    break;
-
-                case QMetaType::QTime:
-                case QMetaType::QDate:
-                case QMetaType::QDateTime: {
-                    MYSQL_TIME *myTime = toMySqlDate(val.toDate(), val.toTime(), val.userType());
-                    timeVector.append(myTime);
-
-                    currBind->buffer = myTime;
-                    switch (val.userType()) {
-                    case QMetaType::QTime:
-                        currBind->buffer_type = MYSQL_TYPE_TIME;
-                        myTime->time_type = MYSQL_TIMESTAMP_TIME;
-                        break;
-                    case QMetaType::QDate:
-                        currBind->buffer_type = MYSQL_TYPE_DATE;
-                        myTime->time_type = MYSQL_TIMESTAMP_DATE;
-                        break;
-                    case QMetaType::QDateTime:
-                        currBind->buffer_type = MYSQL_TYPE_DATETIME;
-                        myTime->time_type = MYSQL_TIMESTAMP_DATETIME;
-                        break;
-                    default:
-                        break;
-                    }
-                    currBind->buffer_length = sizeof(MYSQL_TIME);
-                    currBind->length = 0;
-                    break; }
-                case QMetaType::UInt:
-                case QMetaType::Int:
-                    currBind->buffer_type = MYSQL_TYPE_LONG;
-                    currBind->buffer = data;
-                    currBind->buffer_length = sizeof(int);
-                    currBind->is_unsigned = (val.userType() != QMetaType::Int);
-                break;
-                case QMetaType::Bool:
-                    currBind->buffer_type = MYSQL_TYPE_TINY;
-                    currBind->buffer = data;
-                    currBind->buffer_length = sizeof(bool);
-                    currBind->is_unsigned = false;
-                    break;
-                case QMetaType::Double:
-                    currBind->buffer_type = MYSQL_TYPE_DOUBLE;
-                    currBind->buffer = data;
-                    currBind->buffer_length = sizeof(double);
-                    break;
-                case QMetaType::LongLong:
-                case QMetaType::ULongLong:
-                    currBind->buffer_type = MYSQL_TYPE_LONGLONG;
-                    currBind->buffer = data;
-                    currBind->buffer_length = sizeof(qint64);
-                    currBind->is_unsigned = (val.userType() == QMetaType::ULongLong);
-                    break;
-                case QMetaType::QString:
-                default: {
-                    QByteArray ba = val.toString().toUtf8();
-                    stringVector.append(ba);
-                    currBind->buffer_type = MYSQL_TYPE_STRING;
-                    currBind->buffer = const_cast<char *>(ba.constData());
-                    currBind->buffer_length = ba.length();
-                    break; }
-            }
+            qBindValue(&d->outBinds[i], values.at(i), &nullVector[i], &stringVector,
+                       &timeVector);
         }
 
         r = mysql_stmt_bind_param(d->stmt, d->outBinds);
@@ -1063,6 +1077,180 @@ bool QMYSQLResult::exec()
     return true;
 }
 
+/*
+    Splits a prepared statement of the form "INSERT ... VALUES (?, ...)" into
+    the part up to and including VALUES, and the value tuple. Returns false
+    unless the tuple ends the statement and contains nothing but placeholders
+    and plain literals, so that it can be repeated for a multi-row INSERT.
+*/
+static bool qSplitInsertValues(QStringView query, QStringView *head, QStringView *tuple)
+{
+    query = query.trimmed();
+    if (query.endsWith(QLatin1Char(';')))
+        query = query.chopped(1).trimmed();
+    if (!query.startsWith(QLatin1String("INSERT"), Qt::CaseInsensitive)
+        && !query.startsWith(QLatin1String("REPLACE"), Qt::CaseInsensitive)) {
+        return false;
+    }
+
+    const qsizetype values = query.lastIndexOf(QLatin1String("VALUES"), -1, Qt::CaseInsensitive);
+    if (values <= 0 || (!query.at(values - 1).isSpace() && query.at(values - 1) != QLatin1Char(')')))
+        return false;
+    *head = query.first(values + 6);
+    *tuple = query.sliced(values + 6).trimmed();
+    if (head->contains(QLatin1Char('?')) || !tuple->startsWith(QLatin1Char('('))
+        || !tuple->endsWith(QLatin1Char(')'))) {
+        return false;
+    }
+    const QStringView inner = tuple->sliced(1, tuple->size() - 2);
+    for (QChar c : inner) {
+        if (c == QLatin1Char('(') || c == QLatin1Char(')') || c == QLatin1Char('\'')
+            || c == QLatin1Char('"') || c == QLatin1Char('`')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QMYSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QMYSQLResult);
+    if (!driver() || !d->preparedQuery || !d->stmt)
+        return QSqlResult::execBatch(arrayBind);
+
+    const QList<QVariant> boundColumns = boundValues();
+    if (boundColumns.isEmpty()) {
+        setLastError(QSqlError(QCoreApplication::translate("QMYSQLResult",
+                               "No values bound for the batch"), QString(),
+                               QSqlError::StatementError));
+        return false;
+    }
+
+    QStringView head;
+    QStringView tuple;
+    if (!qSplitInsertValues(d->preparedSql, &head, &tuple)
+        || tuple.count(QLatin1Char('?')) != boundColumns.size()
+        || mysql_stmt_param_count(d->stmt) != ulong(boundColumns.size())) {
+        return QSqlResult::execBatch(arrayBind);
+    }
+
+    QList<QVariantList> columns;
+    columns.reserve(boundColumns.size());
+    for (const QVariant &column : boundColumns)
+        columns.append(column.toList());
+    const qsizetype rowCount = columns.at(0).size();
+
+    // Send the rows as multi-row INSERT statements, prepared and bound like
+    // exec() does. Each statement stays below the limit of 65535 parameters
+    // and its bound data well below the default max_allowed_packet of the
+    // server. Strings are counted at three UTF-8 bytes per UTF-16 unit, the
+    // most they can take. A statement is prepared once per number of rows.
+    constexpr qsizetype MaxStatementSize = 1024 * 1024;
+    constexpr qsizetype MaxParameterCount = 65535;
+    const qsizetype maxRows = qMax(MaxParameterCount / columns.size(), qsizetype(1));
+    const auto boundSize = [](const QVariant &value) -> qsizetype {
+        // the type and length of each parameter
+        constexpr qsizetype Overhead = 16;
+        if (QSqlResultPrivate::isVariantNull(value))
+            return Overhead;
+        switch (value.userType()) {
+        case QMetaType::QByteArray:
+            return Overhead + value.toByteArray().size();
+        case QMetaType::QString:
+            return Overhead + 3 * value.toString().size();
+        case QMetaType::QTime:
+        case QMetaType::QDate:
+        case QMetaType::QDateTime:
+        case QMetaType::UInt:
+        case QMetaType::Int:
+        case QMetaType::Bool:
+        case QMetaType::Double:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+            // none of them is larger than a MYSQL_TIME
+            return Overhead + qsizetype(sizeof(MYSQL_TIME));
+        default:
+            return Overhead + 3 * value.toString().size();
+        }
+    };
+
+    MYSQL *mysql = d->drv_d_func()->mysql;
+    QHash<qsizetype, MYSQL_STMT *> statements;
+    const auto closeStatements = qScopeGuard([&statements] {
+        for (MYSQL_STMT *stmt : std::as_const(statements)) {
+            if (stmt)
+                mysql_stmt_close(stmt);
+        }
+    });
+
+    QList<QVariant> values;
+    QList<MYSQL_BIND> binds;
+    QList<my_bool> nulls;
+    QList<QByteArray> strings;
+    QList<MYSQL_TIME *> times;
+    qint64 rowsAffected = 0;
+    setLastError(QSqlError());
+    for (qsizetype first = 0; first < rowCount; ) {
+        values.clear();
+        qsizetype size = 0;
+        qsizetype last = first;
+        for ( ; last < rowCount && last - first < maxRows; ++last) {
+            qsizetype rowSize = 0;
+            for (const QVariantList &column : std::as_const(columns))
+                rowSize += boundSize(column.value(last));
+            if (last > first && size + rowSize > MaxStatementSize)
+                break;
+            size += rowSize;
+            for (const QVariantList &column : std::as_const(columns))
+                values.append(column.value(last));
+        }
+        const qsizetype rows = last - first;
+        first = last;
+
+        MYSQL_STMT *&stmt = statements[rows];
+        if (!stmt) {
+            QString query = head.toString() + QLatin1Char(' ');
+            for (qsizetype i = 0; i < rows; ++i) {
+                if (i)
+                    query += QLatin1String(", ");
+                query += tuple;
+            }
+            const QByteArray encodedQuery = query.toUtf8();
+            stmt = mysql_stmt_init(mysql);
+            if (!stmt || mysql_stmt_prepare(stmt, encodedQuery.constData(), encodedQuery.size())) {
+                setLastError(stmt ? qMakeStmtError(QCoreApplication::translate("QMYSQLResult",
+                                                   "Unable to prepare statement"),
+                                                   QSqlError::StatementError, stmt)
+                                  : qMakeError(QCoreApplication::translate("QMYSQLResult",
+                                               "Unable to prepare statement"),
+                                               QSqlError::StatementError, d->drv_d_func()));
+                return false;
+            }
+        }
+
+        binds = QList<MYSQL_BIND>(values.size());
+        nulls = QList<my_bool>(values.size());
+        strings.clear();
+        for (qsizetype i = 0; i < values.size(); ++i)
+            qBindValue(&binds[i], values.at(i), &nulls[i], &strings, &times);
+        const bool executed = !mysql_stmt_bind_param(stmt, binds.data())
+                && !mysql_stmt_execute(stmt);
+        qDeleteAll(times);
+        times.clear();
+        if (!executed) {
+            setLastError(qMakeStmtError(QCoreApplication::translate("QMYSQLResult",
+                         "Unable to execute statement"), QSqlError::StatementError, stmt));
+            return false;
+        }
+        rowsAffected += mysql_stmt_affected_rows(stmt);
+    }
+
+    d->rowsAffected = int(rowsAffected);
+    setSelect(false);
+    setActive(true);
+    return true;
+}
+
 /////////////////////////////////////////////////////////
 
 static int qMySqlConnectionCount = 0;
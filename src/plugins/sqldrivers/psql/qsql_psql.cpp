@@ -143,6 +143,7 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind = false) override;
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -179,6 +180,17 @@ public:
     mutable QHash<int, QString> oidToTable;
 };
 
+class QPSQLPreparedStatement : public QSqlPreparedStatement
+{
+public:
+    QPSQLPreparedStatement(QPSQLDriverPrivate *driver, const QString &id)
+        : driver(driver), id(id) {}
+    ~QPSQLPreparedStatement();
+
+    QPSQLDriverPrivate *driver;
+    QString id;
+};
+
 void QPSQLDriverPrivate::appendTables(QStringList &tl, QSqlQuery &t, QChar type)
 {
     const QString query =
@@ -292,9 +304,12 @@ public:
 
     QString fieldSerial(int i) const override { return QLatin1Char('$') + QString::number(i + 1); }
     void deallocatePreparedStmt();
+    // hands the prepared statement over to the driver's cache, or deallocates it
+    void releasePreparedStmt();
 
     std::queue<PGresult*> nextResultSets;
     QString preparedStmtId;
+    QString preparedQuery; // the query preparedStmtId was prepared from
     PGresult *result = nullptr;
     StatementId stmtId = InvalidStatementId;
     int currentSize = -1;
@@ -421,6 +436,31 @@ void QPSQLResultPrivate::deallocatePreparedStmt()
         PQclear(result);
     }
     preparedStmtId.clear();
+    preparedQuery.clear();
+}
+
+QPSQLPreparedStatement::~QPSQLPreparedStatement()
+{
+    if (id.isEmpty() || !driver->connection)
+        return;
+
+    PGresult *result = driver->exec(QStringLiteral("DEALLOCATE ") + id);
+    if (PQresultStatus(result) != PGRES_COMMAND_OK)
+        qWarning("Unable to free statement: %s", PQerrorMessage(driver->connection));
+    PQclear(result);
+}
+
+void QPSQLResultPrivate::releasePreparedStmt()
+{
+    auto *drv = const_cast<QPSQLDriverPrivate *>(drv_d_func());
+    if (!drv || !drv->isStatementCacheEnabled() || preparedQuery.isNull()) {
+        deallocatePreparedStmt();
+        return;
+    }
+
+    drv->cacheStatement(preparedQuery, new QPSQLPreparedStatement(drv, preparedStmtId));
+    preparedStmtId.clear();
+    preparedQuery.clear();
 }
 
 QPSQLResult::QPSQLResult(const QPSQLDriver *db)
@@ -436,7 +476,7 @@ QPSQLResult::~QPSQLResult()
     cleanup();
 
     if (d->preparedQueriesEnabled && !d->preparedStmtId.isNull())
-        d->deallocatePreparedStmt();
+        d->releasePreparedStmt();
 }
 
 QVariant QPSQLResult::handle() const
@@ -883,7 +923,16 @@ bool QPSQLResult::prepare(const QString &query)
     cleanup();
 
     if (!d->preparedStmtId.isEmpty())
-        d->deallocatePreparedStmt();
+        d->releasePreparedStmt();
+
+    auto *drv = const_cast<QPSQLDriverPrivate *>(d->drv_d_func());
+    if (QSqlPreparedStatement *cached = drv->takeCachedStatement(query)) {
+        auto *statement = static_cast<QPSQLPreparedStatement *>(cached);
+        d->preparedStmtId = std::exchange(statement->id, QString());
+        d->preparedQuery = query;
+        delete statement;
+        return true;
+    }
 
     const QString stmtId = qMakePreparedStmtId();
     const QString stmt = QStringLiteral("PREPARE %1 AS ").arg(stmtId).append(d->positionalToNamedBinding(query));
@@ -900,6 +949,7 @@ bool QPSQLResult::prepare(const QString &query)
 
     PQclear(result);
     d->preparedStmtId = stmtId;
+    d->preparedQuery = query;
     return true;
 }
 
@@ -937,6 +987,150 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    Q_D(QPSQLResult);
+    if (!d->preparedQueriesEnabled || d->preparedStmtId.isEmpty())
+        return QSqlResult::execBatch(arrayBind);
+
+    const QList<QVariant> boundColumns = boundValues();
+    if (boundColumns.isEmpty()) {
+        setLastError(QSqlError(QCoreApplication::translate("QPSQLResult",
+                               "No values bound for the batch"), QString(),
+                               QSqlError::StatementError));
+        return false;
+    }
+    QList<QVariantList> columns;
+    columns.reserve(boundColumns.size());
+    for (const QVariant &column : boundColumns)
+        columns.append(column.toList());
+    const qsizetype rowCount = columns.at(0).size();
+
+    cleanup();
+    setLastError(QSqlError());
+
+    auto *drv = const_cast<QPSQLDriverPrivate *>(d->drv_d_func());
+    PGconn *connection = drv->connection;
+    // Pipeline mode can only be entered on an idle connection
+    drv->discardResults();
+
+    // Outside of a transaction every chunk below would be an implicit
+    // transaction of its own, and a failing row would leave the chunks
+    // before it applied. Run the batch in one transaction instead, so that
+    // it is applied completely or not at all.
+    const bool ownTransaction = PQtransactionStatus(connection) == PQTRANS_IDLE;
+    if (ownTransaction) {
+        PGresult *res = drv->exec("BEGIN");
+        const bool begun = res && PQresultStatus(res) == PGRES_COMMAND_OK;
+        PQclear(res);
+        if (!begun)
+            return QSqlResult::execBatch(arrayBind);
+    }
+    if (!PQenterPipelineMode(connection)) {
+        if (ownTransaction)
+            PQclear(drv->exec("ROLLBACK"));
+        return QSqlResult::execBatch(arrayBind);
+    }
+    d->stmtId = drv->currentStmtId = drv->generateStatementId();
+
+    // Send the rows in chunks, each followed by a sync point whose results
+    // are read before the next chunk is sent. A chunk is small enough for
+    // the server's replies to fit into the socket buffers, so the server
+    // never stops reading our statements because we are not reading its
+    // replies. Each chunk is one round trip.
+    constexpr qsizetype ChunkSize = 128;
+    QList<QVariant> row(columns.size());
+    bool ok = true;
+    for (qsizetype first = 0; ok && first < rowCount; first += ChunkSize) {
+        const qsizetype last = qMin(first + ChunkSize, rowCount);
+        for (qsizetype i = first; i < last; ++i) {
+            for (qsizetype j = 0; j < columns.size(); ++j)
+                row[j] = columns.at(j).value(i);
+            const QString params = qCreateParamString(row, driver());
+            const QString stmt = params.isEmpty()
+                    ? QStringLiteral("EXECUTE %1").arg(d->preparedStmtId)
+                    : QStringLiteral("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
+            const QByteArray encodedStmt = drv->isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit();
+            if (!PQsendQueryParams(connection, encodedStmt.constData(), 0, nullptr, nullptr,
+                                   nullptr, nullptr, 0)) {
+                setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                        "Unable to send query"), QSqlError::StatementError, drv));
+                ok = false;
+                break;
+            }
+        }
+        if (!PQpipelineSync(connection)) {
+            if (ok) {
+                setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                        "Unable to send query"), QSqlError::StatementError, drv));
+            }
+            ok = false;
+            break;
+        }
+
+        // Read results up to the sync point; after an error the server
+        // reports the remaining statements of the chunk as aborted.
+        forever {
+            PGresult *result = PQgetResult(connection);
+            if (!result) {
+                // end of the results of one statement
+                if (PQstatus(connection) == CONNECTION_BAD)
+                    break;
+                continue;
+            }
+            const ExecStatusType status = PQresultStatus(result);
+            if (status == PGRES_PIPELINE_SYNC) {
+                PQclear(result);
+                break;
+            }
+            if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK) {
+                // keep the last result, like executing the rows one by one would
+                if (d->result)
+                    PQclear(d->result);
+                d->result = result;
+                continue;
+            }
+            if (ok) {
+                setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                        "Unable to execute statement"), QSqlError::StatementError,
+                                        drv, result));
+                ok = false;
+            }
+            PQclear(result);
+        }
+        if (PQstatus(connection) == CONNECTION_BAD)
+            ok = false;
+    }
+    PQexitPipelineMode(connection);
+
+    if (ownTransaction) {
+        PGresult *res = drv->exec(ok ? "COMMIT" : "ROLLBACK");
+        if (ok && (!res || PQresultStatus(res) != PGRES_COMMAND_OK)) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                    "Unable to commit the batch"), QSqlError::TransactionError,
+                                    drv, res));
+            ok = false;
+        }
+        PQclear(res);
+        d->stmtId = drv->currentStmtId;
+    }
+
+    if (!ok) {
+        if (d->result)
+            PQclear(d->result);
+        d->result = nullptr;
+        setActive(false);
+        return false;
+    }
+    if (!d->result) // no rows
+        return true;
+    return d->processResults();
+#else
+    return QSqlResult::execBatch(arrayBind);
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -1138,6 +1332,8 @@ QPSQLDriver::QPSQLDriver(PGconn *conn, QObject *parent)
 QPSQLDriver::~QPSQLDriver()
 {
     Q_D(QPSQLDriver);
+    // the cached statements are deallocated through the connection
+    d->statementCache.clear();
     if (d->connection)
         PQfinish(d->connection);
 }
@@ -1164,6 +1360,11 @@ bool QPSQLDriver::hasFeature(DriverFeature f) const
     case PositionalPlaceholders:
         return d->pro >= QPSQLDriver::Version8_2;
     case BatchOperations:
+#ifdef LIBPQ_HAS_PIPELINING
+        return d->pro >= QPSQLDriver::Version8_2;
+#else
+        return false;
+#endif
     case NamedPlaceholders:
     case SimpleLocking:
     case FinishQuery:
@@ -1241,6 +1442,7 @@ void QPSQLDriver::close()
 {
     Q_D(QPSQLDriver);
 
+    d->statementCache.clear();
     d->seid.clear();
     if (d->sn) {
         disconnect(d->sn, SIGNAL(activated(QSocketDescriptor)), this, SLOT(_q_handleNotification()));
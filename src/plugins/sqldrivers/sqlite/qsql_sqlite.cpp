@@ -120,6 +120,15 @@ static QSqlError qMakeError(sqlite3 *access, const QString &descr, QSqlError::Er
 
 class QSQLiteResultPrivate;
 
+class QSQLitePreparedStatement : public QSqlPreparedStatement
+{
+public:
+    explicit QSQLitePreparedStatement(sqlite3_stmt *stmt) : stmt(stmt) {}
+    ~QSQLitePreparedStatement() { sqlite3_finalize(stmt); }
+
+    sqlite3_stmt *stmt;
+};
+
 class QSQLiteResult : public QSqlCachedResult
 {
     Q_DECLARE_PRIVATE(QSQLiteResult)
@@ -168,8 +177,11 @@ public:
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
+    // hands stmt over to the driver's statement cache, or finalizes it
+    void releaseStatement();
 
     sqlite3_stmt *stmt = nullptr;
+    QString stmtQuery; // the query stmt was prepared from
     QSqlRecord rInf;
     QList<QVariant> firstRow;
     bool skippedStatus = false; // the status of the fetchNext() that's skipped
@@ -179,7 +191,7 @@ public:
 void QSQLiteResultPrivate::cleanup()
 {
     Q_Q(QSQLiteResult);
-    finalize();
+    releaseStatement();
     rInf.clear();
     skippedStatus = false;
     skipRow = false;
@@ -195,6 +207,25 @@ void QSQLiteResultPrivate::finalize()
 
     sqlite3_finalize(stmt);
     stmt = 0;
+    stmtQuery.clear();
+}
+
+void QSQLiteResultPrivate::releaseStatement()
+{
+    if (!stmt)
+        return;
+
+    auto *drv = const_cast<QSQLiteDriverPrivate *>(drv_d_func());
+    if (!drv || !drv->isStatementCacheEnabled() || stmtQuery.isNull()) {
+        finalize();
+        return;
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    drv->cacheStatement(stmtQuery, new QSQLitePreparedStatement(stmt));
+    stmt = nullptr;
+    stmtQuery.clear();
 }
 
 void QSQLiteResultPrivate::initColumns(bool emptyResultset)
@@ -387,6 +418,15 @@ bool QSQLiteResult::prepare(const QString &query)
 
     setSelect(false);
 
+    auto *drv = const_cast<QSQLiteDriverPrivate *>(d->drv_d_func());
+    if (QSqlPreparedStatement *cached = drv->takeCachedStatement(query)) {
+        auto *statement = static_cast<QSQLitePreparedStatement *>(cached);
+        d->stmt = std::exchange(statement->stmt, nullptr);
+        d->stmtQuery = query;
+        delete statement;
+        return true;
+    }
+
     const void *pzTail = nullptr;
     const auto size = int((query.size() + 1) * sizeof(QChar));
 
@@ -409,6 +449,7 @@ bool QSQLiteResult::prepare(const QString &query)
         d->finalize();
         return false;
     }
+    d->stmtQuery = query;
     return true;
 }
 
@@ -820,6 +861,8 @@ void QSQLiteDriver::close()
             sqlite3_update_hook(d->access, nullptr, nullptr);
         }
 
+        d->statementCache.clear();
+
         const int res = sqlite3_close(d->access);
 
         if (res != SQLITE_OK)
@@ -844,4 +844,90 @@ int QSqlDriver::maximumIdentifierLength(QSqlDriver::IdentifierType type) const
     return INT_MAX;
 }
 
+/*!
+    \since 6.4
+
+    Enables the prepared statement cache of this connection and lets it hold
+    up to \a size statements. A \a size of 0 disables the cache and releases
+    all cached statements; this is the default.
+
+    With the cache enabled, a statement that is no longer used by a query
+    (because the QSqlQuery was destroyed, cleared or prepared again) is kept
+    instead of being released. A later prepare() of the same query text on
+    any QSqlQuery of this connection reuses it instead of asking the
+    database to parse and plan the query again. When the cache is full, the
+    least recently used statement is released.
+
+    The cache is used by the QSQLITE and QPSQL drivers. Other drivers ignore
+    this setting.
+
+    \sa preparedStatementCacheSize(), preparedStatementCacheHits(),
+        clearPreparedStatementCache()
+*/
+void QSqlDriver::setPreparedStatementCacheSize(int size)
+{
+    Q_D(QSqlDriver);
+    d->statementCache.setMaxCost(qMax(size, 0));
+}
+
+/*!
+    \since 6.4
+
+    Returns the maximum number of statements kept in the prepared statement
+    cache, or 0 if the cache is disabled.
+
+    \sa setPreparedStatementCacheSize()
+*/
+int QSqlDriver::preparedStatementCacheSize() const
+{
+    Q_D(const QSqlDriver);
+    return int(d->statementCache.maxCost());
+}
+
+/*!
+    \since 6.4
+
+    Releases all statements held by the prepared statement cache and resets
+    the hit and miss counters. The cache size is not changed.
+
+    \sa setPreparedStatementCacheSize()
+*/
+void QSqlDriver::clearPreparedStatementCache()
+{
+    Q_D(QSqlDriver);
+    d->statementCache.clear();
+    d->statementCacheHits = 0;
+    d->statementCacheMisses = 0;
+}
+
+/*!
+    \since 6.4
+
+    Returns how many times a query was prepared by reusing a statement from
+    the prepared statement cache.
+
+    \sa preparedStatementCacheMisses(), setPreparedStatementCacheSize()
+*/
+qint64 QSqlDriver::preparedStatementCacheHits() const
+{
+    Q_D(const QSqlDriver);
+    return d->statementCacheHits;
+}
+
+/*!
+    \since 6.4
+
+    Returns how many times a query had to be prepared by the database while
+    the prepared statement cache was enabled.
+
+    \sa preparedStatementCacheHits(), setPreparedStatementCacheSize()
+*/
+qint64 QSqlDriver::preparedStatementCacheMisses() const
+{
+    Q_D(const QSqlDriver);
+    return d->statementCacheMisses;
+}
+
+QSqlPreparedStatement::~QSqlPreparedStatement() = default;
+
 QT_END_NAMESPACE
@@ -131,6 +131,13 @@ public:
 
     DbmsType dbmsType() const;
     virtual int maximumIdentifierLength(IdentifierType type) const;
+
+    void setPreparedStatementCacheSize(int size);
+    int preparedStatementCacheSize() const;
+    void clearPreparedStatementCache();
+    qint64 preparedStatementCacheHits() const;
+    qint64 preparedStatementCacheMisses() const;
+
 public Q_SLOTS:
     virtual bool cancelQuery();
 
@@ -55,9 +55,19 @@
 #include "private/qobject_p.h"
 #include "qsqldriver.h"
 #include "qsqlerror.h"
+#include "qcache.h"
 
 QT_BEGIN_NAMESPACE
 
+// A prepared statement that is kept in QSqlDriverPrivate::statementCache
+// while no result uses it. Drivers subclass it to hold their native handle
+// and release that handle in the destructor.
+class Q_SQL_EXPORT QSqlPreparedStatement
+{
+public:
+    virtual ~QSqlPreparedStatement();
+};
+
 class QSqlDriverPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QSqlDriver)
@@ -73,6 +83,36 @@ public:
     QSqlDriver::DbmsType dbmsType;
     bool isOpen = false;
     bool isOpenError = false;
+
+    // Idle prepared statements, keyed by query text. Disabled (max cost 0)
+    // unless enabled with QSqlDriver::setPreparedStatementCacheSize(). Drivers
+    // must clear it before closing the connection the statements belong to.
+    QCache<QString, QSqlPreparedStatement> statementCache{0};
+    qint64 statementCacheHits = 0;
+    qint64 statementCacheMisses = 0;
+
+    // Removes an idle statement for \a query from the cache and hands it to
+    // the caller. Returns nullptr if there is none or the cache is disabled.
+    QSqlPreparedStatement *takeCachedStatement(const QString &query)
+    {
+        if (statementCache.maxCost() <= 0)
+            return nullptr;
+        if (QSqlPreparedStatement *statement = statementCache.take(query)) {
+            ++statementCacheHits;
+            return statement;
+        }
+        ++statementCacheMisses;
+        return nullptr;
+    }
+
+    // Returns \a statement to the cache once a result no longer uses it.
+    // Takes ownership; the statement is deleted if it cannot be cached.
+    void cacheStatement(const QString &query, QSqlPreparedStatement *statement)
+    {
+        statementCache.insert(query, statement);
+    }
+
+    bool isStatementCacheEnabled() const { return statementCache.maxCost() > 0; }
 };
 
 QT_END_NAMESPACE
@@ -47,6 +47,8 @@
 QT_BEGIN_NAMESPACE
 
 #define QSQL_PREFETCH 255
+#define QSQL_WINDOW_COUNT 3
+#define QSQL_WINDOW_KEY_COUNT 1024
 
 void QSqlQueryModelPrivate::prefetch(int limit)
 {
@@ -87,6 +89,233 @@ QSqlQueryModelPrivate::~QSqlQueryModelPrivate()
 {
 }
 
+void QSqlQueryModelPrivate::resetWindows()
+{
+    windowed = false;
+    windowSize = 0;
+    windowBaseQuery.clear();
+    windowKeyColumns.clear();
+    windowKeyFields.clear();
+    windowDb = QSqlDatabase();
+    windowStartKeys.clear();
+    windowKeyStride = 1;
+    windowCount = 0;
+    lastKey.clear();
+    windows.clear();
+}
+
+/*
+    Returns the statement selecting one window of the windowed query. With
+    \a hasAnchor, the window starts at the key bound to the statement, or
+    right after it if \a inclusive is false, and skips \a offset rows.
+    windowKeyBindValues() returns the values to bind for a key.
+*/
+QString QSqlQueryModelPrivate::windowQuery(bool hasAnchor, bool inclusive, int offset) const
+{
+    using Sql = QSqlQueryModelSql;
+
+    const QString keys = windowKeyColumns.join(Sql::comma());
+    const QString placeholder = QStringLiteral("?");
+    QString condition;
+    if (hasAnchor) {
+        // Row values like (k1, k2) >= (?, ?) are not supported by every
+        // database, so compare column by column:
+        //   k1 >= ? AND (k1 > ? OR (k1 = ? AND k2 >= ?))
+        // The leading comparison lets the database use an index on k1.
+        for (qsizetype i = 0; i < windowKeyColumns.size(); ++i) {
+            QString term;
+            for (qsizetype j = 0; j < i; ++j)
+                term = Sql::et(term, Sql::eq(windowKeyColumns.at(j), placeholder));
+            const bool last = i == windowKeyColumns.size() - 1;
+            const QString op = last && inclusive ? QStringLiteral(">=") : QStringLiteral(">");
+            term = Sql::et(term, Sql::concat(Sql::concat(windowKeyColumns.at(i), op), placeholder));
+            condition = condition.isEmpty()
+                    ? term : Sql::concat(Sql::concat(condition, QStringLiteral("OR")), Sql::paren(term));
+        }
+        if (windowKeyColumns.size() > 1) {
+            condition = Sql::et(Sql::concat(Sql::concat(windowKeyColumns.first(), QStringLiteral(">=")),
+                                            placeholder),
+                                Sql::paren(condition));
+        }
+    }
+
+    const QString limit = QString::number(windowSize);
+    const QString skip = QString::number(offset);
+    QString columns = QStringLiteral("*");
+    QString tail;
+    switch (windowDb.driver()->dbmsType()) {
+    case QSqlDriver::MSSqlServer:
+    case QSqlDriver::Sybase:
+        if (offset > 0) {
+            tail = QLatin1String("OFFSET ") + skip + QLatin1String(" ROWS FETCH NEXT ") + limit
+                    + QLatin1String(" ROWS ONLY");
+        } else {
+            columns = QLatin1String("TOP ") + limit + QLatin1String(" *");
+        }
+        break;
+    case QSqlDriver::Oracle:
+    case QSqlDriver::DB2:
+    case QSqlDriver::Interbase:
+        if (offset > 0)
+            tail = QLatin1String("OFFSET ") + skip + QLatin1String(" ROWS");
+        tail = Sql::concat(tail, QLatin1String("FETCH FIRST ") + limit + QLatin1String(" ROWS ONLY"));
+        break;
+    default:
+        tail = QLatin1String("LIMIT ") + limit;
+        if (offset > 0)
+            tail += QLatin1String(" OFFSET ") + skip;
+        break;
+    }
+
+    QString stmt = Sql::concat(Sql::select(columns),
+                               Sql::from(Sql::concat(Sql::paren(windowBaseQuery),
+                                                     QStringLiteral("qt_window"))));
+    stmt = Sql::concat(stmt, Sql::where(condition));
+    stmt = Sql::concat(stmt, Sql::orderBy(keys));
+    return Sql::concat(stmt, tail);
+}
+
+/*
+    Returns the values to bind to the condition of windowQuery() for \a key.
+*/
+QList<QVariant> QSqlQueryModelPrivate::windowKeyBindValues(const QList<QVariant> &key) const
+{
+    if (key.size() == 1)
+        return key;
+    QList<QVariant> values = { key.first() };
+    for (qsizetype i = 0; i < key.size(); ++i)
+        values += key.mid(0, i + 1);
+    return values;
+}
+
+/*
+    Selects the rows of \a window into \a rows. Windows that were seen
+    before start at the nearest first key that was kept, skipping the rows
+    of the windows in between; a new window starts after the last key seen
+    so far.
+*/
+bool QSqlQueryModelPrivate::fetchWindow(int window, WindowRows *rows, QSqlRecord *record) const
+{
+    const bool known = window < windowCount;
+    const QList<QVariant> *anchor = nullptr;
+    int offset = 0;
+    if (window > 0) {
+        if (known) {
+            const int index = window / windowKeyStride;
+            anchor = &windowStartKeys.at(index);
+            offset = (window - index * windowKeyStride) * windowSize;
+        } else {
+            anchor = &lastKey;
+        }
+    }
+
+    QSqlQuery windowQuery(windowDb);
+    windowQuery.setForwardOnly(true);
+    if (!windowQuery.prepare(this->windowQuery(anchor != nullptr, known, offset))) {
+        error = windowQuery.lastError();
+        return false;
+    }
+    if (anchor) {
+        for (const QVariant &value : windowKeyBindValues(*anchor))
+            windowQuery.addBindValue(value);
+    }
+    if (!windowQuery.exec()) {
+        error = windowQuery.lastError();
+        return false;
+    }
+
+    if (record)
+        *record = windowQuery.record();
+    const int columns = windowQuery.record().count();
+    rows->reserve(windowSize);
+    while (windowQuery.next()) {
+        QList<QVariant> row(columns);
+        for (int i = 0; i < columns; ++i)
+            row[i] = windowQuery.value(i);
+        rows->append(std::move(row));
+    }
+    return true;
+}
+
+/*
+    Returns the values of \a row, selecting its window again if it is not
+    among the ones kept in memory.
+*/
+const QList<QVariant> *QSqlQueryModelPrivate::windowRow(int row) const
+{
+    if (row < 0 || row > bottom.row())
+        return nullptr;
+
+    const int window = row / windowSize;
+    WindowRows *rows = windows.object(window);
+    if (!rows) {
+        rows = new WindowRows;
+        if (!fetchWindow(window, rows)) {
+            delete rows;
+            return nullptr;
+        }
+        windows.insert(window, rows);
+    }
+    const int offset = row % windowSize;
+    return offset < rows->size() ? &rows->at(offset) : nullptr;
+}
+
+/*
+    Selects the window following the last row of the model and appends
+    its rows. Takes ownership of \a rows if they were already selected.
+*/
+void QSqlQueryModelPrivate::fetchNextWindow(WindowRows *rows)
+{
+    Q_Q(QSqlQueryModel);
+    if (atEnd) {
+        delete rows;
+        return;
+    }
+
+    const int window = windowCount;
+    if (!rows) {
+        rows = new WindowRows;
+        if (!fetchWindow(window, rows)) {
+            delete rows;
+            atEnd = true;
+            return;
+        }
+    }
+    if (rows->size() < windowSize)
+        atEnd = true;
+    if (rows->isEmpty()) {
+        delete rows;
+        return;
+    }
+
+    const auto keyOf = [this](const QList<QVariant> &row) {
+        QList<QVariant> key;
+        for (int field : qAsConst(windowKeyFields))
+            key.append(row.at(field));
+        return key;
+    };
+    // Keep the first key of every windowKeyStride-th window only, halving
+    // the keys kept whenever there are too many.
+    if (window % windowKeyStride == 0) {
+        windowStartKeys.append(keyOf(rows->first()));
+        if (windowStartKeys.size() > QSQL_WINDOW_KEY_COUNT) {
+            for (qsizetype i = 1; 2 * i < windowStartKeys.size(); ++i)
+                windowStartKeys[i] = windowStartKeys.at(2 * i);
+            windowStartKeys.resize((windowStartKeys.size() + 1) / 2);
+            windowKeyStride *= 2;
+        }
+    }
+    ++windowCount;
+    lastKey = keyOf(rows->last());
+
+    const int first = bottom.row() + 1;
+    const int last = first + int(rows->size()) - 1;
+    windows.insert(window, rows);
+    q->beginInsertRows(QModelIndex(), first, last);
+    bottom = q->createIndex(last, bottom.column());
+    q->endInsertRows();
+}
+
 void QSqlQueryModelPrivate::initColOffsets(int size)
 {
     colOffsets.resize(size);
@@ -192,7 +421,10 @@ void QSqlQueryModel::fetchMore(const QModelIndex &parent)
     Q_D(QSqlQueryModel);
     if (parent.isValid())
         return;
-    d->prefetch(qMax(d->bottom.row(), 0) + QSQL_PREFETCH);
+    if (d->windowed)
+        d->fetchNextWindow();
+    else
+        d->prefetch(qMax(d->bottom.row(), 0) + QSQL_PREFETCH);
 }
 
 /*!
@@ -375,6 +607,10 @@ QVariant QSqlQueryModel::data(const QModelIndex &item, int role) const
     if (!d->rec.isGenerated(item.column()))
         return v;
     QModelIndex dItem = indexInQuery(item);
+    if (d->windowed) {
+        const QList<QVariant> *row = d->windowRow(dItem.row());
+        return row ? row->value(dItem.column()) : v;
+    }
     if (dItem.row() > d->bottom.row())
         const_cast<QSqlQueryModelPrivate *>(d)->prefetch(dItem.row());
 
@@ -450,6 +686,7 @@ void QSqlQueryModel::setQuery(QSqlQuery &&query)
     Q_D(QSqlQueryModel);
     beginResetModel();
 
+    d->resetWindows();
     QSqlRecord newRec = query.record();
     bool columnsChanged = (newRec != d->rec);
 
@@ -510,6 +747,113 @@ void QSqlQueryModel::setQuery(const QString &query, const QSqlDatabase &db)
     setQuery(QSqlQuery(query, db));
 }
 
+/*!
+    \since 6.4
+
+    Resets the model to show the result of the SELECT statement \a query on
+    the database connection \a db, keeping only a bounded number of rows in
+    memory. If no database (or an invalid database) is specified, the default
+    connection is used.
+
+    The rows are selected in windows of \a windowSize rows, ordered by the
+    columns in \a keyColumns. Together, these columns must identify a row
+    uniquely and must not be NULL. Each window is selected with a query of
+    the form \c{SELECT * FROM (query) WHERE key >= (first key of the window)
+    ORDER BY key} with a row limit, so the database can use an index on the
+    key columns instead of skipping rows. With several key columns, the
+    condition compares them one by one, as in \c{k1 > ? OR (k1 = ? AND
+    k2 >= ?)}. Only the windows around the most recently accessed rows are
+    kept; other rows are selected again when they are accessed.
+
+    The model remembers the first key of at most 1024 windows. Beyond that,
+    it keeps the key of every second, fourth, and so on, window, and a window
+    whose key was dropped is selected with an offset from the nearest key
+    that was kept.
+
+    Like for drivers that do not report the size of a query, rows are added
+    to the model one window at a time through fetchMore(), so the memory used
+    by the model stays bounded however far a view is scrolled. As rows are
+    selected again when needed, changes to the table can become visible
+    while the model is in use.
+
+    lastError() can be used to retrieve verbose information if there
+    was an error setting the query.
+
+    \sa setQuery(), fetchMore()
+*/
+void QSqlQueryModel::setWindowedQuery(const QString &query, const QStringList &keyColumns,
+                                      int windowSize, const QSqlDatabase &db)
+{
+    Q_D(QSqlQueryModel);
+    beginResetModel();
+
+    d->resetWindows();
+    d->bottom = QModelIndex();
+    d->error = QSqlError();
+    d->atEnd = true;
+    d->query = QSqlQuery(db);
+
+    if (windowSize <= 0 || keyColumns.isEmpty()) {
+        d->error = QSqlError(QSqlQueryModel::tr("A windowed query needs key columns "
+                                                "and a positive window size"),
+                             QString(), QSqlError::StatementError);
+        d->rec.clear();
+        d->colOffsets.clear();
+        endResetModel();
+        return;
+    }
+
+    d->windowed = true;
+    d->windowSize = windowSize;
+    QString baseQuery = query.trimmed();
+    while (baseQuery.endsWith(QLatin1Char(';')))
+        baseQuery = baseQuery.chopped(1).trimmed();
+    d->windowBaseQuery = baseQuery;
+    d->windowKeyColumns = keyColumns;
+    d->windowDb = db.isValid() ? db : QSqlDatabase::database();
+    d->windows.setMaxCost(QSQL_WINDOW_COUNT);
+
+    // Select the first window in full to learn the record of the query
+    auto *rows = new QSqlQueryModelPrivate::WindowRows;
+    QSqlRecord newRec;
+    if (!d->fetchWindow(0, rows, &newRec)) {
+        delete rows;
+        d->resetWindows();
+        d->rec.clear();
+        d->colOffsets.clear();
+        endResetModel();
+        return;
+    }
+
+    for (const QString &key : keyColumns) {
+        const int field = newRec.indexOf(d->windowDb.driver()->stripDelimiters(key, QSqlDriver::FieldName));
+        if (field < 0) {
+            delete rows;
+            d->error = QSqlError(QSqlQueryModel::tr("Key column %1 is not part of the query")
+                                         .arg(key),
+                                 QString(), QSqlError::StatementError);
+            d->resetWindows();
+            d->rec.clear();
+            d->colOffsets.clear();
+            endResetModel();
+            return;
+        }
+        d->windowKeyFields.append(field);
+    }
+
+    if (d->colOffsets.size() != newRec.count() || newRec != d->rec)
+        d->initColOffsets(newRec.count());
+    d->rec = newRec;
+    d->bottom = createIndex(-1, d->rec.count() - 1);
+    d->atEnd = false;
+
+    // fetchNextWindow does the rowsInserted stuff like fetchMore
+    d->fetchNextWindow(rows);
+
+    endResetModel();
+    queryChange();
+}
+
 /*!
     Clears the model and releases any acquired resource.
 */
@@ -517,6 +861,7 @@ void QSqlQueryModel::clear()
 {
     Q_D(QSqlQueryModel);
     beginResetModel();
+    d->resetWindows();
     d->error = QSqlError();
     d->atEnd = true;
     d->query.clear();
@@ -82,6 +82,8 @@ public:
 #endif
     void setQuery(QSqlQuery &&query);
     void setQuery(const QString &query, const QSqlDatabase &db = QSqlDatabase());
+    void setWindowedQuery(const QString &query, const QStringList &keyColumns, int windowSize,
+                          const QSqlDatabase &db = QSqlDatabase());
     QSqlQuery query() const;
 
     virtual void clear();
@@ -56,6 +56,8 @@
 #include "QtSql/qsqlerror.h"
 #include "QtSql/qsqlquery.h"
 #include "QtSql/qsqlrecord.h"
+#include "QtSql/qsqldatabase.h"
+#include "QtCore/qcache.h"
 #include "QtCore/qhash.h"
 #include "QtCore/qlist.h"
 #include "QtCore/qvarlengtharray.h"
@@ -75,6 +77,15 @@ public:
     void initColOffsets(int size);
     int columnInQuery(int modelColumn) const;
 
+    // windowed mode, see QSqlQueryModel::setWindowedQuery()
+    using WindowRows = QList<QList<QVariant>>;
+    void resetWindows();
+    QString windowQuery(bool hasAnchor, bool inclusive, int offset = 0) const;
+    QList<QVariant> windowKeyBindValues(const QList<QVariant> &key) const;
+    bool fetchWindow(int window, WindowRows *rows, QSqlRecord *record = nullptr) const;
+    const QList<QVariant> *windowRow(int row) const;
+    void fetchNextWindow(WindowRows *rows = nullptr);
+
     mutable QSqlQuery query = { QSqlQuery(nullptr) };
     mutable QSqlError error;
     QModelIndex bottom;
@@ -83,6 +94,18 @@ public:
     QList<QHash<int, QVariant>> headers;
     QVarLengthArray<int, 56> colOffsets; // used to calculate indexInQuery of columns
     int nestedResetLevel;
+
+    bool windowed = false;
+    int windowSize = 0;
+    QString windowBaseQuery;
+    QStringList windowKeyColumns;
+    QList<int> windowKeyFields; // indexes of the key columns in the query result
+    QSqlDatabase windowDb;
+    QList<QList<QVariant>> windowStartKeys; // key of the first row of every windowKeyStride-th window
+    int windowKeyStride = 1;
+    int windowCount = 0; // number of windows selected so far
+    QList<QVariant> lastKey; // key of the last row seen so far
+    mutable QCache<int, WindowRows> windows;
 };
 
 // helpers for building SQL expressions
@@ -42,7 +42,11 @@
 #include <QTemporaryFile>
 #include <QOperatingSystemVersion>
 #include <QStorageInfo>
+#include <QRegularExpression>
 #include <QScopeGuard>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
@@ -50,6 +54,10 @@
 
 #include <QtTest/private/qemulationdetector_p.h>
 
+#if defined(QT_BUILD_INTERNAL) && defined(Q_OS_UNIX) && QT_CONFIG(future)
+#include <private/qfileasyncio_p.h>
+#endif
+
 #ifdef Q_OS_WIN
 QT_BEGIN_NAMESPACE
 extern Q_CORE_EXPORT int qt_ntfs_permission_lookup;
@@ -298,6 +306,11 @@ private slots:
 
     void stdfilesystem();
 
+    void readWriteAsync_data();
+    void readWriteAsync();
+    void readAsyncResource();
+    void readAsyncProcFile();
+
 private:
 #ifdef BUILTIN_TESTDATA
     QSharedPointer<QTemporaryDir> m_dataDir;
@@ -3985,5 +3998,102 @@ void tst_QFile::stdfilesystem()
 #endif
 }
 
+void tst_QFile::readWriteAsync_data()
+{
+    QTest::addColumn<bool>("threadPool");
+    QTest::newRow("default") << false;
+#if defined(QT_BUILD_INTERNAL) && defined(Q_OS_UNIX) && QT_CONFIG(future)
+    QTest::newRow("threadPool") << true;
+#endif
+}
+
+void tst_QFile::readWriteAsync()
+{
+#if QT_CONFIG(future)
+    QFETCH(bool, threadPool);
+#if defined(QT_BUILD_INTERNAL) && defined(Q_OS_UNIX)
+    if (threadPool) {
+        QFileAsyncIO::setBackend(QFileAsyncIO::Backend::ThreadPool);
+        QCOMPARE(QFileAsyncIO::backend(), QFileAsyncIO::Backend::ThreadPool);
+    }
+    const auto restoreBackend = qScopeGuard([] {
+        QFileAsyncIO::setBackend(QFileAsyncIO::Backend::IoUring);
+    });
+#else
+    Q_UNUSED(threadPool);
+#endif
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    const QByteArray payload = QByteArray("0123456789abcdef").repeated(4096);
+
+    QFuture<qint64> written = file.writeAsync(0, payload);
+    QCOMPARE(written.result(), payload.size());
+    QCOMPARE(file.pos(), qint64(0));
+    QCOMPARE(file.size(), payload.size());
+
+    // a synchronous write in between is flushed before the next request
+    QCOMPARE(file.write("XYZ"), qint64(3));
+    QFuture<QByteArray> head = file.readAsync(0, 16);
+    QCOMPARE(head.result(), QByteArray("XYZ3456789abcdef"));
+    QCOMPARE(file.pos(), qint64(3));
+
+    // reads stop at the end of the file and do not move pos()
+    QFuture<QByteArray> tail = file.readAsync(payload.size() - 6, 100);
+    QCOMPARE(tail.result(), QByteArray("abcdef"));
+    QFuture<QByteArray> past = file.readAsync(payload.size() + 10, 100);
+    QVERIFY(past.result().isEmpty());
+
+    // the transfer survives the QFile going away
+    QFuture<QByteArray> all = file.readAsync(16, payload.size());
+    file.close();
+    QCOMPARE(all.result(), payload.mid(16));
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         QRegularExpression("QFile::readAsync: File .* not open for reading"));
+    QVERIFY(file.readAsync(0, 10).result().isEmpty());
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
+void tst_QFile::readAsyncResource()
+{
+#if QT_CONFIG(future)
+    QFile file(":/tst_qfileinfo/resources/file1.ext1");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray expected = file.readAll();
+    QVERIFY(!expected.isEmpty());
+
+    // resources have no native handle and are opened again by name
+    QFuture<QByteArray> future = file.readAsync(1, expected.size());
+    QCOMPARE(future.result(), expected.mid(1));
+    QCOMPARE(file.pos(), expected.size());
+#else
+    QSKIP("This test requires QFuture");
+#endif
+}
+
+void tst_QFile::readAsyncProcFile()
+{
+#if !QT_CONFIG(future)
+    QSKIP("This test requires QFuture");
+#elif !defined(Q_OS_LINUX)
+    QSKIP("This test requires /proc");
+#else
+    // files in /proc report a size of 0 but still have contents
+    QFile file("/proc/self/cmdline");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.size(), qint64(0));
+    const QByteArray expected = file.readAll();
+    QVERIFY(!expected.isEmpty());
+
+    QFuture<QByteArray> future = file.readAsync(0, 1024 * 1024);
+    QCOMPARE(future.result(), expected);
+    QFuture<QByteArray> partial = file.readAsync(1, expected.size() - 2);
+    QCOMPARE(partial.result(), expected.mid(1, expected.size() - 2));
+#endif
+}
+
 QTEST_MAIN(tst_QFile)
 #include "tst_qfile.moc"
@@ -68,6 +68,7 @@ private slots:
     void cleanup();
 
     void registerTimer();
+    void manyTimers();
 
     /* void registerSocketNotifier(); */ // Not implemented here, see tst_QSocketNotifier instead
     /* void registerEventNotifiier(); */ // Not implemented here, see tst_QWinEventNotifier instead
@@ -297,6 +298,53 @@ void tst_QEventDispatcher::registerTimer()
     QVERIFY(timers.registeredTimers().isEmpty());
 }
 
+// Timers whose timeouts lie far enough apart fire in order, and each fires
+// once if it is unregistered from its own timer event.
+void tst_QEventDispatcher::manyTimers()
+{
+    class Receiver : public QObject
+    {
+    public:
+        QHash<int, int> intervals;
+        QList<int> fired;
+        void timerEvent(QTimerEvent *e) override
+        {
+            QAbstractEventDispatcher::instance()->unregisterTimer(e->timerId());
+            fired.append(intervals.value(e->timerId()));
+        }
+    } receiver;
+
+    constexpr int TimerCount = 2000;
+    QList<int> unregistered;
+    for (int i = 0; i < TimerCount; ++i) {
+        const int interval = 50 * (1 + i % 4);
+        const int id = eventDispatcher->registerTimer(interval, Qt::PreciseTimer, &receiver);
+        QVERIFY(id > 0);
+        receiver.intervals.insert(id, interval);
+        if (i % 3 == 0)
+            unregistered.append(id);
+    }
+    QCOMPARE(eventDispatcher->registeredTimers(&receiver).size(), TimerCount);
+
+    for (int id : std::as_const(unregistered)) {
+        QVERIFY(eventDispatcher->unregisterTimer(id));
+        QVERIFY(!eventDispatcher->unregisterTimer(id));
+        receiver.intervals.remove(id);
+    }
+    const qsizetype remaining = TimerCount - unregistered.size();
+    const QList<QAbstractEventDispatcher::TimerInfo> timers
+            = eventDispatcher->registeredTimers(&receiver);
+    QCOMPARE(timers.size(), remaining);
+    for (const QAbstractEventDispatcher::TimerInfo &timer : timers) {
+        QCOMPARE(timer.interval, receiver.intervals.value(timer.timerId));
+        QVERIFY(eventDispatcher->remainingTime(timer.timerId) <= timer.interval);
+    }
+
+    QTRY_COMPARE(receiver.fired.size(), remaining);
+    QVERIFY(std::is_sorted(receiver.fired.cbegin(), receiver.fired.cend()));
+    QVERIFY(eventDispatcher->registeredTimers(&receiver).isEmpty());
+}
+
 void tst_QEventDispatcher::sendPostedEvents_data()
 {
     QTest::addColumn<int>("processEventsFlagsInt");
@@ -445,10 +493,12 @@ void tst_QEventDispatcher::postEventFromEventHandler()
 
     const QByteArrayView eventDispatcherName(QAbstractEventDispatcher::instance()->metaObject()->className());
     qDebug() << eventDispatcherName;
-    // QXcbUnixEventDispatcher and QEventDispatcherUNIX do not do this correctly on any platform;
+    // QXcbUnixEventDispatcher and QEventDispatcherUNIX (and QEventDispatcherEpoll, which shares
+    // its posted event handling) do not do this correctly on any platform;
     // both Windows event dispatchers fail as well.
     const bool knownToFail = eventDispatcherName.contains("UNIX")
                           || eventDispatcherName.contains("Unix")
+                          || eventDispatcherName.contains("Epoll")
                           || eventDispatcherName.contains("Win32")
                           || eventDispatcherName.contains("WindowsGui")
                           || eventDispatcherName.contains("Android");
@@ -501,6 +501,38 @@ void tst_QMetaType::threadSafety()
     QCOMPARE(Bar::failureCount, 0);
 }
 
+struct LookupAliasTarget
+{
+    int i;
+};
+
+void tst_QMetaType::lookupWhileRegistering()
+{
+    // Lookups by name don't lock, so keep looking up one name in another
+    // thread while registering more names makes the index grow
+    constexpr int AliasCount = 1000;
+    const QMetaType target(qRegisterMetaType<LookupAliasTarget>());
+    QMetaType::registerNormalizedTypedef("LookupAlias0", target);
+
+    QAtomicInt failureCount;
+    QAtomicInt done;
+    QScopedPointer<QThread> reader(QThread::create([&] {
+        while (!done.loadAcquire()) {
+            if (QMetaType::fromName("LookupAlias0") != target)
+                failureCount.ref();
+        }
+    }));
+    reader->start();
+    for (int i = 1; i < AliasCount; ++i)
+        QMetaType::registerNormalizedTypedef("LookupAlias" + QByteArray::number(i), target);
+    done.storeRelease(1);
+    QVERIFY(reader->wait());
+
+    QCOMPARE(failureCount.loadRelaxed(), 0);
+    for (int i = 0; i < AliasCount; ++i)
+        QCOMPARE(QMetaType::fromName("LookupAlias" + QByteArray::number(i)), target);
+}
+
 namespace TestSpace
 {
     struct Foo { double d; public: ~Foo() {} };
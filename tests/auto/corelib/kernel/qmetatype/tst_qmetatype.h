@@ -72,6 +72,7 @@ private:
 private slots:
     void defined();
     void threadSafety();
+    void lookupWhileRegistering();
     void namespaces();
     void id();
     void qMetaTypeId();
@@ -61,6 +61,7 @@
 #endif
 
 #include <functional>
+#include <thread>
 
 #include <math.h>
 
@@ -85,6 +86,9 @@ private slots:
     void connectReferenceToIncompleteTypes();
     void emitInDefinedOrder();
     void customTypes();
+    void queuedArguments();
+    void queuedCallInFinishingThread();
+    void coalescedConnection();
     void streamCustomTypes();
     void metamethod();
     void namespaces();
@@ -1488,6 +1492,26 @@ void QCustomTypeChecker::slot1(CustomType ct)
 void QCustomTypeChecker::slot2(const QList< CustomType >& ct)
 { received = ct[0]; }
 
+struct LargeCustomType : CustomType
+{
+    using CustomType::CustomType;
+    char padding[100] = {};
+};
+
+struct alignas(64) OverAlignedCustomType : CustomType
+{
+    using CustomType::CustomType;
+};
+
+class QueuedArgumentsChecker : public QObject
+{
+    Q_OBJECT
+signals:
+    void manyArguments(int i, const CustomType &small, const QString &string,
+                       const LargeCustomType &large, const OverAlignedCustomType &aligned);
+    void customTypeChanged(const CustomType &value);
+};
+
 void tst_QObject::customTypes()
 {
     CustomType t0;
@@ -1528,6 +1552,122 @@ void tst_QObject::customTypes()
     QCOMPARE(instanceCount, 3);
 }
 
+// The event of a queued call keeps small arguments inside itself and
+// allocates the others, make sure both kinds arrive intact and get destroyed.
+void tst_QObject::queuedArguments()
+{
+    CheckInstanceCount checkInstanceCount;
+
+    QueuedArgumentsChecker object;
+    int received = 0;
+    connect(&object, &QueuedArgumentsChecker::manyArguments, &object,
+            [&](int i, const CustomType &small, const QString &string,
+                const LargeCustomType &large, const OverAlignedCustomType &aligned) {
+        QCOMPARE(i, 42);
+        QCOMPARE(small.i1, 1);
+        QCOMPARE(string, QStringLiteral("string"));
+        QCOMPARE(large.i2, 2);
+        QCOMPARE(aligned.i3, 3);
+        QCOMPARE(quintptr(&aligned) % alignof(OverAlignedCustomType), quintptr(0));
+        ++received;
+    }, Qt::QueuedConnection);
+
+    const int before = instanceCount;
+    emit object.manyArguments(42, CustomType(1), QStringLiteral("string"),
+                              LargeCustomType(0, 2), OverAlignedCustomType(0, 0, 3));
+    QCOMPARE(instanceCount, before + 3);
+    QCoreApplication::processEvents();
+    QCOMPARE(received, 1);
+    QCOMPARE(instanceCount, before);
+
+    // events that are never delivered destroy their arguments, too
+    emit object.manyArguments(42, CustomType(1), QStringLiteral("string"),
+                              LargeCustomType(0, 2), OverAlignedCustomType(0, 0, 3));
+    QCOMPARE(instanceCount, before + 3);
+    QCoreApplication::removePostedEvents(&object, QEvent::MetaCall);
+    QCOMPARE(instanceCount, before);
+}
+
+// An adopted thread finishes, and deletes the events still posted to its
+// objects, after its thread_local objects have been destroyed.
+void tst_QObject::queuedCallInFinishingThread()
+{
+    CheckInstanceCount checkInstanceCount;
+
+    int received = 0;
+    std::thread thread([&] {
+        auto object = new QueuedArgumentsChecker;
+        connect(object, &QueuedArgumentsChecker::customTypeChanged, object,
+                [&](const CustomType &) { ++received; }, Qt::QueuedConnection);
+        emit object->customTypeChanged(CustomType(1));
+        QCoreApplication::sendPostedEvents(object, QEvent::MetaCall);
+
+        connect(QThread::currentThread(), &QThread::finished, object, [object] {
+            emit object->customTypeChanged(CustomType(2));
+            object->deleteLater();
+        }, Qt::DirectConnection);
+    });
+    thread.join();
+    QCOMPARE(received, 1);
+}
+
+void tst_QObject::coalescedConnection()
+{
+    CheckInstanceCount checkInstanceCount;
+
+    QueuedArgumentsChecker object;
+    QList<int> received;
+    connect(&object, &QueuedArgumentsChecker::customTypeChanged, &object,
+            [&](const CustomType &value) { received << value.i1; },
+            static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection));
+
+    // only the latest arguments are delivered
+    const int before = instanceCount;
+    for (int i = 1; i <= 3; ++i)
+        emit object.customTypeChanged(CustomType(i));
+    QCOMPARE(instanceCount, before + 1);
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QList<int>({ 3 }));
+    QCOMPARE(instanceCount, before);
+
+    emit object.customTypeChanged(CustomType(4));
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QList<int>({ 3, 4 }));
+
+    // a removed call is destroyed, and doesn't stop the next one
+    emit object.customTypeChanged(CustomType(5));
+    emit object.customTypeChanged(CustomType(6));
+    QCoreApplication::removePostedEvents(&object, QEvent::MetaCall);
+    QCOMPARE(instanceCount, before);
+    emit object.customTypeChanged(CustomType(7));
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QList<int>({ 3, 4, 7 }));
+
+    // emissions from another thread are coalesced as well
+    QueuedArgumentsChecker sender;
+    QList<int> receivedFromThread;
+    connect(&sender, &QueuedArgumentsChecker::customTypeChanged, &object,
+            [&](const CustomType &value) { receivedFromThread << value.i1; },
+            static_cast<Qt::ConnectionType>(Qt::AutoConnection | Qt::CoalescedConnection));
+    QScopedPointer<QThread> thread(QThread::create([&] {
+        for (int i = 1; i <= 100; ++i)
+            emit sender.customTypeChanged(CustomType(i));
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QCoreApplication::processEvents();
+    QCOMPARE(receivedFromThread, QList<int>({ 100 }));
+
+    // a direct call isn't affected
+    connect(&object, &QueuedArgumentsChecker::customTypeChanged, &object,
+            [&](const CustomType &value) { received << value.i1; },
+            static_cast<Qt::ConnectionType>(Qt::AutoConnection | Qt::CoalescedConnection));
+    emit object.customTypeChanged(CustomType(8));
+    QCOMPARE(received, QList<int>({ 3, 4, 7, 8 }));
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QList<int>({ 3, 4, 7, 8, 8 }));
+}
+
 void tst_QObject::streamCustomTypes()
 {
     QByteArray ba;
@@ -31,8 +31,14 @@
 #include <QtTest/QTestEventLoop>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/private/qglobal_p.h>
+#if QT_CONFIG(epoll)
+#  include <QtCore/private/qeventdispatcher_epoll_p.h>
+#endif
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
@@ -59,6 +65,10 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+#endif
+#if QT_CONFIG(epoll)
+    void epollDispatcher();
+    void epollDispatcherRegularFile();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -362,6 +372,119 @@ void tst_QSocketNotifier::posixSockets()
 }
 #endif
 
+#if QT_CONFIG(epoll)
+void tst_QSocketNotifier::epollDispatcher()
+{
+    class PipeThread : public QThread
+    {
+    public:
+        bool writeActivated = false;
+        bool readActivated = false;
+        bool rearmedActivated = false;
+
+    protected:
+        void run() override
+        {
+            int fds[2];
+            if (qt_safe_pipe(fds, O_NONBLOCK) != 0)
+                return;
+
+            {
+                QEventLoop loop;
+                QSocketNotifier rn(fds[0], QSocketNotifier::Read);
+                QSocketNotifier wn(fds[1], QSocketNotifier::Write);
+                int reads = 0;
+
+                connect(&wn, &QSocketNotifier::activated, [&]() {
+                    writeActivated = true;
+                    wn.setEnabled(false);
+                    qt_safe_write(fds[1], "a", 1);
+                });
+                connect(&rn, &QSocketNotifier::activated, [&]() {
+                    char c;
+                    if (qt_safe_read(fds[0], &c, 1) != 1 || c != 'a') {
+                        loop.exit(1);
+                        return;
+                    }
+                    if (++reads == 1) {
+                        readActivated = true;
+                        // disabling and re-enabling must keep the kernel's
+                        // interest list in sync
+                        rn.setEnabled(false);
+                        rn.setEnabled(true);
+                        wn.setEnabled(true);
+                    } else {
+                        rearmedActivated = true;
+                        loop.quit();
+                    }
+                });
+                QTimer::singleShot(5000, &loop, [&loop]() { loop.exit(1); });
+                loop.exec();
+            }
+
+            qt_safe_close(fds[0]);
+            qt_safe_close(fds[1]);
+        }
+    };
+
+    PipeThread thread;
+    thread.setEventDispatcher(new QEventDispatcherEpoll);
+    thread.start();
+    QVERIFY(thread.wait(10000));
+    QVERIFY(thread.writeActivated);
+    QVERIFY(thread.readActivated);
+    QVERIFY(thread.rearmedActivated);
+}
+
+void tst_QSocketNotifier::epollDispatcherRegularFile()
+{
+    // epoll cannot watch regular files; like poll(), the dispatcher must
+    // report them as always ready instead of disabling the notifier
+    QTemporaryFile file;
+    QVERIFY(file.open());
+
+    class FileThread : public QThread
+    {
+    public:
+        int fd = -1;
+        bool readActivated = false;
+        bool writeActivated = false;
+
+    protected:
+        void run() override
+        {
+            QEventLoop loop;
+            QSocketNotifier rn(fd, QSocketNotifier::Read);
+            QSocketNotifier wn(fd, QSocketNotifier::Write);
+            auto check = [&] {
+                if (readActivated && writeActivated)
+                    loop.quit();
+            };
+            connect(&rn, &QSocketNotifier::activated, [&] {
+                readActivated = true;
+                rn.setEnabled(false);
+                check();
+            });
+            connect(&wn, &QSocketNotifier::activated, [&] {
+                writeActivated = true;
+                wn.setEnabled(false);
+                check();
+            });
+            QTimer::singleShot(5000, &loop, [&loop]() { loop.exit(1); });
+            loop.exec();
+        }
+    };
+
+    FileThread thread;
+    thread.fd = file.handle();
+    thread.setEventDispatcher(new QEventDispatcherEpoll);
+    thread.start();
+    QVERIFY(thread.wait(10000));
+    QVERIFY(thread.readActivated);
+    QVERIFY(thread.writeActivated);
+}
+#endif
+
 void tst_QSocketNotifier::async_readDatagramSlot()
 {
     char buf[1];
@@ -146,6 +146,7 @@ private Q_SLOTS:
     void nesting();
 
     void longStrings();
+    void vectorizedScanning();
 
     void arrayInitializerList();
     void objectInitializerList();
@@ -3161,6 +3162,54 @@ void tst_QtJson::longStrings()
     }
 }
 
+void tst_QtJson::vectorizedScanning()
+{
+    // strings and whitespace are scanned in blocks of 16 or 32 bytes, so try
+    // special characters at every position around those boundaries
+    for (int len = 0; len < 80; ++len) {
+        const QByteArray plain(len, 'a');
+        QJsonParseError error;
+
+        QJsonDocument doc = QJsonDocument::fromJson("[\"" + plain + "\"]", &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.array().at(0).toString(), QString::fromLatin1(plain));
+
+        // unterminated string
+        doc = QJsonDocument::fromJson("[\"" + plain, &error);
+        QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+
+        // whitespace runs
+        doc = QJsonDocument::fromJson("[" + QByteArray(len, ' ') + "1" + QByteArray(len, '\n') + "]", &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.array().at(0).toInteger(), 1);
+
+        for (int pos = 0; pos <= len; ++pos) {
+            const QByteArray head = plain.left(pos);
+            const QByteArray tail = plain.mid(pos);
+            const QString expectedHead = QString::fromLatin1(head);
+            const QString expectedTail = QString::fromLatin1(tail);
+
+            doc = QJsonDocument::fromJson("[\"" + head + "\\n" + tail + "\"]", &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().at(0).toString(), expectedHead + u'\n' + expectedTail);
+
+            doc = QJsonDocument::fromJson("[\"" + head + "\xc3\xa9" + tail + "\\\"" + tail + "\"]", &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().at(0).toString(),
+                     expectedHead + u'\u00e9' + expectedTail + u'"' + expectedTail);
+
+            doc = QJsonDocument::fromJson("[\"" + head + "\xff" + tail + "\"]", &error);
+            QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+            QCOMPARE(error.offset, pos + 2);
+
+            doc = QJsonDocument::fromJson("[" + QByteArray(pos, ' ') + "1," + QByteArray(len - pos, '\t')
+                                          + "\"" + head + "\"]", &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().at(1).toString(), expectedHead);
+        }
+    }
+}
+
 void tst_QtJson::testJsonValueRefDefault()
 {
     QJsonObject empty;
@@ -123,6 +123,9 @@ private slots:
     void fromCborStreamReaderByteArray();
     void fromCborStreamReaderIODevice_data() { fromCbor_data(); }
     void fromCborStreamReaderIODevice();
+    void fromRawCbor_data() { fromCbor_data(); }
+    void fromRawCbor();
+    void fromRawCborLazyContainers();
     void validation_data();
     void validation();
     void extendedTypeValidation_data();
@@ -2207,6 +2210,80 @@ void tst_QCborValue::fromCbor()
     fromCbor_common(doCheck);
 }
 
+void tst_QCborValue::fromRawCbor()
+{
+    auto doCheck = [](const QCborValue &v, const QByteArray &result) {
+        QCborParserError error;
+        QCborValue decoded = QCborValue::fromRawCbor(result, &error);
+        QVERIFY2(error.error == QCborError(), qPrintable(error.errorString()));
+        QCOMPARE(error.offset, result.size());
+        QVERIFY(decoded == v);
+        QVERIFY(v == decoded);
+        QCOMPARE(decoded.toCbor(), v.toCbor());
+    };
+
+    fromCbor_common(doCheck);
+}
+
+void tst_QCborValue::fromRawCborLazyContainers()
+{
+    QCborMap inner{{1, "one"}, {2, QCborArray{"two", 2.5}}, {"empty", QCborArray()}};
+    QCborMap source{{"array", QCborArray{1, inner, QCborMap()}},
+                    {"map", inner},
+                    {"tagged", QCborValue(QCborTag(1234), QCborArray{inner})},
+                    {"text", QStringLiteral("h\u00e9llo")}};
+    const QByteArray encoded = QCborValue(source).toCbor();
+    const QByteArray raw = QByteArray::fromRawData(encoded.constData(), encoded.size());
+
+    // each way of looking at the nested containers decodes them
+    QCborParserError error;
+    QCborValue decoded = QCborValue::fromRawCbor(raw, &error);
+    QCOMPARE(error.error, QCborError::NoError);
+    QCOMPARE(error.offset, encoded.size());
+    QCOMPARE(decoded[QLatin1String("map")][2][1].toDouble(), 2.5);
+    QCOMPARE(QCborValue::fromRawCbor(raw).toMap().value("array").toArray().at(1).toMap(), inner);
+    QCOMPARE(QCborValue::fromRawCbor(raw).toCbor(), encoded);
+    QCOMPARE(QCborValue::fromRawCbor(raw).toJsonValue(), QCborValue(source).toJsonValue());
+    QCOMPARE(QCborValue::fromRawCbor(raw).toDiagnosticNotation(),
+             QCborValue(source).toDiagnosticNotation());
+    QCOMPARE(QCborValue::fromRawCbor(raw).toVariant(), QCborValue(source).toVariant());
+    QCOMPARE(QCborValue::fromRawCbor(raw).compare(source), 0);
+    QCOMPARE(qHash(QCborValue::fromRawCbor(raw)), qHash(QCborValue(source)));
+    QCOMPARE(QCborValue::fromRawCbor(raw).taggedValue(), QCborValue());
+    QCOMPARE(QCborValue::fromRawCbor(raw)[QLatin1String("tagged")].taggedValue()[0], QCborValue(inner));
+
+    // modifying nested containers in place gives the same result as
+    // modifying the eagerly decoded value
+    const auto modify = [](QCborValue &value) {
+        value[QLatin1String("map")][QLatin1String("x")] = 5;
+        value[QLatin1String("map")][2][0] = "changed";
+        value[QLatin1String("array")][1][QLatin1String("new")] = true;
+        value[QLatin1String("array")][1][2][QLatin1String("key")] = 3;
+    };
+    QCborValue modified = QCborValue::fromRawCbor(raw);
+    modify(modified);
+    QCborValue expected = QCborValue::fromCbor(encoded);
+    modify(expected);
+    QCOMPARE(modified, expected);
+    QCOMPARE(modified.toCbor(), expected.toCbor());
+    QCOMPARE(modified[QLatin1String("map")][QLatin1String("x")], QCborValue(5));
+    QCOMPARE(modified[QLatin1String("map")][1], QCborValue("one"));
+    QCOMPARE(modified[QLatin1String("map")][2].toArray(), QCborArray({"changed", 2.5}));
+    QCOMPARE(modified[QLatin1String("array")][1].toMap().size(), inner.size() + 1);
+    QCOMPARE(decoded[QLatin1String("map")][2][0], QCborValue("two"));
+
+    QCborMap copy = QCborValue::fromRawCbor(raw).toMap();
+    QCborArray array = copy.value("array").toArray();
+    array.append(42);
+    copy.insert(QLatin1String("array"), array);
+    QCOMPARE(copy.value("array").toArray().size(), 4);
+    QCOMPARE(copy.value("map").toMap(), inner);
+
+    // truncation inside a nested container is still detected while skipping it
+    QCborValue::fromRawCbor(QCborValue(QCborArray{inner, 1}).toCbor().chopped(2), &error);
+    QCOMPARE(error.error, QCborError::EndOfFile);
+}
+
 void tst_QCborValue::fromCborStreamReaderByteArray()
 {
     auto doCheck = [](const QCborValue &expected, const QByteArray &data) {
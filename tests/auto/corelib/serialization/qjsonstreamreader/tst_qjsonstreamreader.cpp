@@ -0,0 +1,391 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void tokens_data();
+    void tokens();
+    void incremental_data() { tokens_data(); }
+    void incremental();
+    void device_data() { tokens_data(); }
+    void device();
+    void largeDevice();
+    void longStringInPieces();
+    void readCurrentValue_data() { tokens_data(); }
+    void readCurrentValue();
+    void skipCurrentValue();
+    void errors_data();
+    void errors();
+    void prematureEnd();
+};
+
+// Returns a compact textual form of the tokens in the document, for example
+// "{ name:a s:b }", stopping at the first error.
+static QString tokenString(QJsonStreamReader &reader)
+{
+    QStringList result;
+    do {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::StartObject:
+            result << "{";
+            break;
+        case QJsonStreamReader::EndObject:
+            result << "}";
+            break;
+        case QJsonStreamReader::StartArray:
+            result << "[";
+            break;
+        case QJsonStreamReader::EndArray:
+            result << "]";
+            break;
+        case QJsonStreamReader::Name:
+            result << "name:" + reader.text();
+            break;
+        case QJsonStreamReader::String:
+            result << "s:" + reader.text();
+            break;
+        case QJsonStreamReader::Number:
+            if (reader.isInteger())
+                result << "i:" + QString::number(reader.toInteger());
+            else
+                result << "d:" + QString::number(reader.toDouble());
+            break;
+        case QJsonStreamReader::Bool:
+            result << (reader.toBool() ? "true" : "false");
+            break;
+        case QJsonStreamReader::Null:
+            result << "null";
+            break;
+        case QJsonStreamReader::EndDocument:
+            break;
+        case QJsonStreamReader::NoToken:
+        case QJsonStreamReader::Invalid:
+            result << "error";
+            break;
+        }
+    } while (!reader.atEnd());
+    return result.join(u' ');
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty-array") << QByteArray("[]") << "[ ]";
+    QTest::newRow("empty-object") << QByteArray("{}") << "{ }";
+    QTest::newRow("whitespace") << QByteArray(" \t\r\n[ \n]\n ") << "[ ]";
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbf[1]") << "[ i:1 ]";
+    QTest::newRow("literals") << QByteArray("[true,false,null]") << "[ true false null ]";
+    QTest::newRow("integers")
+            << QByteArray("[0,-1,42,9223372036854775807,-9223372036854775808]")
+            << "[ i:0 i:-1 i:42 i:9223372036854775807 i:-9223372036854775808 ]";
+    QTest::newRow("doubles") << QByteArray("[1.5,-0.25,1e3,2.0,1E-2]")
+                             << "[ d:1.5 d:-0.25 i:1000 i:2 d:0.01 ]";
+    QTest::newRow("strings") << QByteArray(R"(["","abc","\"\\\/\b\f\n\r\t","\u00e9\ud83d\ude00"])")
+                             << QString::fromUtf8("[ s: s:abc s:\"\\/\b\f\n\r\t s:é😀 ]");
+    QTest::newRow("utf8") << QByteArray("[\"\xc3\xa9t\xc3\xa9\"]") << QString::fromUtf8("[ s:été ]");
+    QTest::newRow("object")
+            << QByteArray(R"({"a": 1, "b": [true, {"c": null}], "d": {}})")
+            << "{ name:a i:1 name:b [ true { name:c null } ] name:d { } }";
+    QTest::newRow("nested-arrays") << QByteArray("[[[]],[[1]]]") << "[ [ [ ] ] [ [ i:1 ] ] ]";
+
+    QByteArray records = "[";
+    QString recordTokens = "[";
+    for (int i = 0; i < 1000; ++i) {
+        if (i)
+            records += ',';
+        records += "{\"id\":" + QByteArray::number(i) + ",\"name\":\"record " + QByteArray::number(i) + "\"}";
+        recordTokens += QString(" { name:id i:%1 name:name s:record %1 }").arg(i);
+    }
+    records += ']';
+    recordTokens += " ]";
+    QTest::newRow("records") << records << recordTokens;
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(tokenString(reader), expected);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+    QCOMPARE(reader.depth(), 0);
+    QVERIFY(reader.atEnd());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::incremental()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    // feed one byte at a time, so every token is interrupted at every
+    // possible point
+    QJsonStreamReader reader;
+    QStringList result;
+    qsizetype fed = 0;
+    for (;;) {
+        QString tokens = tokenString(reader);
+        // drop the marker for the premature end
+        if (tokens == QLatin1String("error"))
+            tokens.clear();
+        else if (tokens.endsWith(QLatin1String(" error")))
+            tokens.chop(6);
+        if (!tokens.isEmpty())
+            result << tokens;
+        if (reader.tokenType() == QJsonStreamReader::EndDocument)
+            break;
+        QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+        QCOMPARE(reader.parseError(), QJsonParseError::NoError);
+        QVERIFY(fed < json.size());
+        reader.addData(json.mid(fed++, 1));
+    }
+
+    QCOMPARE(result.join(u' '), expected);
+}
+
+void tst_QJsonStreamReader::device()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QCOMPARE(tokenString(reader), expected);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+// A random-access device that generates "[0,0,...,0]" and remembers the
+// largest read it was asked for
+class ZeroArrayDevice : public QIODevice
+{
+public:
+    explicit ZeroArrayDevice(qint64 count) : count(count) {}
+
+    qint64 size() const override { return 2 * count + 1; }
+    qint64 largestRead = 0;
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override
+    {
+        largestRead = qMax(largestRead, maxlen);
+        const qint64 start = pos();
+        const qint64 n = qMin(maxlen, size() - start);
+        for (qint64 i = 0; i < n; ++i) {
+            const qint64 offset = start + i;
+            if (offset == 0)
+                data[i] = '[';
+            else if (offset == size() - 1)
+                data[i] = ']';
+            else
+                data[i] = offset % 2 ? '0' : ',';
+        }
+        return n;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    qint64 count;
+};
+
+void tst_QJsonStreamReader::largeDevice()
+{
+    // the reader must read a large file in chunks, not all at once
+    constexpr qint64 Count = 8 * 1024 * 1024;
+    ZeroArrayDevice device(Count);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(device.bytesAvailable() > 16 * 1024 * 1024);
+
+    QJsonStreamReader reader(&device);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    qint64 numbers = 0;
+    while (reader.readNext() == QJsonStreamReader::Number)
+        ++numbers;
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QCOMPARE(numbers, Count);
+    QVERIFY2(device.largestRead <= 1024 * 1024,
+             QByteArray::number(device.largestRead).constData());
+}
+
+void tst_QJsonStreamReader::longStringInPieces()
+{
+    // a string that arrives in many pieces, with escapes split across them
+    QString expected;
+    QByteArray json = "[\"";
+    for (int i = 0; i < 20000; ++i) {
+        expected += QStringView(u"abc\"\u00e9");
+        json += "abc\\\"\\u00e9";
+    }
+    json += "\"]";
+
+    QJsonStreamReader reader;
+    qsizetype fed = 0;
+    QJsonStreamReader::TokenType type = reader.readNext();
+    while (type != QJsonStreamReader::String) {
+        QCOMPARE(reader.error(), type == QJsonStreamReader::Invalid
+                 ? QJsonStreamReader::PrematureEndOfDocumentError : QJsonStreamReader::NoError);
+        QVERIFY(fed < json.size());
+        reader.addData(json.mid(fed, 7));
+        fed += 7;
+        type = reader.readNext();
+    }
+    QCOMPARE(reader.text(), expected);
+}
+
+void tst_QJsonStreamReader::readCurrentValue()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QJsonStreamReader reader(json);
+    reader.readNext();
+    const QJsonValue value = reader.readCurrentValue();
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+    if (doc.isArray())
+        QCOMPARE(value, doc.array());
+    else
+        QCOMPARE(value, doc.object());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::skipCurrentValue()
+{
+    QJsonStreamReader reader(QByteArray(R"([{"a": [1, {"b": []}]}, [[2]], "x", 3])"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.depth(), 2);
+    QVERIFY(reader.skipCurrentValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(reader.skipCurrentValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QVERIFY(reader.skipCurrentValue());
+    QCOMPARE(reader.text(), "x");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.value(), QJsonValue(3));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("scalar-document") << QByteArray("1");
+    QTest::newRow("string-document") << QByteArray("\"a\"");
+    QTest::newRow("missing-name-separator") << QByteArray(R"({"a" 1})");
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]");
+    QTest::newRow("missing-member-separator") << QByteArray(R"({"a":1 "b":2})");
+    QTest::newRow("trailing-comma-array") << QByteArray("[1,]");
+    QTest::newRow("trailing-comma-object") << QByteArray(R"({"a":1,})");
+    QTest::newRow("leading-comma-array") << QByteArray("[,1]");
+    QTest::newRow("leading-comma-object") << QByteArray("{,}");
+    QTest::newRow("unquoted-name") << QByteArray("{a:1}");
+    QTest::newRow("bad-literal") << QByteArray("[tru]");
+    QTest::newRow("bad-number") << QByteArray("[-]");
+    QTest::newRow("bad-escape") << QByteArray(R"(["\u12"])");
+    QTest::newRow("bad-utf8") << QByteArray("[\"\xff\"]");
+    QTest::newRow("garbage-at-end") << QByteArray("[1] x");
+    QTest::newRow("deep-nesting") << QByteArray(1025, '[') + QByteArray(1025, ']');
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError expected;
+    QJsonDocument::fromJson(json, &expected);
+    QVERIFY(expected.error != QJsonParseError::NoError);
+
+    QJsonStreamReader reader(json);
+    tokenString(reader);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.parseError(), expected.error);
+    QCOMPARE(reader.errorString(), expected.errorString());
+
+    // errors are sticky
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    reader.clear();
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+void tst_QJsonStreamReader::prematureEnd()
+{
+    QJsonStreamReader reader(QByteArray(R"({"key": "val)"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    QVERIFY(reader.atEnd());
+    QCOMPARE(reader.offset(), 8);
+
+    // nothing changes until there's more data
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+
+    reader.addData("ue\", \"n\": 12");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), "value");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    // the number could still continue
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.addData("34}");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 1234);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStreamReader)
+
+#include "tst_qjsonstreamreader.moc"
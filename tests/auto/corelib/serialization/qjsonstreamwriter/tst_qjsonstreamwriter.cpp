@@ -0,0 +1,232 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamWriter>
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void values_data();
+    void values();
+    void device_data() { values_data(); }
+    void device();
+    void streamedContainers_data() { values_data(); }
+    void streamedContainers();
+    void multipleDocuments();
+    void mismatchedEnds();
+    void nonStringName();
+    void largeDocument();
+};
+
+void tst_QJsonStreamWriter::values_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+
+    QTest::newRow("emptyArray") << QJsonValue(QJsonArray());
+    QTest::newRow("emptyObject") << QJsonValue(QJsonObject());
+    QTest::newRow("numbers") << QJsonValue(QJsonArray{ 0, -1, 1.5, 1e300, qint64(1) << 60,
+                                                       std::numeric_limits<double>::infinity() });
+    QTest::newRow("literals") << QJsonValue(QJsonArray{ true, false, QJsonValue::Null });
+    QTest::newRow("strings") << QJsonValue(QJsonArray{ "", "plain", "\"quoted\"\\", "tab\tnewline\n",
+                                                       QStringView(u"é中\U0001f600").toString(),
+                                                       QStringView(u"\u0001\u001f").toString() });
+    QTest::newRow("object") << QJsonValue(QJsonObject{ { "a", 1 }, { "b", "text" },
+                                                       { "c", QJsonValue::Null },
+                                                       { "needs \"escaping\"", true } });
+    QTest::newRow("nested") << QJsonValue(QJsonObject{
+            { "array", QJsonArray{ 1, QJsonArray{}, QJsonObject{}, QJsonArray{ QJsonArray{ 2 } } } },
+            { "object", QJsonObject{ { "inner", QJsonObject{ { "x", 1 } } }, { "empty", QJsonObject{} } } },
+    });
+}
+
+static QByteArray expectedJson(const QJsonValue &value, QJsonDocument::JsonFormat format)
+{
+    return value.isArray() ? QJsonDocument(value.toArray()).toJson(format)
+                           : QJsonDocument(value.toObject()).toJson(format);
+}
+
+void tst_QJsonStreamWriter::values()
+{
+    QFETCH(QJsonValue, value);
+
+    for (auto format : { QJsonDocument::Indented, QJsonDocument::Compact }) {
+        QByteArray output;
+        QJsonStreamWriter writer(&output, format);
+        writer.append(value);
+        QCOMPARE(output, expectedJson(value, format));
+    }
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QFETCH(QJsonValue, value);
+
+    for (auto format : { QJsonDocument::Indented, QJsonDocument::Compact }) {
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QJsonStreamWriter writer(&buffer, format);
+        QCOMPARE(writer.device(), &buffer);
+        writer.append(value);
+        QVERIFY(!writer.hasError());
+        // the document is complete, so it must have been written out already
+        QCOMPARE(buffer.data(), expectedJson(value, format));
+    }
+}
+
+// Writes the value with the start and end calls instead of append(QJsonValue).
+static void writeStreamed(QJsonStreamWriter &writer, const QJsonValue &value)
+{
+    if (value.isArray()) {
+        writer.startArray();
+        for (const QJsonValue &v : value.toArray())
+            writeStreamed(writer, v);
+        QVERIFY(writer.endArray());
+    } else if (value.isObject()) {
+        writer.startObject();
+        const QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            writer.append(it.key());
+            writeStreamed(writer, it.value());
+        }
+        QVERIFY(writer.endObject());
+    } else {
+        writer.append(value);
+    }
+}
+
+void tst_QJsonStreamWriter::streamedContainers()
+{
+    QFETCH(QJsonValue, value);
+
+    for (auto format : { QJsonDocument::Indented, QJsonDocument::Compact }) {
+        QByteArray output;
+        QJsonStreamWriter writer(&output, format);
+        writeStreamed(writer, value);
+        QCOMPARE(output, expectedJson(value, format));
+    }
+}
+
+void tst_QJsonStreamWriter::multipleDocuments()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output, QJsonDocument::Compact);
+    writer.startObject();
+    writer.append("a");
+    writer.append(1);
+    writer.endObject();
+    writer.startArray();
+    writer.append(nullptr);
+    writer.endArray();
+    QCOMPARE(output, "{\"a\":1}\n[null]");
+
+    output.clear();
+    writer.setFormat(QJsonDocument::Indented);
+    writer.startArray();
+    writer.endArray();
+    writer.startArray();
+    writer.append(u"x");
+    writer.endArray();
+    QCOMPARE(output, "[\n]\n[\n    \"x\"\n]\n");
+}
+
+void tst_QJsonStreamWriter::mismatchedEnds()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output, QJsonDocument::Compact);
+    QVERIFY(!writer.endArray());
+    QVERIFY(!writer.endObject());
+
+    writer.startArray();
+    QVERIFY(!writer.endObject());
+    writer.startObject();
+    QVERIFY(!writer.endArray());
+    writer.append("name");
+    QVERIFY(!writer.endObject());       // the value is missing
+    writer.append(false);
+    QVERIFY(writer.endObject());
+    QVERIFY(writer.endArray());
+    QVERIFY(!writer.endArray());
+    QCOMPARE(output, "[{\"name\":false}]");
+}
+
+void tst_QJsonStreamWriter::nonStringName()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output, QJsonDocument::Compact);
+    writer.startObject();
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: object member names must be strings");
+    writer.append(42);
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: object member names must be strings");
+    writer.startArray();
+    writer.append(QLatin1StringView("n"));
+    writer.append(42);
+    QVERIFY(writer.endObject());
+    QCOMPARE(output, "{\"n\":42}");
+}
+
+void tst_QJsonStreamWriter::largeDocument()
+{
+    constexpr int Count = 100000;
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    QJsonArray expected;
+    {
+        QJsonStreamWriter writer(&buffer);
+        writer.startArray();
+        for (int i = 0; i < Count; ++i) {
+            writer.startObject();
+            writer.append(u"id");
+            writer.append(i);
+            writer.append(u"name");
+            writer.append(QString::number(i, 16));
+            writer.endObject();
+            expected.append(QJsonObject{ { "id", i }, { "name", QString::number(i, 16) } });
+
+            if (i == Count / 2) {
+                // data is written out as the document grows
+                QVERIFY(buffer.size() > 0);
+            }
+        }
+        writer.endArray();
+        QVERIFY(!writer.hasError());
+    }
+    QCOMPARE(buffer.data(), QJsonDocument(expected).toJson());
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStreamWriter)
+
+#include "tst_qjsonstreamwriter.moc"
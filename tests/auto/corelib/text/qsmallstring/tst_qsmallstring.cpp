@@ -0,0 +1,208 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QHash>
+#include <QSmallString>
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data();
+    void construct();
+    void fromString();
+    void copyAndMove();
+    void append();
+    void appendSelf();
+    void compare();
+    void hash();
+    void byteArray();
+};
+
+void tst_QSmallString::construct_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("short") << QStringLiteral("key");
+    QTest::newRow("capacity") << QString(QSmallString::InlineCapacity, u'x');
+    QTest::newRow("capacity+1") << QString(QSmallString::InlineCapacity + 1, u'x');
+    QTest::newRow("long") << QStringLiteral("a string that is much too long to be stored inline");
+}
+
+void tst_QSmallString::construct()
+{
+    QFETCH(QString, string);
+
+    QSmallString s(QStringView{string});
+    QCOMPARE(s.isInline(), string.size() <= QSmallString::InlineCapacity);
+    QCOMPARE(s.size(), string.size());
+    QCOMPARE(s.isEmpty(), string.isEmpty());
+    QCOMPARE(s.view(), QStringView(string));
+    QCOMPARE(s.toString(), string);
+    QCOMPARE(s.data()[s.size()], u'\0');
+    QCOMPARE(s.end() - s.begin(), string.size());
+
+    s.clear();
+    QVERIFY(s.isInline());
+    QVERIFY(s.isEmpty());
+}
+
+void tst_QSmallString::fromString()
+{
+    const QString shortString = QStringLiteral("short");
+    QSmallString s = shortString;
+    QVERIFY(s.isInline());
+    QCOMPARE(s.view(), shortString);
+
+    // long strings share the QString's data
+    const QString longString(100, u'y');
+    QSmallString l = longString;
+    QVERIFY(!l.isInline());
+    QCOMPARE(l.data(), reinterpret_cast<const char16_t *>(longString.constData()));
+    QCOMPARE(l.toString().constData(), longString.constData());
+}
+
+void tst_QSmallString::copyAndMove()
+{
+    QSmallString s(u"inline");
+    QSmallString l(QStringView(u"this one is stored on the heap"));
+
+    QSmallString copy = s;
+    QCOMPARE(copy, s);
+    QVERIFY(copy.data() != s.data());
+
+    QSmallString copyL = l;
+    QCOMPARE(copyL, l);
+    QCOMPARE(copyL.data(), l.data());
+
+    QSmallString moved = std::move(copyL);
+    QCOMPARE(moved, l);
+    QVERIFY(copyL.isEmpty());
+
+    moved = s;
+    QCOMPARE(moved, s);
+    QVERIFY(moved.isInline());
+
+    moved = std::move(l);
+    QCOMPARE(moved.view(), u"this one is stored on the heap");
+
+    s.swap(moved);
+    QCOMPARE(moved.view(), u"inline");
+    QCOMPARE(s.view(), u"this one is stored on the heap");
+}
+
+void tst_QSmallString::append()
+{
+    QSmallString s;
+    s.append(u"abc");
+    s += u"def";
+    QVERIFY(s.isInline());
+    QCOMPARE(s.view(), u"abcdef");
+
+    while (s.size() + 6 <= QSmallString::InlineCapacity)
+        s += u"abcdef";
+    QVERIFY(s.isInline());
+    const QString expected = s.toString() + QStringLiteral("0123456789");
+    s += u"0123456789";
+    QVERIFY(!s.isInline());
+    QCOMPARE(s.toString(), expected);
+
+    s += u"!";
+    QCOMPARE(s.toString(), expected + QLatin1Char('!'));
+}
+
+void tst_QSmallString::appendSelf()
+{
+    QSmallString s(u"0123456789");
+    s.append(s.view());
+    QVERIFY(!s.isInline());
+    QCOMPARE(s.view(), u"01234567890123456789");
+
+    QSmallString t(u"abc");
+    t.append(t.view());
+    QCOMPARE(t.view(), u"abcabc");
+}
+
+void tst_QSmallString::compare()
+{
+    const QSmallString a(u"apple");
+    const QSmallString b(u"banana");
+    const QSmallString l(QStringView(u"a very long string which is not inline"));
+
+    QVERIFY(a == QSmallString(u"apple"));
+    QVERIFY(a != b);
+    QVERIFY(a < b);
+    QVERIFY(a <= b);
+    QVERIFY(b > a);
+    QVERIFY(b >= a);
+    QVERIFY(l < a);
+    QVERIFY(l == QSmallString(l.toString()));
+    QVERIFY(a == QStringLiteral("apple"));
+    QVERIFY(a == u"apple");
+}
+
+void tst_QSmallString::hash()
+{
+    const QString key = QStringLiteral("key");
+    QCOMPARE(qHash(QSmallString(key)), qHash(key));
+    QCOMPARE(qHash(QSmallString(key), 42), qHash(key, 42));
+
+    QHash<QSmallString, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(QString::number(i), i);
+    QCOMPARE(hash.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(QString::number(i), -1), i);
+    QCOMPARE(hash.value(QStringLiteral("1000"), -1), -1);
+}
+
+void tst_QSmallString::byteArray()
+{
+    QSmallByteArray s("short");
+    QVERIFY(s.isInline());
+    QCOMPARE(s.view(), "short");
+    QCOMPARE(s.toByteArray(), QByteArray("short"));
+    QCOMPARE(s.data()[s.size()], '\0');
+    QCOMPARE(qHash(s, 7), qHash(QByteArray("short"), 7));
+
+    const QByteArray full(QSmallByteArray::InlineCapacity, 'x');
+    QVERIFY(QSmallByteArray(full).isInline());
+    s.append(full);
+    QVERIFY(!s.isInline());
+    QCOMPARE(s.toByteArray(), "short" + full);
+
+    QVERIFY(QSmallByteArray("abc") < QSmallByteArray("abd"));
+    QVERIFY(QSmallByteArray("\xff") > QSmallByteArray("a"));
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+#include "tst_qsmallstring.moc"
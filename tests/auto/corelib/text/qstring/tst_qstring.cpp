@@ -533,6 +533,7 @@ private slots:
     void fromLatin1Roundtrip();
     void toLatin1Roundtrip_data();
     void toLatin1Roundtrip();
+    void vectorizedTails();
     void fromLatin1();
     void fromUcs4();
     void toUcs4();
@@ -5013,6 +5014,52 @@ void tst_QString::toLatin1Roundtrip()
     s.clear();
 }
 
+void tst_QString::vectorizedTails()
+{
+    // The SIMD kernels handle blocks of 8 to 32 characters and may overlap
+    // the last block with the previous one; check every length and position
+    // around those block sizes.
+    for (int size = 0; size <= 100; ++size) {
+        QByteArray latin1(size, Qt::Uninitialized);
+        QByteArray ascii(size, Qt::Uninitialized);
+        QString expected(size, Qt::Uninitialized);
+        for (int i = 0; i < size; ++i) {
+            latin1[i] = char(0x20 + (i * 7) % 0xe0);
+            ascii[i] = char(0x20 + i % 0x5f);
+            expected[i] = QChar(uchar(latin1.at(i)));
+        }
+
+        const QString str = QString::fromLatin1(latin1);
+        QCOMPARE(str, expected);
+        QCOMPARE(str.toLatin1(), latin1);
+        QCOMPARE(str.indexOf(QChar(0x20AC)), -1);
+        QCOMPARE(str.compare(QString(str.constData(), str.size())), 0);
+
+        const QString asciiStr = QString::fromUtf8(ascii);
+        QCOMPARE(asciiStr, QString::fromLatin1(ascii));
+        QCOMPARE(asciiStr.toUtf8(), ascii);
+
+        for (int pos = 0; pos < size; ++pos) {
+            QString modified = str;
+            modified[pos] = QChar(0x20AC);
+            QByteArray replaced = latin1;
+            replaced[pos] = '?';
+            QCOMPARE(modified.toLatin1(), replaced);
+            QCOMPARE(modified.indexOf(QChar(0x20AC)), pos);
+            QVERIFY(modified.compare(str) > 0);
+            QVERIFY(str.compare(modified) < 0);
+
+            // US-ASCII with a single multi-byte sequence
+            QString modifiedAscii = asciiStr;
+            modifiedAscii[pos] = QChar(0x20AC);
+            const QByteArray utf8 = modifiedAscii.toUtf8();
+            QCOMPARE(utf8.size(), size + 2);
+            QCOMPARE(utf8.indexOf("\xe2\x82\xac"), pos);
+            QCOMPARE(QString::fromUtf8(utf8), modifiedAscii);
+        }
+    }
+}
+
 void tst_QString::fromLatin1()
 {
     QString a;
@@ -0,0 +1,250 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QConcurrentQueue>
+#include <QThread>
+
+#include <memory>
+
+#include "../../../../shared/containertesthelpers.h"
+
+class tst_QConcurrentQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void capacity();
+    void tryPushPop();
+    void moveOnly();
+    void destroysItems();
+    void throwingConstructor();
+    void mpmc();
+    void spsc();
+    void blockingPop();
+    void blockingPush();
+};
+
+using namespace QTestContainerHelpers;
+
+void tst_QConcurrentQueue::capacity()
+{
+    QCOMPARE(QConcurrentQueue<int>(1).capacity(), 2);
+    QCOMPARE(QConcurrentQueue<int>(16).capacity(), 16);
+    QCOMPARE(QConcurrentQueue<int>(17).capacity(), 32);
+    QCOMPARE(QSpscQueue<int>(100).capacity(), 128);
+}
+
+void tst_QConcurrentQueue::tryPushPop()
+{
+    QConcurrentQueue<QString> queue(4);
+    QVERIFY(queue.isEmpty());
+    QString value;
+    QVERIFY(!queue.tryPop(value));
+
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(queue.tryPush(QString::number(i)));
+    QVERIFY(!queue.tryPush(QStringLiteral("full")));
+    QCOMPARE(queue.size(), 4);
+
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(queue.tryPop(value));
+        QCOMPARE(value, QString::number(i));
+    }
+    QVERIFY(!queue.tryPop(value));
+
+    // wrap around several times
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(queue.tryPush(QString::number(i)));
+        QCOMPARE(queue.pop(), QString::number(i));
+    }
+
+    QSpscQueue<int> spsc(4);
+    int n;
+    QVERIFY(!spsc.tryPop(n));
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(spsc.tryPush(i));
+    QVERIFY(!spsc.tryPush(4));
+    QCOMPARE(spsc.size(), 4);
+    for (int i = 0; i < 4; ++i)
+        QCOMPARE(spsc.pop(), i);
+    QVERIFY(spsc.isEmpty());
+}
+
+void tst_QConcurrentQueue::moveOnly()
+{
+    QConcurrentQueue<std::unique_ptr<int>> queue(2);
+    auto p = std::make_unique<int>(42);
+    QVERIFY(queue.tryPush(std::move(p)));
+    QVERIFY(!p);
+    QVERIFY(queue.tryPush(std::make_unique<int>(43)));
+
+    // a failed push leaves the value alone
+    auto q = std::make_unique<int>(44);
+    QVERIFY(!queue.tryPush(std::move(q)));
+    QVERIFY(q);
+
+    QCOMPARE(*queue.pop(), 42);
+    std::unique_ptr<int> r;
+    QVERIFY(queue.tryPop(r));
+    QCOMPARE(*r, 43);
+
+    QSpscQueue<std::unique_ptr<int>> spsc(2);
+    spsc.push(std::move(q));
+    QCOMPARE(*spsc.pop(), 44);
+}
+
+void tst_QConcurrentQueue::destroysItems()
+{
+    {
+        QConcurrentQueue<Counted> queue(8);
+        for (int i = 0; i < 5; ++i)
+            queue.push(Counted(i));
+        QCOMPARE(Counted::instances, 5);
+        QCOMPARE(queue.pop().v, 0);
+        QCOMPARE(Counted::instances, 4);
+
+        QSpscQueue<Counted> spsc(8);
+        spsc.push(Counted(1));
+        QCOMPARE(Counted::instances, 5);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+void tst_QConcurrentQueue::throwingConstructor()
+{
+#ifdef QT_NO_EXCEPTIONS
+    QSKIP("This test requires exception support");
+#else
+    struct Throwing
+    {
+        int v = 0;
+        Throwing(int v) : v(v) {}
+        Throwing(const Throwing &other) : v(other.v) { if (v < 0) throw 42; }
+        Throwing &operator=(const Throwing &) = default;
+    };
+
+    QConcurrentQueue<Throwing> queue(4);
+    queue.push(Throwing(1));
+    QVERIFY_THROWS_EXCEPTION(int, queue.push(Throwing(-1)));
+    queue.push(Throwing(2));
+
+    // the cell claimed by the failed push is skipped, not waited for
+    QCOMPARE(queue.pop().v, 1);
+    QCOMPARE(queue.pop().v, 2);
+    Throwing value(0);
+    QVERIFY(!queue.tryPop(value));
+
+    // wrap around past the abandoned cell
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(queue.tryPush(Throwing(i)));
+        QCOMPARE(queue.pop().v, i);
+    }
+#endif
+}
+
+void tst_QConcurrentQueue::mpmc()
+{
+    constexpr int Producers = 4;
+    constexpr int Consumers = 4;
+    constexpr int PerProducer = 50000;
+
+    QConcurrentQueue<int> queue(64);
+    QAtomicInteger<qint64> sum = 0;
+    QAtomicInt received = 0;
+    QVERIFY(runInThreads(Producers + Consumers, [&](int thread) {
+        if (thread < Producers) {
+            for (int i = 1; i <= PerProducer; ++i)
+                queue.push(i);
+        } else {
+            // each consumer takes its share, some with tryPop
+            qint64 local = 0;
+            for (int i = 0; i < Producers * PerProducer / Consumers; ++i) {
+                int value;
+                if (i % 2 && queue.tryPop(value))
+                    local += value;
+                else
+                    local += queue.pop();
+            }
+            sum.fetchAndAddRelaxed(local);
+            received.fetchAndAddRelaxed(Producers * PerProducer / Consumers);
+        }
+    }));
+    QCOMPARE(received.loadRelaxed(), Producers * PerProducer);
+    QCOMPARE(sum.loadRelaxed(), qint64(Producers) * PerProducer * (PerProducer + 1) / 2);
+    QVERIFY(queue.isEmpty());
+}
+
+void tst_QConcurrentQueue::spsc()
+{
+    constexpr int Count = 200000;
+    QSpscQueue<int> queue(16);
+    bool ordered = true;
+    QVERIFY(runInThreads(2, [&](int thread) {
+        if (thread == 0) {
+            for (int i = 0; i < Count; ++i)
+                queue.push(i);
+        } else {
+            for (int i = 0; i < Count; ++i) {
+                if (queue.pop() != i)
+                    ordered = false;
+            }
+        }
+    }));
+    QVERIFY(ordered);
+    QVERIFY(queue.isEmpty());
+}
+
+void tst_QConcurrentQueue::blockingPop()
+{
+    QConcurrentQueue<int> queue(4);
+    int popped = 0;
+    std::unique_ptr<QThread> consumer(QThread::create([&] { popped = queue.pop(); }));
+    consumer->start();
+    QVERIFY(!consumer->wait(50));
+    queue.push(7);
+    QVERIFY(consumer->wait());
+    QCOMPARE(popped, 7);
+}
+
+void tst_QConcurrentQueue::blockingPush()
+{
+    QSpscQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+    std::unique_ptr<QThread> producer(QThread::create([&] { queue.push(3); }));
+    producer->start();
+    QVERIFY(!producer->wait(50));
+    QCOMPARE(queue.pop(), 1);
+    QVERIFY(producer->wait());
+    QCOMPARE(queue.pop(), 2);
+    QCOMPARE(queue.pop(), 3);
+}
+
+QTEST_MAIN(tst_QConcurrentQueue)
+#include "tst_qconcurrentqueue.moc"
@@ -108,6 +108,8 @@ private slots:
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
     void threadReuse();
+    void startFromPoolThread();
+    void recursiveStart();
 
 private:
     QMutex m_functionTestMutex;
@@ -1460,5 +1462,80 @@ void tst_QThreadPool::threadReuse()
     }
 }
 
+void tst_QThreadPool::startFromPoolThread()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    QSemaphore spawned;
+    QSemaphore go;
+    QMutex orderMutex;
+    QStringList order;
+    const auto record = [&](const QString &name) {
+        return [&, name]() {
+            QMutexLocker locker(&orderMutex);
+            order.append(name);
+        };
+    };
+
+    QRunnable *taken = QRunnable::create(record(QStringLiteral("taken")));
+    taken->setAutoDelete(false);
+    threadPool.start([&]() {
+        // the pool is saturated, so these stay on this thread
+        threadPool.start(record(QStringLiteral("local1")));
+        threadPool.start(taken);
+        threadPool.start(record(QStringLiteral("local2")));
+        spawned.release();
+        go.acquire();
+    });
+    QVERIFY(spawned.tryAcquire(1, 10000));
+
+    // tasks queued on a busy thread can still be taken back
+    QVERIFY(threadPool.tryTake(taken));
+    delete taken;
+
+    // a higher priority goes before the tasks queued locally
+    threadPool.start(record(QStringLiteral("urgent")), 1);
+    go.release();
+    QVERIFY(threadPool.waitForDone(10000));
+
+    QCOMPARE(order, QStringList({ QStringLiteral("urgent"), QStringLiteral("local1"),
+                                  QStringLiteral("local2") }));
+}
+
+void tst_QThreadPool::recursiveStart()
+{
+    struct SpawningRunnable : public QRunnable
+    {
+        SpawningRunnable(QThreadPool *pool, int depth, QAtomicInt *leaves)
+            : pool(pool), depth(depth), leaves(leaves) { }
+
+        void run() override
+        {
+            if (depth == 0) {
+                leaves->ref();
+                return;
+            }
+            pool->start(new SpawningRunnable(pool, depth - 1, leaves));
+            pool->start(new SpawningRunnable(pool, depth - 1, leaves));
+        }
+
+        QThreadPool *pool;
+        int depth;
+        QAtomicInt *leaves;
+    };
+
+    const int depth = 12;
+    for (int threadCount : { 1, 2, 4, 8 }) {
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(threadCount);
+        QAtomicInt leaves;
+        threadPool.start(new SpawningRunnable(&threadPool, depth, &leaves));
+        QVERIFY(threadPool.waitForDone(60000));
+        QCOMPARE(leaves.loadRelaxed(), 1 << depth);
+        QCOMPARE(threadPool.activeThreadCount(), 0);
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QArenaScope>
+#include <QList>
+#include <QThread>
+
+class tst_QArenaScope : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void current();
+    void allocatesFromArena();
+    void largeBlocks();
+    void dataOutlivesScope();
+    void growthAfterScope();
+    void reservedCapacity();
+    void nestedScopes();
+    void freeOnOtherThread();
+    void flagsAreNotTrusted();
+};
+
+void tst_QArenaScope::current()
+{
+    QCOMPARE(QArenaScope::current(), nullptr);
+    {
+        QArenaScope arena(1000);
+        QCOMPARE(QArenaScope::current(), &arena);
+        QCOMPARE(arena.chunkSize(), 4096);
+        QCOMPARE(arena.bytesAllocated(), 0);
+    }
+    QCOMPARE(QArenaScope::current(), nullptr);
+}
+
+void tst_QArenaScope::allocatesFromArena()
+{
+    QArenaScope arena;
+    QString s = QStringLiteral("hello, ") + QString::number(42);
+    const qsizetype afterString = arena.bytesAllocated();
+    QVERIFY(afterString > 0);
+
+    QByteArray ba = s.toUtf8();
+    QVERIFY(arena.bytesAllocated() > afterString);
+
+    QList<QString> list;
+    for (int i = 0; i < 1000; ++i)
+        list.append(QString::number(i));
+    QCOMPARE(list.size(), 1000);
+    QCOMPARE(list.at(999), QLatin1String("999"));
+    QCOMPARE(s, QLatin1String("hello, 42"));
+    QCOMPARE(ba, "hello, 42");
+    QVERIFY(arena.bytesAllocated() > 1000 * 16);
+}
+
+void tst_QArenaScope::largeBlocks()
+{
+    QArenaScope arena(4096);
+    QByteArray big(4096, 'x');
+    QCOMPARE(arena.bytesAllocated(), 0);
+    QByteArray small(16, 'x');
+    QVERIFY(arena.bytesAllocated() > 0);
+    QCOMPARE(big.count('x'), 4096);
+}
+
+void tst_QArenaScope::dataOutlivesScope()
+{
+    QString escaped;
+    QList<QByteArray> escapedList;
+    QString shared;
+    {
+        QArenaScope arena(4096);
+        QString local;
+        for (int i = 0; i < 200; ++i) {
+            local = QString::number(i).repeated(10);
+            if (i == 100)
+                escaped = local;
+            escapedList.append(local.toLatin1());
+        }
+        shared = escaped;
+        QVERIFY(shared.isSharedWith(escaped));
+    }
+    // the chunks are still alive and the data is still shared
+    QCOMPARE(escaped, QString::number(100).repeated(10));
+    QVERIFY(shared.isSharedWith(escaped));
+    QCOMPARE(escapedList.size(), 200);
+    QCOMPARE(escapedList.at(150), QByteArray::number(150).repeated(10));
+
+    // detaching copies the data out
+    shared[0] = u'X';
+    QVERIFY(!shared.isSharedWith(escaped));
+    QCOMPARE(escaped.at(0), u'1');
+    QCOMPARE(shared.at(0), u'X');
+
+    escapedList.clear();
+    escaped.clear();
+}
+
+void tst_QArenaScope::growthAfterScope()
+{
+    QByteArray ba;
+    QList<int> list;
+    {
+        QArenaScope arena;
+        ba = "abc";
+        list = { 1, 2, 3 };
+        ba.append('d');
+        list.append(4);
+    }
+    // arena blocks can't be reallocated in place; growing moves them
+    for (int i = 0; i < 10000; ++i) {
+        ba.append('e');
+        list.append(i);
+    }
+    QVERIFY(ba.startsWith("abcde"));
+    QCOMPARE(ba.size(), 10004);
+    QCOMPARE(list.first(), 1);
+    QCOMPARE(list.at(3), 4);
+    QCOMPARE(list.size(), 10004);
+}
+
+void tst_QArenaScope::reservedCapacity()
+{
+    QArenaScope arena;
+    QString s;
+    s.reserve(100);
+    s.append(u"abc");
+    const qsizetype capacity = s.capacity();
+    QVERIFY(capacity >= 100);
+    QString copy = s;
+    s.append(u'd');             // detaches and keeps the reserved capacity
+    QCOMPARE(s.capacity(), capacity);
+    s.squeeze();
+    QCOMPARE(s, QLatin1String("abcd"));
+}
+
+void tst_QArenaScope::nestedScopes()
+{
+    QArenaScope outer;
+    QString a = QString::number(1).repeated(8);
+    const qsizetype outerBytes = outer.bytesAllocated();
+    {
+        QArenaScope inner;
+        QCOMPARE(QArenaScope::current(), &inner);
+        QString b = QString::number(2).repeated(8);
+        QVERIFY(inner.bytesAllocated() > 0);
+        QCOMPARE(outer.bytesAllocated(), outerBytes);
+        a += b;
+    }
+    QCOMPARE(QArenaScope::current(), &outer);
+    QCOMPARE(a, QLatin1String("1111111122222222"));
+}
+
+void tst_QArenaScope::freeOnOtherThread()
+{
+    QList<QString> strings;
+    {
+        QArenaScope arena(4096);
+        for (int i = 0; i < 1000; ++i)
+            strings.append(QString::number(i));
+    }
+    QScopedPointer<QThread> thread(QThread::create([strings = std::move(strings)]() mutable {
+        QCOMPARE(strings.at(500), QLatin1String("500"));
+        strings.clear();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+}
+
+void tst_QArenaScope::flagsAreNotTrusted()
+{
+    // Inline code in existing binaries copies all flags of a block to the
+    // blocks it allocates, so they must not decide where a block goes
+    QArenaScope arena;
+    {
+        QByteArray large(QArenaScope::DefaultChunkSize, 'x');
+        large.data_ptr().d_ptr()->flags |= QArrayData::ArrayOption(0x2);
+    }
+    const char *first;
+    {
+        QByteArray small(16, 'x');
+        QVERIFY(arena.bytesAllocated() > 0);
+        first = small.constData();
+        small.data_ptr().d_ptr()->flags = {};
+    }
+    // freeing the last block went to the arena, which rewound the chunk
+    QByteArray again(16, 'y');
+    QCOMPARE(again.constData(), first);
+}
+
+QTEST_MAIN(tst_QArenaScope)
+
+#include "tst_qarenascope.moc"
@@ -0,0 +1,182 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QConcurrentHash>
+#include <QThread>
+
+#include "../../../../shared/containertesthelpers.h"
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void basics();
+    void shardCount();
+    void snapshot();
+    void concurrentInserts();
+    void concurrentUpdates();
+    void readersAndWriters();
+};
+
+using namespace QTestContainerHelpers;
+
+void tst_QConcurrentHash::basics()
+{
+    QConcurrentHash<QString, int> hash;
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(QStringLiteral("a")));
+    QCOMPARE(hash.value(QStringLiteral("a")), 0);
+    QCOMPARE(hash.value(QStringLiteral("a"), -1), -1);
+
+    QVERIFY(hash.insert(QStringLiteral("a"), 1));
+    QVERIFY(!hash.insert(QStringLiteral("a"), 2));
+    QCOMPARE(hash.value(QStringLiteral("a")), 2);
+    QVERIFY(!hash.tryInsert(QStringLiteral("a"), 3));
+    QVERIFY(hash.tryInsert(QStringLiteral("b"), 3));
+    QCOMPARE(hash.size(), 2);
+
+    hash.update(QStringLiteral("a"), [](int &v) { v *= 10; });
+    hash.update(QStringLiteral("c"), [](int &v) { QCOMPARE(v, 0); v = 5; });
+    QCOMPARE(hash.value(QStringLiteral("a")), 20);
+    QCOMPARE(hash.value(QStringLiteral("c")), 5);
+
+    QCOMPARE(hash.take(QStringLiteral("c")), 5);
+    QVERIFY(hash.remove(QStringLiteral("b")));
+    QVERIFY(!hash.remove(QStringLiteral("b")));
+    QCOMPARE(hash.size(), 1);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+}
+
+void tst_QConcurrentHash::shardCount()
+{
+    using Hash = QConcurrentHash<int, int>;
+    QCOMPARE(Hash().shardCount(), Hash::DefaultShardCount);
+    QCOMPARE(Hash(1).shardCount(), 1);
+    QCOMPARE(Hash(5).shardCount(), 8);
+
+    Hash single(1);
+    for (int i = 0; i < 100; ++i)
+        single.insert(i, i);
+    QCOMPARE(single.size(), 100);
+    QCOMPARE(single.value(42), 42);
+}
+
+void tst_QConcurrentHash::snapshot()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+
+    const auto snapshot = hash.snapshot();
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, -i);
+    hash.insert(1000, 1000);
+
+    QCOMPARE(snapshot.size(), 1000);
+    int count = 0;
+    qint64 sum = 0;
+    for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+        QCOMPARE(*it, it.key());
+        sum += it.value();
+        ++count;
+    }
+    QCOMPARE(count, 1000);
+    QCOMPARE(sum, 999 * 1000 / 2);
+
+    const QHash<int, int> merged = hash.snapshot().toHash();
+    QCOMPARE(merged.size(), 1001);
+    QCOMPARE(merged.value(10), -10);
+
+    const auto empty = QConcurrentHash<int, int>().snapshot();
+    QVERIFY(empty.isEmpty());
+    QVERIFY(empty.begin() == empty.end());
+}
+
+void tst_QConcurrentHash::concurrentInserts()
+{
+    QConcurrentHash<int, int> hash;
+    QVERIFY(runInThreads(8, [&](int thread) {
+        for (int i = 0; i < 10000; ++i)
+            hash.insert(thread * 10000 + i, thread);
+    }));
+    QCOMPARE(hash.size(), 80000);
+    for (int i = 0; i < 80000; i += 7)
+        QCOMPARE(hash.value(i, -1), i / 10000);
+}
+
+void tst_QConcurrentHash::concurrentUpdates()
+{
+    QConcurrentHash<int, int> hash(4);
+    QVERIFY(runInThreads(8, [&](int) {
+        for (int i = 0; i < 10000; ++i)
+            hash.update(i % 100, [](int &v) { ++v; });
+    }));
+    QCOMPARE(hash.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(i), 800);
+}
+
+void tst_QConcurrentHash::readersAndWriters()
+{
+    QConcurrentHash<int, QString> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, QString::number(i));
+
+    QAtomicInt mismatches = 0;
+    QVERIFY(runInThreads(8, [&](int thread) {
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < 1000; ++i) {
+                if (thread % 2) {
+                    // writers toggle between two spellings of the same number
+                    if (round % 2)
+                        hash.insert(i, QString::number(i));
+                    else
+                        hash.insert(i, QString::number(i).rightJustified(6, u'0'));
+                } else if (hash.value(i).toInt() != i) {
+                    mismatches.ref();
+                }
+            }
+            if (thread == 0) {
+                const auto snapshot = hash.snapshot();
+                for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+                    if (it.value().toInt() != it.key())
+                        mismatches.ref();
+                }
+            }
+        }
+    }));
+    QCOMPARE(mismatches.loadRelaxed(), 0);
+    QCOMPARE(hash.size(), 1000);
+}
+
+QTEST_MAIN(tst_QConcurrentHash)
+#include "tst_qconcurrenthash.moc"
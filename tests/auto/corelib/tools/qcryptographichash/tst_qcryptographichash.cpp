@@ -32,6 +32,9 @@
 #include <QScopeGuard>
 #include <QCryptographicHash>
 #include <QtCore/QMetaEnum>
+#include <QBuffer>
+#include <QFuture>
+#include <QTemporaryFile>
 
 #if QT_CONFIG(cxx11_future)
 #  include <thread>
@@ -56,6 +59,9 @@ private slots:
     void files();
     void hashLength_data();
     void hashLength();
+    void hashMany_data() { hashLength_data(); }
+    void hashMany();
+    void hashDevice();
     // keep last
     void moreThan4GiBOfData_data();
     void moreThan4GiBOfData();
@@ -426,6 +432,80 @@ void tst_QCryptographicHash::hashLength()
     QCOMPARE(QCryptographicHash::hashLength(algorithm), output.length());
 }
 
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+
+    // lengths around the block boundaries, where the padding changes
+    const int lengths[] = { 0, 1, 55, 56, 63, 64, 65, 111, 112, 119, 120, 127, 128, 129, 1000, 4097 };
+    QByteArrayList inputs;
+    for (int length : lengths) {
+        QByteArray input(length, Qt::Uninitialized);
+        for (int i = 0; i < length; ++i)
+            input[i] = char(i * 7 + length);
+        inputs.append(input);
+    }
+    // messages of different lengths end up in the same pair
+    std::reverse(inputs.begin() + inputs.size() / 2, inputs.end());
+
+    QList<QByteArrayView> views;
+    for (const QByteArray &input : qAsConst(inputs))
+        views.append(input);
+    const QByteArrayList hashes = QCryptographicHash::hashMany(views, algorithm);
+    QCOMPARE(hashes.size(), inputs.size());
+
+    for (int i = 0; i < inputs.size(); ++i) {
+        // feeding one byte at a time never takes the path for complete blocks
+        QCryptographicHash hash(algorithm);
+        for (char c : qAsConst(inputs.at(i)))
+            hash.addData(QByteArrayView(&c, 1));
+        QCOMPARE(hashes.at(i), hash.result());
+        QCOMPARE(QCryptographicHash::hash(inputs.at(i), algorithm), hash.result());
+    }
+
+    QVERIFY(QCryptographicHash::hashMany({}, algorithm).isEmpty());
+}
+
+void tst_QCryptographicHash::hashDevice()
+{
+    QByteArray data(3 * 1024 * 1024 + 17, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 31 + (i >> 13));
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.flush());
+
+    const QList<QCryptographicHash::Algorithm> methods = {
+        QCryptographicHash::Md5, QCryptographicHash::Sha256, QCryptographicHash::Blake2b_512
+    };
+    QByteArrayList expected;
+    for (QCryptographicHash::Algorithm method : methods)
+        expected.append(QCryptographicHash::hash(data, method));
+
+    // the file, starting from the current position
+    QVERIFY(file.seek(0));
+    QCOMPARE(QCryptographicHash::hash(&file, methods), expected);
+    QVERIFY(file.atEnd());
+
+    QVERIFY(file.seek(100));
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    QVERIFY(hash.addData(&file));
+    QCOMPARE(hash.result(), QCryptographicHash::hash(data.mid(100), QCryptographicHash::Sha1));
+
+    // a device that is not a file
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCOMPARE(QCryptographicHash::hash(&buffer, methods), expected);
+
+    QFuture<QByteArrayList> future = QCryptographicHash::hashFile(file.fileName(), methods);
+    QCOMPARE(future.result(), expected);
+
+    future = QCryptographicHash::hashFile(file.fileName() + "-does-not-exist", methods);
+    QVERIFY(future.result().isEmpty());
+}
+
 void tst_QCryptographicHash::moreThan4GiBOfData_data()
 {
 #if QT_POINTER_SIZE > 4
@@ -0,0 +1,296 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QHash>
+#include <QRandomGenerator>
+#include <private/qgrouphash_p.h>
+
+#include "../../../../shared/containertesthelpers.h"
+
+using namespace QTestContainerHelpers;
+
+namespace {
+// all keys share the same control byte and the same first group
+struct Colliding
+{
+    int v;
+    friend bool operator==(Colliding lhs, Colliding rhs) { return lhs.v == rhs.v; }
+    friend size_t qHash(Colliding, size_t = 0) { return 0x1234500; }
+};
+}
+
+class tst_QGroupHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void basics();
+    void growth();
+    void subscriptGrowth();
+    void tombstones();
+    void iteration();
+    void eraseWhileIterating();
+    void copyAndMove();
+    void colliding();
+    void nonTrivialTypes();
+    void randomAgainstQHash();
+};
+
+void tst_QGroupHash::basics()
+{
+    QGroupHash<int, QString> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.value(1), QString());
+    QCOMPARE(hash.value(1, QStringLiteral("default")), QStringLiteral("default"));
+    QVERIFY(hash.begin() == hash.end());
+
+    hash.insert(1, QStringLiteral("one"));
+    hash.insert(2, QStringLiteral("two"));
+    QCOMPARE(hash.size(), 2);
+    QVERIFY(hash.contains(1));
+    QCOMPARE(hash.value(2), QStringLiteral("two"));
+
+    hash.insert(1, QStringLiteral("uno"));
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(1), QStringLiteral("uno"));
+
+    hash[3] = QStringLiteral("three");
+    QCOMPARE(hash.size(), 3);
+    QCOMPARE(hash.find(3).value(), QStringLiteral("three"));
+    QCOMPARE(hash.find(3).key(), 3);
+    QVERIFY(hash.find(4) == hash.end());
+
+    QCOMPARE(hash.take(2), QStringLiteral("two"));
+    QVERIFY(!hash.remove(2));
+    QVERIFY(hash.remove(3));
+    QCOMPARE(hash.size(), 1);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(1));
+}
+
+void tst_QGroupHash::growth()
+{
+    QGroupHash<int, int> hash;
+    for (int i = 0; i < 100000; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 100000);
+    QVERIFY(hash.capacity() >= hash.size());
+    for (int i = 0; i < 100000; ++i)
+        QCOMPARE(hash.value(i, -1), i * 2);
+    QVERIFY(!hash.contains(100000));
+
+    QGroupHash<int, int> reserved;
+    reserved.reserve(1000);
+    const qsizetype capacity = reserved.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        reserved.insert(i, i);
+    QCOMPARE(reserved.capacity(), capacity);
+}
+
+void tst_QGroupHash::subscriptGrowth()
+{
+    // operator[] on an empty table, and on every insert that makes it grow
+    QGroupHash<int, QString> hash;
+    hash[0] = QStringLiteral("0");
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(hash.value(0), QStringLiteral("0"));
+
+    qsizetype growths = 0;
+    for (int i = 1; i < 1000; ++i) {
+        const qsizetype capacity = hash.capacity();
+        hash[i] = QString::number(i);
+        if (hash.capacity() != capacity)
+            ++growths;
+    }
+    QVERIFY(growths >= 3);
+    QCOMPARE(hash.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i), QString::number(i));
+
+    // a missing key is default-constructed
+    QGroupHash<int, QString> other;
+    QVERIFY(other[42].isNull());
+    QCOMPARE(other.size(), 1);
+}
+
+void tst_QGroupHash::tombstones()
+{
+    // a steady stream of inserts and removals must not keep the table growing
+    QGroupHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+    const qsizetype capacity = hash.capacity();
+    for (int i = 100; i < 100000; ++i) {
+        hash.insert(i, i);
+        QVERIFY(hash.remove(i - 100));
+        QVERIFY(hash.capacity() <= 2 * capacity);
+    }
+    QCOMPARE(hash.size(), 100);
+    for (int i = 100000 - 100; i < 100000; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+}
+
+void tst_QGroupHash::iteration()
+{
+    QGroupHash<int, int> hash;
+    qint64 expected = 0;
+    for (int i = 0; i < 1000; ++i) {
+        hash.insert(i, i);
+        expected += i;
+    }
+
+    qint64 keys = 0, values = 0;
+    int count = 0;
+    for (auto it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        keys += it.key();
+        values += *it;
+        ++count;
+    }
+    QCOMPARE(count, 1000);
+    QCOMPARE(keys, expected);
+    QCOMPARE(values, expected);
+
+    for (int &value : hash)
+        value = -value;
+    QCOMPARE(hash.value(10), -10);
+}
+
+void tst_QGroupHash::eraseWhileIterating()
+{
+    QGroupHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    for (auto it = hash.begin(); it != hash.end(); ) {
+        if (it.key() % 2)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 500);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 0);
+}
+
+void tst_QGroupHash::copyAndMove()
+{
+    QGroupHash<QString, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(QString::number(i), i);
+
+    QGroupHash<QString, int> copy = hash;
+    QCOMPARE(copy.size(), 100);
+    copy.insert(QStringLiteral("extra"), -1);
+    QCOMPARE(hash.size(), 100);
+    QVERIFY(!hash.contains(QStringLiteral("extra")));
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(copy.value(QString::number(i)), i);
+
+    QGroupHash<QString, int> moved = std::move(copy);
+    QCOMPARE(moved.size(), 101);
+    QVERIFY(copy.isEmpty());
+    copy.insert(QStringLiteral("again"), 1);
+    QCOMPARE(copy.value(QStringLiteral("again")), 1);
+
+    moved = hash;
+    QCOMPARE(moved.size(), 100);
+    QGroupHash<QString, int> list = { { QStringLiteral("a"), 1 }, { QStringLiteral("b"), 2 } };
+    QCOMPARE(list.size(), 2);
+    QCOMPARE(list.value(QStringLiteral("b")), 2);
+}
+
+void tst_QGroupHash::colliding()
+{
+    QGroupHash<Colliding, int> hash;
+    for (int i = 0; i < 200; ++i)
+        hash.insert({ i }, i);
+    QCOMPARE(hash.size(), 200);
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(hash.value({ i }, -1), i);
+    QVERIFY(!hash.contains({ 200 }));
+
+    for (int i = 0; i < 200; i += 2)
+        QVERIFY(hash.remove({ i }));
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(hash.contains({ i }), i % 2 == 1);
+    for (int i = 0; i < 200; i += 2)
+        hash.insert({ i }, i);
+    QCOMPARE(hash.size(), 200);
+}
+
+void tst_QGroupHash::nonTrivialTypes()
+{
+    {
+        QGroupHash<int, Counted> hash;
+        for (int i = 0; i < 1000; ++i)
+            hash.emplace(i, i);
+        QCOMPARE(Counted::instances, 1000);
+        for (int i = 0; i < 1000; i += 3)
+            hash.remove(i);
+        QCOMPARE(Counted::instances, hash.size());
+        QGroupHash<int, Counted> copy = hash;
+        QCOMPARE(Counted::instances, 2 * hash.size());
+        copy.clear();
+        QCOMPARE(Counted::instances, hash.size());
+        QCOMPARE(hash.value(1).v, 1);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+void tst_QGroupHash::randomAgainstQHash()
+{
+    QRandomGenerator rng(1234);
+    QHash<quint32, quint32> reference;
+    QGroupHash<quint32, quint32> hash;
+    for (int i = 0; i < 200000; ++i) {
+        const quint32 key = rng.bounded(5000);
+        switch (rng.bounded(3)) {
+        case 0:
+            reference.insert(key, i);
+            hash.insert(key, i);
+            break;
+        case 1:
+            QCOMPARE(hash.remove(key), reference.remove(key));
+            break;
+        case 2:
+            QCOMPARE(hash.value(key, ~0u), reference.value(key, ~0u));
+            break;
+        }
+    }
+    QCOMPARE(hash.size(), reference.size());
+    for (auto it = hash.constBegin(); it != hash.constEnd(); ++it)
+        QCOMPARE(*it, reference.value(it.key()));
+}
+
+QTEST_APPLESS_MAIN(tst_QGroupHash)
+#include "tst_qgrouphash.moc"
@@ -62,6 +62,7 @@
 #include <QStringList>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QTemporaryFile>
 #ifndef QT_NO_SSL
 #include <QSslSocket>
 #endif
@@ -205,6 +206,8 @@ private slots:
     void serverDisconnectWithBuffered();
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
+    void sendFile();
+    void sendFileStreamed();
     void readNotificationsAfterBind();
 
 protected slots:
@@ -3220,6 +3223,126 @@ void tst_QTcpSocket::writeOnReadBufferOverflow()
     delete socket;
 }
 
+// Test that file ranges are sent in order with data written around them
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QByteArray contents;
+    for (int i = 0; i < 100000; ++i)
+        contents += char('a' + i % 26);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), qint64(contents.size()));
+
+    QTcpServer tcpServer;
+    QTcpSocket *socket = newSocket();
+
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    QTcpSocket *newConnection = tcpServer.nextPendingConnection();
+    QVERIFY(newConnection != nullptr);
+
+    QCOMPARE(socket->write("head"), qint64(4));
+    QVERIFY(socket->sendFile(&file, 10, 50000));
+    QCOMPARE(socket->write("middle"), qint64(6));
+    QVERIFY(socket->sendFile(&file, 99990));
+    QVERIFY(socket->sendFile(&file, 0, 0));
+    QTest::ignoreMessage(QtWarningMsg, "QTcpSocket::sendFile: offset 100001 is outside of the file");
+    QVERIFY(!socket->sendFile(&file, contents.size() + 1));
+    file.close();
+    QCOMPARE(socket->write("tail"), qint64(4));
+
+    const QByteArray expected = "head" + contents.mid(10, 50000) + "middle"
+            + contents.mid(99990) + "tail";
+    QCOMPARE(socket->bytesToWrite(), qint64(expected.size()));
+
+    QSignalSpy spyBytesWritten(socket, &QIODevice::bytesWritten);
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size()) {
+        QVERIFY2(timer.elapsed() < 10000, "Network timeout");
+        if (socket->bytesToWrite())
+            socket->waitForBytesWritten(100);
+        if (newConnection->bytesAvailable() || newConnection->waitForReadyRead(100))
+            received += newConnection->readAll();
+    }
+    QCOMPARE(received, expected);
+    QTRY_COMPARE(socket->bytesToWrite(), qint64(0));
+    qint64 totalWritten = 0;
+    for (const QList<QVariant> &args : qAsConst(spyBytesWritten))
+        totalWritten += args.at(0).toLongLong();
+    QCOMPARE(totalWritten, qint64(expected.size()));
+
+    delete newConnection;
+    delete socket;
+}
+
+// Test the fallback for files without a native handle, which reads the
+// range in chunks as the socket drains instead of copying it at once
+void tst_QTcpSocket::sendFileStreamed()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QFile file(":/tst_qtcpsocket.cpp");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.handle(), -1);
+    const QByteArray contents = file.readAll();
+    QVERIFY(contents.size() > 100000);
+
+    QTcpServer tcpServer;
+    QTcpSocket *socket = newSocket();
+
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    QTcpSocket *newConnection = tcpServer.nextPendingConnection();
+    QVERIFY(newConnection != nullptr);
+
+    QCOMPARE(socket->write("head"), qint64(4));
+    QVERIFY(socket->sendFile(&file, 10));
+    QCOMPARE(socket->write("middle"), qint64(6));
+    QVERIFY(socket->sendFile(&file, 0, 50000));
+    file.close();
+    QCOMPARE(socket->write("tail"), qint64(4));
+
+    const QByteArray expected = "head" + contents.mid(10) + "middle"
+            + contents.left(50000) + "tail";
+    QCOMPARE(socket->bytesToWrite(), qint64(expected.size()));
+    // only the first chunk has been copied into the write buffer
+    QVERIFY(socket->QIODevice::bytesToWrite() <= 64 * 1024);
+
+    QSignalSpy spyBytesWritten(socket, &QIODevice::bytesWritten);
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size()) {
+        QVERIFY2(timer.elapsed() < 10000, "Network timeout");
+        QVERIFY(socket->QIODevice::bytesToWrite() <= 64 * 1024);
+        if (socket->bytesToWrite())
+            socket->waitForBytesWritten(100);
+        if (newConnection->bytesAvailable() || newConnection->waitForReadyRead(100))
+            received += newConnection->readAll();
+    }
+    QCOMPARE(received, expected);
+    QTRY_COMPARE(socket->bytesToWrite(), qint64(0));
+    qint64 totalWritten = 0;
+    for (const QList<QVariant> &args : qAsConst(spyBytesWritten))
+        totalWritten += args.at(0).toLongLong();
+    QCOMPARE(totalWritten, qint64(expected.size()));
+
+    delete newConnection;
+    delete socket;
+}
+
 // Test that the socket does not enable the read notifications in bind()
 void tst_QTcpSocket::readNotificationsAfterBind()
 {
@@ -57,6 +57,8 @@
 #include "../../../network-settings.h"
 #include <QtTest/private/qemulationdetector_p.h>
 
+#include <limits>
+
 #if defined(Q_OS_LINUX)
 #define SHOULD_CHECK_SYSCALL_SUPPORT
 #include <netinet/in.h>
@@ -107,6 +109,7 @@ private slots:
     void outOfProcessConnectedClientServerTest();
     void outOfProcessUnconnectedClientServerTest();
     void zeroLengthDatagram();
+    void batchedDatagrams();
     void multicastTtlOption_data();
     void multicastTtlOption();
     void multicastLoopbackOption_data();
@@ -1260,6 +1263,62 @@ void tst_QUdpSocket::zeroLengthDatagram()
     QCOMPARE(receiver.readDatagram(&buf, 1), qint64(0));
 }
 
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress(QHostAddress::LocalHost), 0));
+    QVERIFY(receiver.receiveDatagrams(10).isEmpty());
+
+    // more than fit into a single system call
+    const int count = 200;
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < count; ++i) {
+        datagrams.append(QNetworkDatagram(QByteArray::number(i).repeated(i % 7),
+                                          QHostAddress::LocalHost, receiver.localPort()));
+    }
+
+    QUdpSocket sender;
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    QCOMPARE(sender.writeDatagrams(datagrams), qsizetype(count));
+    QCOMPARE(bytesWrittenSpy.count(), count);
+
+    QList<QNetworkDatagram> received;
+    while (received.size() < count) {
+        const QList<QNetworkDatagram> batch = receiver.receiveDatagrams(count);
+        if (batch.isEmpty())
+            QVERIFY2(receiver.waitForReadyRead(5000), QtNetworkSettings::msgSocketError(receiver).constData());
+        received += batch;
+    }
+
+    QCOMPARE(received.size(), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data());
+        QCOMPARE(received.at(i).senderAddress(), QHostAddress(QHostAddress::LocalHost));
+        QCOMPARE(received.at(i).senderPort(), int(sender.localPort()));
+        QCOMPARE(received.at(i).destinationPort(), int(receiver.localPort()));
+    }
+
+    // truncation
+    QCOMPARE(sender.writeDatagrams({ QNetworkDatagram("0123456789", QHostAddress::LocalHost,
+                                                      receiver.localPort()) }), qsizetype(1));
+    QVERIFY(receiver.waitForReadyRead(5000));
+    received = receiver.receiveDatagrams(10, 4);
+    QCOMPARE(received.size(), 1);
+    QCOMPARE(received.at(0).data(), QByteArray("0123"));
+
+    // a huge maxCount only allocates what arrives
+    QCOMPARE(sender.writeDatagrams({ QNetworkDatagram("abc", QHostAddress::LocalHost,
+                                                      receiver.localPort()) }), qsizetype(1));
+    QVERIFY(receiver.waitForReadyRead(5000));
+    received = receiver.receiveDatagrams(std::numeric_limits<int>::max());
+    QCOMPARE(received.size(), 1);
+    QCOMPARE(received.at(0).data(), QByteArray("abc"));
+}
+
 void tst_QUdpSocket::multicastTtlOption_data()
 {
     QTest::addColumn<QHostAddress>("bindAddress");
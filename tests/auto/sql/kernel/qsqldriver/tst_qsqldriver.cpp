@@ -52,6 +52,8 @@ private slots:
     void record();
     void primaryIndex();
     void formatValue();
+    void preparedStatementCache();
+    void preparedStatementCacheDriverDestroyed();
 };
 
 static bool driverSupportsDefaultValues(QSqlDriver::DbmsType dbType)
@@ -266,5 +268,126 @@ void tst_QSqlDriver::formatValue()
     QCOMPARE(db.driver()->formatValue(rec.field("more_data")), QString("1.234567"));
 }
 
+void tst_QSqlDriver::preparedStatementCache()
+{
+    QFETCH_GLOBAL(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QSqlDriver::DbmsType dbType = tst_Databases::getDatabaseType(db);
+    if (dbType != QSqlDriver::SQLite && dbType != QSqlDriver::PostgreSQL)
+        QSKIP("The driver does not use the prepared statement cache");
+
+    const QString connectionName = dbName + QLatin1String("_statementCache");
+    {
+        QSqlDatabase cacheDb = QSqlDatabase::cloneDatabase(db, connectionName);
+        QVERIFY_SQL(cacheDb, open());
+        QSqlDriver *driver = cacheDb.driver();
+        QCOMPARE(driver->preparedStatementCacheSize(), 0);
+        driver->setPreparedStatementCacheSize(2);
+        QCOMPARE(driver->preparedStatementCacheSize(), 2);
+
+        const QString tablename(qTableName("relTEST1", __FILE__, cacheDb));
+        const QString selectName = "SELECT name FROM " + tablename + " WHERE id = ?";
+        const QString selectId = "SELECT id FROM " + tablename + " WHERE name = ?";
+        const QString selectCount = "SELECT COUNT(*) FROM " + tablename;
+
+        // statements are returned to the cache when the query goes away
+        const char *names[] = { "harry", "trond", "vohi" };
+        for (int i = 0; i < 3; ++i) {
+            QSqlQuery q(cacheDb);
+            QVERIFY_SQL(q, prepare(selectName));
+            q.addBindValue(i + 1);
+            QVERIFY_SQL(q, exec());
+            QVERIFY_SQL(q, next());
+            QCOMPARE(q.value(0).toString(), QString::fromLatin1(names[i]));
+        }
+        QCOMPARE(driver->preparedStatementCacheMisses(), 1);
+        QCOMPARE(driver->preparedStatementCacheHits(), 2);
+
+        // a cached statement is only used by one query at a time
+        {
+            QSqlQuery q1(cacheDb);
+            QSqlQuery q2(cacheDb);
+            QVERIFY_SQL(q1, prepare(selectName));
+            QVERIFY_SQL(q2, prepare(selectName));
+            q1.addBindValue(1);
+            q2.addBindValue(2);
+            QVERIFY_SQL(q1, exec());
+            QVERIFY_SQL(q2, exec());
+            QVERIFY_SQL(q1, next());
+            QVERIFY_SQL(q2, next());
+            QCOMPARE(q1.value(0).toString(), QLatin1String("harry"));
+            QCOMPARE(q2.value(0).toString(), QLatin1String("trond"));
+        }
+        QCOMPARE(driver->preparedStatementCacheMisses(), 2);
+        QCOMPARE(driver->preparedStatementCacheHits(), 3);
+
+        // the least recently used statement is evicted
+        driver->clearPreparedStatementCache();
+        QSqlQuery q(cacheDb);
+        for (const QString &query : { selectName, selectId, selectCount, selectName })
+            QVERIFY_SQL(q, prepare(query));
+        q.clear();
+        QCOMPARE(driver->preparedStatementCacheMisses(), 4);
+        QCOMPARE(driver->preparedStatementCacheHits(), 0);
+        QVERIFY_SQL(q, prepare(selectName));
+        QVERIFY_SQL(q, prepare(selectCount));
+        QCOMPARE(driver->preparedStatementCacheHits(), 2);
+        QVERIFY_SQL(q, exec());
+        QVERIFY_SQL(q, next());
+        QCOMPARE(q.value(0).toInt(), 4);
+
+        // disabling the cache stops counting
+        driver->setPreparedStatementCacheSize(0);
+        QVERIFY_SQL(q, prepare(selectName));
+        QVERIFY_SQL(q, prepare(selectName));
+        QCOMPARE(driver->preparedStatementCacheMisses(), 4);
+        QCOMPARE(driver->preparedStatementCacheHits(), 2);
+
+        // closing the connection releases the cached statements
+        driver->setPreparedStatementCacheSize(2);
+        QVERIFY_SQL(q, prepare(selectId));
+        q.clear();
+        cacheDb.close();
+        QVERIFY(!cacheDb.lastError().isValid());
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+void tst_QSqlDriver::preparedStatementCacheDriverDestroyed()
+{
+    QFETCH_GLOBAL(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QSqlDriver::DbmsType dbType = tst_Databases::getDatabaseType(db);
+    if (dbType != QSqlDriver::SQLite && dbType != QSqlDriver::PostgreSQL)
+        QSKIP("The driver does not use the prepared statement cache");
+
+    // Destroying a driver that is still open must release the cached
+    // statements before the connection they belong to
+    const QString connectionName = dbName + QLatin1String("_statementCacheDestroyed");
+    {
+        QSqlDatabase cacheDb = QSqlDatabase::cloneDatabase(db, connectionName);
+        QVERIFY_SQL(cacheDb, open());
+        QSqlDriver *driver = cacheDb.driver();
+        driver->setPreparedStatementCacheSize(2);
+
+        const QString tablename(qTableName("relTEST1", __FILE__, cacheDb));
+        QSqlQuery q(cacheDb);
+        QVERIFY_SQL(q, prepare("SELECT name FROM " + tablename + " WHERE id = ?"));
+        q.addBindValue(1);
+        QVERIFY_SQL(q, exec());
+        QVERIFY_SQL(q, prepare("SELECT COUNT(*) FROM " + tablename));
+        q.clear();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    // the original connection is unaffected
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("SELECT COUNT(*) FROM " + qTableName("relTEST1", __FILE__, db)));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), 4);
+}
+
 QTEST_MAIN(tst_QSqlDriver)
 #include "tst_qsqldriver.moc"
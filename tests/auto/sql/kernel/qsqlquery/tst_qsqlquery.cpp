@@ -150,6 +150,10 @@ private slots:
     void invalidQuery();
     void batchExec_data() { generic_data(); }
     void batchExec();
+    void batchExecFailingRowPSQL_data() { generic_data("QPSQL"); }
+    void batchExecFailingRowPSQL();
+    void batchExecMultiRowMySQL_data() { generic_data("QMYSQL"); }
+    void batchExecMultiRowMySQL();
     void QTBUG_43874_data() { generic_data(); }
     void QTBUG_43874();
     void oraArrayBind_data() { generic_data("QOCI"); }
@@ -2607,6 +2611,96 @@ void tst_QSqlQuery::invalidQuery()
     QVERIFY(!q.next());
 }
 
+// A failing row must not leave the rows of earlier pipeline chunks applied
+void tst_QSqlQuery::batchExecFailingRowPSQL()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    if (!db.driver()->hasFeature(QSqlDriver::BatchOperations))
+        QSKIP("Rows are executed one by one without pipeline support in libpq");
+
+    QSqlQuery q(db);
+    const QString tableName = qTableName("qtest_batch_fail", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int primary key)").arg(tableName)));
+
+    // more rows than fit into one chunk, with a duplicate key in the second
+    QVariantList ids;
+    for (int i = 0; i < 2000; ++i)
+        ids << i;
+    ids[1500] = 10;
+
+    QVERIFY_SQL(q, prepare(QLatin1String("insert into %1 (id) values (?)").arg(tableName)));
+    q.addBindValue(ids);
+    QVERIFY(!q.execBatch());
+    QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+
+    QVERIFY_SQL(q, exec(QLatin1String("select count(*) from ") + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 0);
+
+    // without the duplicate, every row is applied
+    ids[1500] = 1500;
+    QVERIFY_SQL(q, prepare(QLatin1String("insert into %1 (id) values (?)").arg(tableName)));
+    q.addBindValue(ids);
+    QVERIFY_SQL(q, execBatch());
+    QVERIFY_SQL(q, exec(QLatin1String("select count(*) from ") + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 2000);
+
+    // a batch without bound values fails with a reason
+    QVERIFY_SQL(q, prepare(QLatin1String("delete from ") + tableName));
+    QVERIFY(!q.execBatch());
+    QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+}
+
+void tst_QSqlQuery::batchExecMultiRowMySQL()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    const QString tableName = qTableName("qtest_batch_rows", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int primary key, name varchar(200), "
+                                      "data blob, day date)").arg(tableName)));
+
+    // more data than fits into one statement, as non-ASCII text takes up
+    // more bytes than characters
+    constexpr int RowCount = 3000;
+    QVariantList ids, names, blobs, days;
+    for (int i = 0; i < RowCount; ++i) {
+        ids << i;
+        names << (i % 10 ? QVariant(QString(100, QChar(0x00e9)) + QString::number(i))
+                         : QVariant(QMetaType::fromType<QString>()));
+        blobs << QByteArray(100, char(i));
+        days << QDate(2022, 1, 1).addDays(i);
+    }
+
+    QVERIFY_SQL(q, prepare(QLatin1String("insert into %1 (id, name, data, day) values (?, ?, ?, ?)")
+                           .arg(tableName)));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    q.addBindValue(blobs);
+    q.addBindValue(days);
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), RowCount);
+
+    QVERIFY_SQL(q, exec(QLatin1String("select id, name, data, day from %1 order by id")
+                        .arg(tableName)));
+    for (int i = 0; i < RowCount; ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), i);
+        QCOMPARE(q.value(1).isNull(), names.at(i).isNull());
+        QCOMPARE(q.value(1).toString(), names.at(i).toString());
+        QCOMPARE(q.value(2).toByteArray(), blobs.at(i).toByteArray());
+        QCOMPARE(q.value(3).toDate(), days.at(i).toDate());
+    }
+    QVERIFY(!q.next());
+}
+
 void tst_QSqlQuery::batchExec()
 {
     QFETCH(QString, dbName);
@@ -71,6 +71,10 @@ private slots:
     void setHeaderData();
     void fetchMore_data() { generic_data(); }
     void fetchMore();
+    void windowedQuery_data() { generic_data(); }
+    void windowedQuery();
+    void windowedQueryMultipleKeys_data() { generic_data(); }
+    void windowedQueryMultipleKeys();
 
     //problem specific tests
     void withSortFilterProxyModel_data() { generic_data(); }
@@ -491,6 +495,95 @@ void tst_QSqlQueryModel::fetchMore()
     }
 }
 
+void tst_QSqlQueryModel::windowedQuery()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString many = qTableName("many", __FILE__, db);
+
+    QSqlQueryModel model;
+    QSignalSpy modelResetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy rowsInsertedSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    model.setWindowedQuery("select id, name from " + many, { "id" }, 100, db);
+    QVERIFY2(!model.lastError().isValid(), qPrintable(model.lastError().text()));
+    QCOMPARE(modelResetSpy.count(), 1);
+    QCOMPARE(rowsInsertedSpy.count(), 0);
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.rowCount(), 100);
+    QVERIFY(model.canFetchMore());
+    QCOMPARE(model.data(model.index(99, 0)).toInt(), 99);
+    QCOMPARE(model.data(model.index(100, 0)), QVariant());
+
+    // the model grows one window at a time
+    model.fetchMore();
+    QCOMPARE(model.rowCount(), 200);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(rowsInsertedSpy.at(0).at(1).toInt(), 100);
+    QCOMPARE(rowsInsertedSpy.at(0).at(2).toInt(), 199);
+
+    while (model.canFetchMore())
+        model.fetchMore();
+    QCOMPARE(model.rowCount(), 2048);
+    for (int row = 0; row < model.rowCount(); row += 97)
+        QCOMPARE(model.data(model.index(row, 0)).toInt(), row);
+    QCOMPARE(model.data(model.index(2047, 0)).toInt(), 2047);
+
+    // windows that were dropped are selected again
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("update " + many + " set name = 'sally' where id = 1"));
+    QCOMPARE(model.data(model.index(1, 1)).toString(), QString("sally"));
+    QVERIFY_SQL(q, exec("update " + many + " set name = 'harry' where id = 1"));
+
+    // setQuery() leaves windowed mode
+    model.setQuery(QSqlQuery("select * from " + many, db));
+    QCOMPARE(model.data(model.index(1, 1)).toString(), QString("harry"));
+
+    model.setWindowedQuery("select id, name from " + many, { "nokey" }, 100, db);
+    QVERIFY(model.lastError().isValid());
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(model.columnCount(), 0);
+}
+
+void tst_QSqlQueryModel::windowedQueryMultipleKeys()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString many = qTableName("many", __FILE__, db);
+
+    // ordered by (name, id), rows 0 to 1047 are ids 1000 to 2047 and
+    // rows 1048 to 2047 are ids 0 to 999
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("update " + many + " set name = 'sally' where id < 1000"));
+    const auto idOfRow = [](int row) { return row < 1048 ? row + 1000 : row - 1048; };
+
+    QSqlQueryModel model;
+    model.setWindowedQuery("select id, name from " + many, { "name", "id" }, 64, db);
+    QVERIFY2(!model.lastError().isValid(), qPrintable(model.lastError().text()));
+    while (model.canFetchMore())
+        model.fetchMore();
+    QCOMPARE(model.rowCount(), 2048);
+    for (int row = 0; row < model.rowCount(); row += 31) {
+        QCOMPARE(model.data(model.index(row, 0)).toInt(), idOfRow(row));
+        QCOMPARE(model.data(model.index(row, 1)).toString(),
+                 QString(row < 1048 ? "harry" : "sally"));
+    }
+
+    // more windows than first keys kept: windows in between are selected
+    // with an offset from the nearest key that was kept
+    model.setWindowedQuery("select id, name from " + many, { "name", "id" }, 1, db);
+    QVERIFY2(!model.lastError().isValid(), qPrintable(model.lastError().text()));
+    while (model.canFetchMore())
+        model.fetchMore();
+    QCOMPARE(model.rowCount(), 2048);
+    for (int row : { 1, 2, 3, 1047, 1048, 1049, 1025, 2047, 0 })
+        QCOMPARE(model.data(model.index(row, 0)).toInt(), idOfRow(row));
+
+    QVERIFY_SQL(q, exec("update " + many + " set name = 'harry'"));
+}
+
 // For task 149491: When used with QSortFilterProxyModel, a view and a
 // database that doesn't support the QuerySize feature, blank rows was
 // appended if the query returned more than 256 rows and setQuery()
@@ -30,6 +30,7 @@
 #include <QVariantMap>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qjsonarray.h>
 
 class BenchmarkQtJson: public QObject
 {
@@ -46,6 +47,8 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseLargeDocument_data();
+    void parseLargeDocument();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -118,6 +121,47 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtJson::parseLargeDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    const QJsonArray sample = QJsonDocument::fromJson(file.readAll()).array();
+    QVERIFY(!sample.isEmpty());
+
+    // a few MB of the contents of test.json
+    QJsonArray records;
+    for (int i = 0; i < 200; ++i)
+        records.append(sample);
+    QTest::newRow("records-indented") << QJsonDocument(records).toJson(QJsonDocument::Indented);
+    QTest::newRow("records-compact") << QJsonDocument(records).toJson(QJsonDocument::Compact);
+
+    // payloads dominated by text
+    const QString words = QStringLiteral("Lorem ipsum dolor sit amet, consectetur adipiscing elit. ");
+    QJsonArray ascii, escaped, utf8;
+    for (int i = 0; i < 1000; ++i) {
+        ascii.append(words.repeated(32));
+        escaped.append(QString(words + QStringLiteral("\"quoted\"\n")).repeated(28));
+        utf8.append(QStringLiteral("Größenänderung für Überschriften, 表示サイズの変更. ").repeated(40));
+    }
+    QTest::newRow("long-strings") << QJsonDocument(ascii).toJson(QJsonDocument::Compact);
+    QTest::newRow("escaped-strings") << QJsonDocument(escaped).toJson(QJsonDocument::Compact);
+    QTest::newRow("utf8-strings") << QJsonDocument(utf8).toJson(QJsonDocument::Compact);
+}
+
+void BenchmarkQtJson::parseLargeDocument()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        QVERIFY(!doc.isNull());
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -0,0 +1,257 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qsocketnotifier.h>
+#include <QTest>
+
+#include <private/qeventdispatcher_unix_p.h>
+#if QT_CONFIG(epoll)
+#  include <private/qeventdispatcher_epoll_p.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void socketNotifierWakeUp_data();
+    void socketNotifierWakeUp();
+    void timerRestart_data() { timerCount_data(); }
+    void timerRestart();
+    void timerFire_data() { timerCount_data(); }
+    void timerFire();
+    void timerUnregisterObject_data() { timerCount_data(); }
+    void timerUnregisterObject();
+
+private:
+    void timerCount_data();
+};
+
+enum DispatcherType {
+    Poll,
+    Epoll
+};
+Q_DECLARE_METATYPE(DispatcherType)
+
+static std::unique_ptr<QEventDispatcherUNIX> createDispatcher(DispatcherType type)
+{
+    switch (type) {
+    case Poll:
+        return std::make_unique<QEventDispatcherUNIX>();
+    case Epoll:
+#if QT_CONFIG(epoll)
+        return std::make_unique<QEventDispatcherEpoll>();
+#else
+        break;
+#endif
+    }
+    return nullptr;
+}
+
+static bool ensureFileDescriptorLimit(rlim_t wanted)
+{
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        return false;
+    if (limit.rlim_cur >= wanted)
+        return true;
+    if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max < wanted)
+        return false;
+    limit.rlim_cur = wanted;
+    return setrlimit(RLIMIT_NOFILE, &limit) == 0;
+}
+
+void tst_QEventDispatcher::socketNotifierWakeUp_data()
+{
+    QTest::addColumn<DispatcherType>("type");
+    QTest::addColumn<int>("notifierCount");
+
+    for (int count : { 10, 1000, 10000 }) {
+        QTest::addRow("poll-%d", count) << Poll << count;
+#if QT_CONFIG(epoll)
+        QTest::addRow("epoll-%d", count) << Epoll << count;
+#endif
+    }
+}
+
+// Measures the cost of one wake-up caused by a single ready descriptor while
+// notifierCount - 1 other read notifiers stay idle.
+void tst_QEventDispatcher::socketNotifierWakeUp()
+{
+    QFETCH(DispatcherType, type);
+    QFETCH(int, notifierCount);
+
+    if (!ensureFileDescriptorLimit(rlim_t(notifierCount) + 64))
+        QSKIP("Cannot raise the file descriptor limit far enough");
+
+    std::unique_ptr<QEventDispatcherUNIX> dispatcher = createDispatcher(type);
+    QVERIFY(dispatcher);
+
+    int idlePipe[2];
+    int activePipe[2];
+    QCOMPARE(pipe(idlePipe), 0);
+    QCOMPARE(pipe(activePipe), 0);
+
+    // The idle notifiers watch duplicates of a pipe that never becomes
+    // readable, which keeps the descriptor usage at one per notifier.
+    std::vector<int> idleFds;
+    idleFds.reserve(notifierCount - 1);
+    for (int i = 0; i < notifierCount - 1; ++i) {
+        const int fd = dup(idlePipe[0]);
+        QVERIFY(fd != -1);
+        idleFds.push_back(fd);
+    }
+
+    // Notifiers register themselves with the thread's dispatcher, so take
+    // them away from it and hand them to the one under test.
+    std::vector<std::unique_ptr<QSocketNotifier>> notifiers;
+    notifiers.reserve(notifierCount);
+    for (int fd : idleFds)
+        notifiers.push_back(std::make_unique<QSocketNotifier>(fd, QSocketNotifier::Read));
+    notifiers.push_back(std::make_unique<QSocketNotifier>(activePipe[0], QSocketNotifier::Read));
+
+    int activations = 0;
+    connect(notifiers.back().get(), &QSocketNotifier::activated, this, [&]() {
+        char c;
+        if (read(activePipe[0], &c, 1) == 1)
+            ++activations;
+    });
+
+    for (const auto &notifier : notifiers) {
+        notifier->setEnabled(false);
+        dispatcher->registerSocketNotifier(notifier.get());
+    }
+
+    QBENCHMARK {
+        const char c = 0;
+        QCOMPARE(write(activePipe[1], &c, 1), 1);
+        dispatcher->processEvents(QEventLoop::WaitForMoreEvents);
+    }
+    QVERIFY(activations > 0);
+
+    for (const auto &notifier : notifiers)
+        dispatcher->unregisterSocketNotifier(notifier.get());
+    notifiers.clear();
+
+    for (int fd : idleFds)
+        close(fd);
+    close(idlePipe[0]);
+    close(idlePipe[1]);
+    close(activePipe[0]);
+    close(activePipe[1]);
+}
+
+void tst_QEventDispatcher::timerCount_data()
+{
+    QTest::addColumn<int>("timerCount");
+
+    for (int count : { 100, 10000, 100000 })
+        QTest::addRow("%d", count) << count;
+}
+
+// Registers timerCount idle timers the way a server keeps per-connection
+// keepalive timers: long intervals, spread over a few seconds.
+static void registerIdleTimers(QAbstractEventDispatcher *dispatcher, QObject *receiver,
+                               int timerCount)
+{
+    for (int id = 1; id <= timerCount; ++id)
+        dispatcher->registerTimer(id, 60000 + id % 5000, Qt::CoarseTimer, receiver);
+}
+
+// Restarting a timer, as QTimer::start() on a running timer does, is an
+// unregister followed by a register.
+void tst_QEventDispatcher::timerRestart()
+{
+    QFETCH(int, timerCount);
+
+    QEventDispatcherUNIX dispatcher;
+    QObject receiver;
+    registerIdleTimers(&dispatcher, &receiver, timerCount);
+
+    int id = 0;
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            id = id % timerCount + 1;
+            dispatcher.unregisterTimer(id);
+            dispatcher.registerTimer(id, 60000 + i % 5000, Qt::CoarseTimer, &receiver);
+        }
+    }
+    QCOMPARE(dispatcher.registeredTimers(&receiver).size(), timerCount);
+}
+
+// One zero-interval timer firing while all others stay idle.
+void tst_QEventDispatcher::timerFire()
+{
+    QFETCH(int, timerCount);
+
+    class Receiver : public QObject
+    {
+    public:
+        int events = 0;
+        void timerEvent(QTimerEvent *) override { ++events; }
+    };
+
+    QEventDispatcherUNIX dispatcher;
+    QObject idleReceiver;
+    Receiver receiver;
+    registerIdleTimers(&dispatcher, &idleReceiver, timerCount - 1);
+    dispatcher.registerTimer(timerCount, 0, Qt::PreciseTimer, &receiver);
+
+    QBENCHMARK {
+        dispatcher.processEvents(QEventLoop::AllEvents);
+    }
+    QVERIFY(receiver.events > 0);
+}
+
+// Destroying an object that owns a timer unregisters all of its timers.
+void tst_QEventDispatcher::timerUnregisterObject()
+{
+    QFETCH(int, timerCount);
+
+    QEventDispatcherUNIX dispatcher;
+    QObject idleReceiver;
+    registerIdleTimers(&dispatcher, &idleReceiver, timerCount - 1);
+
+    QObject receiver;
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            dispatcher.registerTimer(timerCount, 30000, Qt::CoarseTimer, &receiver);
+            dispatcher.unregisterTimers(&receiver);
+        }
+    }
+}
+
+QTEST_MAIN(tst_QEventDispatcher)
+
+#include "tst_bench_qeventdispatcher.moc"
@@ -28,6 +28,10 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <vector>
 
 class tst_QMetaType : public QObject
 {
@@ -46,6 +50,8 @@ private slots:
     void typeBuiltinNotNormalized();
     void typeCustom();
     void typeCustomNotNormalized();
+    void typeCustomThreaded_data();
+    void typeCustomThreaded();
     void typeNotRegistered();
     void typeNotRegisteredNotNormalized();
 
@@ -155,6 +161,38 @@ void tst_QMetaType::typeCustomNotNormalized()
     }
 }
 
+void tst_QMetaType::typeCustomThreaded_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount : { 1, 2, 4, 8 })
+        QTest::addRow("%d", threadCount) << threadCount;
+}
+
+// The same lookups by name and by id as typeCustom, spread over several
+// threads, as a QVariant conversion or a dynamic call in a worker does them
+void tst_QMetaType::typeCustomThreaded()
+{
+    QFETCH(int, threadCount);
+    const int id = qRegisterMetaType<Foo>("Foo");
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back(QThread::create([id, threadCount] {
+                for (int i = 0; i < 100000 / threadCount; ++i) {
+                    if (QMetaType(id).sizeOf() != QMetaType::fromName("Foo").sizeOf())
+                        qFatal("Inconsistent lookup");
+                }
+            }));
+        }
+        for (auto &thread : threads)
+            thread->start();
+        for (auto &thread : threads)
+            thread->wait();
+    }
+}
+
 void tst_QMetaType::typeNotRegistered()
 {
     Q_ASSERT(!QMetaType::fromName("Bar").isValid());
@@ -0,0 +1,230 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QSemaphore>
+#include <QTest>
+#include <QThread>
+
+class Sender : public QObject
+{
+    Q_OBJECT
+signals:
+    void noArguments();
+    void intArgument(int);
+    void stringArgument(const QString &);
+    void threeArguments(int, double, const QString &);
+};
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    int expected = 0;
+    int received = 0;
+    QSemaphore done;
+
+public slots:
+    void onNoArguments() { receive(); }
+    void onIntArgument(int) { receive(); }
+    void onStringArgument(const QString &) { receive(); }
+    void onThreeArguments(int, double, const QString &) { receive(); }
+
+private:
+    void receive()
+    {
+        if (++received == expected)
+            done.release();
+    }
+};
+
+enum Signature {
+    NoArguments,
+    IntArgument,
+    StringArgument,
+    ThreeArguments
+};
+
+class tst_QueuedConnection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sameThread_data() { signature_data(); }
+    void sameThread();
+    void crossThread_data() { signature_data(); }
+    void crossThread();
+    void crossThreadFunctor();
+    void coalesced_data() { signature_data(); }
+    void coalesced();
+
+private:
+    void signature_data();
+};
+
+constexpr int EmitCount = 10000;
+
+static void connectSignature(Sender *sender, Receiver *receiver, Signature signature,
+                             Qt::ConnectionType type = Qt::QueuedConnection)
+{
+    switch (signature) {
+    case NoArguments:
+        QObject::connect(sender, &Sender::noArguments, receiver, &Receiver::onNoArguments,
+                         type);
+        break;
+    case IntArgument:
+        QObject::connect(sender, &Sender::intArgument, receiver, &Receiver::onIntArgument,
+                         type);
+        break;
+    case StringArgument:
+        QObject::connect(sender, &Sender::stringArgument, receiver, &Receiver::onStringArgument,
+                         type);
+        break;
+    case ThreeArguments:
+        QObject::connect(sender, &Sender::threeArguments, receiver, &Receiver::onThreeArguments,
+                         type);
+        break;
+    }
+}
+
+static void emitSignature(Sender *sender, Signature signature)
+{
+    const QString string = QStringLiteral("payload");
+    for (int i = 0; i < EmitCount; ++i) {
+        switch (signature) {
+        case NoArguments:
+            emit sender->noArguments();
+            break;
+        case IntArgument:
+            emit sender->intArgument(i);
+            break;
+        case StringArgument:
+            emit sender->stringArgument(string);
+            break;
+        case ThreeArguments:
+            emit sender->threeArguments(i, 0.5, string);
+            break;
+        }
+    }
+}
+
+void tst_QueuedConnection::signature_data()
+{
+    QTest::addColumn<Signature>("signature");
+
+    QTest::newRow("()") << NoArguments;
+    QTest::newRow("(int)") << IntArgument;
+    QTest::newRow("(QString)") << StringArgument;
+    QTest::newRow("(int,double,QString)") << ThreeArguments;
+}
+
+// Emitting and delivering in one thread: the cost of creating, posting and
+// dispatching the events without any contention.
+void tst_QueuedConnection::sameThread()
+{
+    QFETCH(Signature, signature);
+
+    Sender sender;
+    Receiver receiver;
+    connectSignature(&sender, &receiver, signature);
+
+    QBENCHMARK {
+        receiver.received = 0;
+        emitSignature(&sender, signature);
+        QCoreApplication::sendPostedEvents();
+    }
+    QCOMPARE(receiver.received, EmitCount);
+}
+
+// Emitting in the main thread while the receiver's thread delivers.
+void tst_QueuedConnection::crossThread()
+{
+    QFETCH(Signature, signature);
+
+    QThread thread;
+    Sender sender;
+    Receiver receiver;
+    receiver.moveToThread(&thread);
+    connectSignature(&sender, &receiver, signature);
+    thread.start();
+
+    QBENCHMARK {
+        receiver.received = 0;
+        receiver.expected = EmitCount;
+        emitSignature(&sender, signature);
+        receiver.done.acquire();
+    }
+
+    thread.quit();
+    thread.wait();
+}
+
+void tst_QueuedConnection::crossThreadFunctor()
+{
+    QThread thread;
+    QObject context;
+    context.moveToThread(&thread);
+    thread.start();
+
+    int received = 0;
+    QSemaphore done;
+    QBENCHMARK {
+        received = 0;
+        for (int i = 0; i < EmitCount; ++i) {
+            QMetaObject::invokeMethod(&context, [&received, &done] {
+                if (++received == EmitCount)
+                    done.release();
+            }, Qt::QueuedConnection);
+        }
+        done.acquire();
+    }
+
+    thread.quit();
+    thread.wait();
+}
+
+// The same emissions as sameThread, but only the last one is delivered.
+void tst_QueuedConnection::coalesced()
+{
+    QFETCH(Signature, signature);
+
+    Sender sender;
+    Receiver receiver;
+    connectSignature(&sender, &receiver, signature,
+                     static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection));
+
+    QBENCHMARK {
+        receiver.received = 0;
+        emitSignature(&sender, signature);
+        QCoreApplication::sendPostedEvents();
+    }
+    QCOMPARE(receiver.received, 1);
+}
+
+QTEST_MAIN(tst_QueuedConnection)
+#include "tst_bench_queuedconnection.moc"
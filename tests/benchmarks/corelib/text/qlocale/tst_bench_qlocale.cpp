@@ -54,6 +54,10 @@ private Q_SLOTS:
     void toUpper_QLocale_2();
     void toUpper_QString();
     void number_QString();
+    void toString_double_data();
+    void toString_double();
+    void toDouble_data();
+    void toDouble();
 };
 
 static QString data()
@@ -392,6 +396,71 @@ void tst_QLocale::number_QString()
     }
 }
 
+static QList<double> doubleSamples()
+{
+    QList<double> values;
+    for (int i = 0; i < 5000; ++i)
+        values.append((i * 7919 % 10007 - 5003) * 137.0371 / (i % 97 + 1));
+    return values;
+}
+
+// The C locale takes a fast path that en_US, having the same symbols, doesn't
+void tst_QLocale::toString_double_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<int>("precision");
+
+    for (const QLocale &locale : { QLocale::c(), QLocale(QLocale::English, QLocale::UnitedStates) }) {
+        QLocale noGroups = locale;
+        noGroups.setNumberOptions(QLocale::OmitGroupSeparator);
+        const QByteArray name = locale.name().toLatin1();
+        QTest::addRow("%s:g", name.constData()) << noGroups << 'g' << 6;
+        QTest::addRow("%s:f", name.constData()) << noGroups << 'f' << 2;
+        QTest::addRow("%s:shortest", name.constData())
+                << noGroups << 'g' << int(QLocale::FloatingPointShortest);
+    }
+}
+
+void tst_QLocale::toString_double()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    const QList<double> values = doubleSamples();
+
+    QBENCHMARK {
+        for (double d : values)
+            QString s = locale.toString(d, format, precision);
+    }
+}
+
+void tst_QLocale::toDouble_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<int>("precision");
+
+    for (const QLocale &locale : { QLocale::c(), QLocale(QLocale::English, QLocale::UnitedStates) }) {
+        const QByteArray name = locale.name().toLatin1();
+        QTest::addRow("%s:short", name.constData()) << locale << 6;
+        QTest::addRow("%s:long", name.constData()) << locale << 17;
+    }
+}
+
+void tst_QLocale::toDouble()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(int, precision);
+    QStringList strings;
+    for (double d : doubleSamples())
+        strings.append(QString::number(d, 'g', precision));
+
+    QBENCHMARK {
+        for (const QString &s : std::as_const(strings))
+            [[maybe_unused]] double d = locale.toDouble(s);
+    }
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
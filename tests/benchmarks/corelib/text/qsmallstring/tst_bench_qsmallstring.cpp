@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QHash>
+#include <QRandomGenerator>
+#include <QSmallString>
+#include <QTest>
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+
+    enum KeyType { String, SmallString };
+
+private slots:
+    void initTestCase();
+
+    void allocations_data() { keyTypes(); }
+    void allocations();
+    void construct_data() { keyTypes(); }
+    void construct();
+    void lookup_data() { keyTypes(); }
+    void lookup();
+
+private:
+    void keyTypes();
+
+    // key lengths are spread like identifiers: mostly short, a few long ones
+    QList<QString> keys;
+};
+
+void tst_QSmallString::initTestCase()
+{
+    QRandomGenerator rng(42);
+    for (int i = 0; i < 10000; ++i) {
+        const int length = rng.bounded(10) ? 3 + rng.bounded(13) : 16 + rng.bounded(48);
+        QString key(length, Qt::Uninitialized);
+        for (QChar &c : key)
+            c = QChar(u'a' + rng.bounded(26));
+        keys.append(key);
+    }
+}
+
+void tst_QSmallString::keyTypes()
+{
+    QTest::addColumn<KeyType>("type");
+    QTest::newRow("QString") << String;
+    QTest::newRow("QSmallString") << SmallString;
+}
+
+void tst_QSmallString::allocations()
+{
+    QFETCH(KeyType, type);
+
+    // each QString owns one block; a QSmallString only when it isn't inline
+    qsizetype blocks = 0;
+    if (type == String) {
+        for (const QString &key : qAsConst(keys))
+            blocks += QStringView(key).toString().isEmpty() ? 0 : 1;
+    } else {
+        for (const QString &key : qAsConst(keys))
+            blocks += QSmallString(QStringView(key)).isInline() ? 0 : 1;
+    }
+    QTest::setBenchmarkResult(blocks, QTest::Events);
+}
+
+void tst_QSmallString::construct()
+{
+    QFETCH(KeyType, type);
+
+    if (type == String) {
+        QBENCHMARK {
+            QList<QString> copies;
+            copies.reserve(keys.size());
+            for (const QString &key : qAsConst(keys))
+                copies.emplace_back(QStringView(key).toString());
+        }
+    } else {
+        QBENCHMARK {
+            QList<QSmallString> copies;
+            copies.reserve(keys.size());
+            for (const QString &key : qAsConst(keys))
+                copies.emplace_back(QStringView(key));
+        }
+    }
+}
+
+template <typename Key>
+static Key makeKey(QStringView view)
+{
+    if constexpr (std::is_same_v<Key, QString>)
+        return view.toString();
+    else
+        return Key(view);
+}
+
+template <typename Key>
+static void lookupImpl(const QList<QString> &keys)
+{
+    QHash<Key, int> hash;
+    QList<Key> probes;
+    for (int i = 0; i < keys.size(); ++i) {
+        hash.insert(makeKey<Key>(keys.at(i)), i);
+        probes.append(makeKey<Key>(keys.at(i)));
+    }
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (const Key &key : qAsConst(probes))
+            sum += hash.value(key);
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_QSmallString::lookup()
+{
+    QFETCH(KeyType, type);
+
+    if (type == String)
+        lookupImpl<QString>(keys);
+    else
+        lookupImpl<QSmallString>(keys);
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+
+#include "tst_bench_qsmallstring.moc"
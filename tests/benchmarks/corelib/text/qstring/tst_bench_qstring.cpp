@@ -57,7 +57,23 @@ private slots:
     void number_double_data();
     void number_double();
 
+    // the SIMD kernels; run with QT_NO_CPU_FEATURE=avx2 to compare against
+    // the baseline implementation
+    void fromLatin1_data() { kernelSizes_data(); }
+    void fromLatin1();
+    void toLatin1_data() { kernelSizes_data(); }
+    void toLatin1();
+    void indexOf_char_data() { kernelSizes_data(); }
+    void indexOf_char();
+    void compare_equal_data() { kernelSizes_data(); }
+    void compare_equal();
+    void toUtf8_ascii_data() { kernelSizes_data(); }
+    void toUtf8_ascii();
+    void fromUtf8_ascii_data() { kernelSizes_data(); }
+    void fromUtf8_ascii();
+
 private:
+    void kernelSizes_data();
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
     template <typename Integer> void number_impl();
@@ -319,6 +335,89 @@ void tst_QString::number_double()
     QCOMPARE(actual, expected);
 }
 
+void tst_QString::kernelSizes_data()
+{
+    QTest::addColumn<int>("size");
+
+    for (int size : { 15, 64, 1000, 4096 })
+        QTest::addRow("%d", size) << size;
+}
+
+static QByteArray latin1Data(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = char(' ' + i % 95);
+    return data;
+}
+
+void tst_QString::fromLatin1()
+{
+    QFETCH(int, size);
+    const QByteArray data = latin1Data(size);
+
+    QBENCHMARK {
+        QString s = QString::fromLatin1(data);
+        Q_UNUSED(s);
+    }
+}
+
+void tst_QString::toLatin1()
+{
+    QFETCH(int, size);
+    const QString data = QString::fromLatin1(latin1Data(size));
+
+    QBENCHMARK {
+        QByteArray ba = data.toLatin1();
+        Q_UNUSED(ba);
+    }
+}
+
+void tst_QString::indexOf_char()
+{
+    QFETCH(int, size);
+    // the needle is not in the haystack, so every call scans the whole string
+    const QString data = QString::fromLatin1(latin1Data(size));
+
+    QBENCHMARK {
+        QCOMPARE(data.indexOf(QChar(0x2028)), -1);
+    }
+}
+
+void tst_QString::compare_equal()
+{
+    QFETCH(int, size);
+    const QString s1 = QString::fromLatin1(latin1Data(size));
+    // force a deep copy
+    const QString s2 = QString(s1.constData(), s1.size());
+
+    QBENCHMARK {
+        QCOMPARE(s1.compare(s2), 0);
+    }
+}
+
+void tst_QString::toUtf8_ascii()
+{
+    QFETCH(int, size);
+    const QString data = QString::fromLatin1(latin1Data(size));
+
+    QBENCHMARK {
+        QByteArray ba = data.toUtf8();
+        Q_UNUSED(ba);
+    }
+}
+
+void tst_QString::fromUtf8_ascii()
+{
+    QFETCH(int, size);
+    const QByteArray data = latin1Data(size);
+
+    QBENCHMARK {
+        QString s = QString::fromUtf8(data);
+        Q_UNUSED(s);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_bench_qstring.moc"
@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QConcurrentQueue>
+#include <QMutex>
+#include <QQueue>
+#include <QSemaphore>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <memory>
+#include <vector>
+
+constexpr int ItemCount = 100000;
+constexpr int Capacity = 1024;
+
+class tst_QConcurrentQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void mpmc_data() { threads_data(); }
+    void mpmc();
+    void spsc();
+    void mutexQueue_data() { threads_data(); }
+    void mutexQueue();
+    void queuedInvoke();
+
+private:
+    void threads_data();
+};
+
+// A bounded queue the way it is typically written without QConcurrentQueue
+class MutexQueue
+{
+    QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    QQueue<int> queue;
+
+public:
+    void push(int value)
+    {
+        QMutexLocker locker(&mutex);
+        while (queue.size() >= Capacity)
+            notFull.wait(&mutex);
+        queue.enqueue(value);
+        notEmpty.wakeOne();
+    }
+
+    int pop()
+    {
+        QMutexLocker locker(&mutex);
+        while (queue.isEmpty())
+            notEmpty.wait(&mutex);
+        int value = queue.dequeue();
+        notFull.wakeOne();
+        return value;
+    }
+};
+
+template <typename Queue>
+static void transfer(Queue &queue, int producers, int consumers)
+{
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < producers; ++i) {
+        threads.emplace_back(QThread::create([&queue, producers] {
+            for (int n = 0; n < ItemCount / producers; ++n)
+                queue.push(n);
+        }));
+    }
+    for (int i = 0; i < consumers; ++i) {
+        threads.emplace_back(QThread::create([&queue, consumers] {
+            for (int n = 0; n < ItemCount / consumers; ++n)
+                queue.pop();
+        }));
+    }
+    for (auto &thread : threads)
+        thread->start();
+    for (auto &thread : threads)
+        thread->wait();
+}
+
+void tst_QConcurrentQueue::threads_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::addColumn<int>("consumers");
+
+    QTest::newRow("1x1") << 1 << 1;
+    QTest::newRow("4x1") << 4 << 1;
+    QTest::newRow("4x4") << 4 << 4;
+}
+
+void tst_QConcurrentQueue::mpmc()
+{
+    QFETCH(int, producers);
+    QFETCH(int, consumers);
+
+    QConcurrentQueue<int> queue(Capacity);
+    QBENCHMARK {
+        transfer(queue, producers, consumers);
+    }
+}
+
+void tst_QConcurrentQueue::spsc()
+{
+    QSpscQueue<int> queue(Capacity);
+    QBENCHMARK {
+        transfer(queue, 1, 1);
+    }
+}
+
+void tst_QConcurrentQueue::mutexQueue()
+{
+    QFETCH(int, producers);
+    QFETCH(int, consumers);
+
+    MutexQueue queue;
+    QBENCHMARK {
+        transfer(queue, producers, consumers);
+    }
+}
+
+void tst_QConcurrentQueue::queuedInvoke()
+{
+    // the cross-thread baseline: one queued call per item
+    QThread thread;
+    QObject receiver;
+    receiver.moveToThread(&thread);
+    thread.start();
+
+    QSemaphore done;
+    int received = 0;
+    QBENCHMARK {
+        received = 0;
+        for (int n = 0; n < ItemCount; ++n) {
+            QMetaObject::invokeMethod(&receiver, [&received, &done] {
+                if (++received == ItemCount)
+                    done.release();
+            }, Qt::QueuedConnection);
+        }
+        done.acquire();
+    }
+
+    thread.quit();
+    thread.wait();
+}
+
+QTEST_MAIN(tst_QConcurrentQueue)
+#include "tst_bench_qconcurrentqueue.moc"
@@ -40,6 +40,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void recursiveSpawn_data();
+    void recursiveSpawn();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,6 +77,60 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+// Splits itself in two until it reaches depth 0, like a parallel divide and
+// conquer algorithm would, so that almost all tasks are started from inside
+// the pool.
+class SpawningRunnable : public QRunnable
+{
+public:
+    SpawningRunnable(QThreadPool *pool, int depth, QAtomicInt *leaves)
+        : pool(pool), depth(depth), leaves(leaves)
+    {
+    }
+
+    void run() override
+    {
+        if (depth == 0) {
+            leaves->ref();
+            return;
+        }
+        pool->start(new SpawningRunnable(pool, depth - 1, leaves));
+        pool->start(new SpawningRunnable(pool, depth - 1, leaves));
+    }
+
+private:
+    QThreadPool *pool;
+    int depth;
+    QAtomicInt *leaves;
+};
+
+void tst_QThreadPool::recursiveSpawn_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    const int idealThreadCount = QThread::idealThreadCount();
+    int threadCount = 1;
+    for (; threadCount <= qMax(idealThreadCount, 8); threadCount *= 2)
+        QTest::addRow("%d", threadCount) << threadCount;
+    if (idealThreadCount > 8 && idealThreadCount != threadCount / 2)
+        QTest::addRow("%d", idealThreadCount) << idealThreadCount;
+}
+
+void tst_QThreadPool::recursiveSpawn()
+{
+    QFETCH(int, threadCount);
+    const int depth = 16;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QBENCHMARK {
+        QAtomicInt leaves;
+        threadPool.start(new SpawningRunnable(&threadPool, depth, &leaves));
+        threadPool.waitForDone();
+        QCOMPARE(leaves.loadRelaxed(), 1 << depth);
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
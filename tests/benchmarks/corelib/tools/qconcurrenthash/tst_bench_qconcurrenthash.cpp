@@ -0,0 +1,149 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QConcurrentHash>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+
+    enum Container { LockedHash, ConcurrentHash };
+
+private slots:
+    void read_data();
+    void read();
+    void readWrite_data() { read_data(); }
+    void readWrite();
+};
+
+// what QConcurrentHash replaces: a QHash behind a single lock
+class LockedHash
+{
+    mutable QReadWriteLock lock;
+    QHash<int, int> hash;
+
+public:
+    void insert(int key, int value)
+    {
+        QWriteLocker locker(&lock);
+        hash.insert(key, value);
+    }
+    int value(int key) const
+    {
+        QReadLocker locker(&lock);
+        return hash.value(key);
+    }
+};
+
+static constexpr int KeyCount = 100000;
+static constexpr int OperationCount = 1 << 21;
+
+void tst_QConcurrentHash::read_data()
+{
+    QTest::addColumn<Container>("container");
+    QTest::addColumn<int>("threads");
+
+    for (int threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+        QTest::addRow("QReadWriteLock+QHash-%d", threads) << LockedHash << threads;
+        QTest::addRow("QConcurrentHash-%d", threads) << ConcurrentHash << threads;
+    }
+}
+
+// The same total number of operations is split between the threads, so
+// with perfect scaling the time per iteration drops as threads are added.
+// Every 16th operation of a thread is a write if writeEvery is 16.
+template <typename Table>
+static void runThreads(Table &table, int threadCount, int writeEvery)
+{
+    const int perThread = OperationCount / threadCount;
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back(QThread::create([&table, t, perThread, writeEvery] {
+            uint key = uint(t) * 7919;
+            qint64 sum = 0;
+            for (int i = 0; i < perThread; ++i) {
+                key = (key * 1103515245 + 12345) % KeyCount;
+                if (writeEvery && i % writeEvery == 0)
+                    table.insert(int(key), i);
+                else
+                    sum += table.value(int(key));
+            }
+            if (sum == -1)
+                qWarning("impossible");
+        }));
+    }
+    for (auto &thread : threads)
+        thread->start();
+    for (auto &thread : threads)
+        thread->wait();
+}
+
+template <typename Table>
+static void benchmark(int threads, int writeEvery)
+{
+    Table table;
+    for (int i = 0; i < KeyCount; ++i)
+        table.insert(i, i);
+
+    QBENCHMARK {
+        runThreads(table, threads, writeEvery);
+    }
+}
+
+void tst_QConcurrentHash::read()
+{
+    QFETCH(Container, container);
+    QFETCH(int, threads);
+
+    if (container == LockedHash)
+        benchmark<::LockedHash>(threads, 0);
+    else
+        benchmark<QConcurrentHash<int, int>>(threads, 0);
+}
+
+void tst_QConcurrentHash::readWrite()
+{
+    QFETCH(Container, container);
+    QFETCH(int, threads);
+
+    if (container == LockedHash)
+        benchmark<::LockedHash>(threads, 16);
+    else
+        benchmark<QConcurrentHash<int, int>>(threads, 16);
+}
+
+QTEST_MAIN(tst_QConcurrentHash)
+
+#include "tst_bench_qconcurrenthash.moc"
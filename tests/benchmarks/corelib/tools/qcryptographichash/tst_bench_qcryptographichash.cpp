@@ -50,6 +50,10 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void hashMany_data();
+    void hashMany();
+    void hashManyOneByOne_data() { hashMany_data(); }
+    void hashManyOneByOne();
 };
 
 const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
@@ -183,6 +187,47 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<QList<QByteArrayView>>("data");
+
+    // many small inputs, like the chunks of a content-addressed store
+    static const int datasizes[] = { 16, 64, 256, 1024 };
+    static const int count = 1024;
+    for (int size : datasizes) {
+        QList<QByteArrayView> data;
+        for (int i = 0; i < count; ++i)
+            data.append(QByteArrayView(blockOfData.constData() + (i * size) % (MaxBlockSize - size), size));
+
+        for (int algo : { QCryptographicHash::Sha1, QCryptographicHash::Sha256, QCryptographicHash::Sha3_256 })
+            QTest::newRow(algoname(algo) + QByteArray::number(count) + 'x' + QByteArray::number(size)) << algo << data;
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(int, algorithm);
+    QFETCH(QList<QByteArrayView>, data);
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QCryptographicHash::hashMany(data, algo);
+    }
+}
+
+void tst_QCryptographicHash::hashManyOneByOne()
+{
+    QFETCH(int, algorithm);
+    QFETCH(QList<QByteArrayView>, data);
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        for (QByteArrayView input : qAsConst(data))
+            QCryptographicHash::hash(input, algo);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QCryptographicHash)
 
 #include "tst_bench_qcryptographichash.moc"
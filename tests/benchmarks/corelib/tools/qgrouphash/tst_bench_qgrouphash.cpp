@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTest>
+#include <private/qgrouphash_p.h>
+
+class tst_QGroupHash : public QObject
+{
+    Q_OBJECT
+
+    enum Container { Hash, GroupHash };
+
+private slots:
+    void insert_int_data() { data(); }
+    void insert_int();
+    void insert_string_data() { data(); }
+    void insert_string();
+    void lookup_int_data() { data(); }
+    void lookup_int();
+    void lookup_string_data() { data(); }
+    void lookup_string();
+    void lookupMiss_int_data() { data(); }
+    void lookupMiss_int();
+    void erase_int_data() { data(); }
+    void erase_int();
+
+private:
+    void data();
+};
+
+void tst_QGroupHash::data()
+{
+    QTest::addColumn<Container>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 1000, 100000, 1000000 }) {
+        QTest::addRow("QHash-%d", size) << Hash << size;
+        QTest::addRow("QGroupHash-%d", size) << GroupHash << size;
+    }
+}
+
+static QList<int> intKeys(int size)
+{
+    QList<int> keys;
+    keys.reserve(size);
+    QRandomGenerator rng(size);
+    while (keys.size() < size)
+        keys.append(int(rng.generate()));
+    return keys;
+}
+
+static QList<QString> stringKeys(int size)
+{
+    QList<QString> keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i)
+        keys.append(QStringLiteral("key-%1").arg(i));
+    return keys;
+}
+
+template <typename Table, typename Key>
+static void insertImpl(const QList<Key> &keys)
+{
+    QBENCHMARK {
+        Table table;
+        for (const Key &key : keys)
+            table.insert(key, 1);
+    }
+}
+
+template <typename Table, typename Key>
+static void lookupImpl(const QList<Key> &keys, const QList<Key> &probes)
+{
+    Table table;
+    for (const Key &key : keys)
+        table.insert(key, 1);
+
+    qint64 found = 0;
+    QBENCHMARK {
+        for (const Key &key : probes)
+            found += table.value(key, 0);
+    }
+    QVERIFY(found >= 0);
+}
+
+template <typename Table, typename Key>
+static void eraseImpl(const QList<Key> &keys)
+{
+    Table filled;
+    for (const Key &key : keys)
+        filled.insert(key, 1);
+
+    QBENCHMARK {
+        Table table = filled;
+        for (const Key &key : keys)
+            table.remove(key);
+    }
+}
+
+void tst_QGroupHash::insert_int()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
+    const QList<int> keys = intKeys(size);
+    if (container == Hash)
+        insertImpl<QHash<int, int>>(keys);
+    else
+        insertImpl<QGroupHash<int, int>>(keys);
+}
+
+void tst_QGroupHash::insert_string()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
+    const QList<QString> keys = stringKeys(size);
+    if (container == Hash)
+        insertImpl<QHash<QString, int>>(keys);
+    else
+        insertImpl<QGroupHash<QString, int>>(keys);
+}
+
+void tst_QGroupHash::lookup_int()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
+    const QList<int> keys = intKeys(size);
+    if (container == Hash)
+        lookupImpl<QHash<int, int>>(keys, keys);
+    else
+        lookupImpl<QGroupHash<int, int>>(keys, keys);
+}
+
+void tst_QGroupHash::lookup_string()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
+    const QList<QString> keys = stringKeys(size);
+    if (container == Hash)
+        lookupImpl<QHash<QString, int>>(keys, keys);
+    else
+        lookupImpl<QGroupHash<QString, int>>(keys, keys);
+}
+
+void tst_QGroupHash::lookupMiss_int()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
+    const QList<int> keys = intKeys(size);
+    QList<int> probes = intKeys(size + 1);
+    probes.removeFirst();
+    if (container == Hash)
+        lookupImpl<QHash<int, int>>(keys, probes);
+    else
+        lookupImpl<QGroupHash<int, int>>(keys, probes);
+}
+
+void tst_QGroupHash::erase_int()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
+    const QList<int> keys = intKeys(size);
+    if (container == Hash)
+        eraseImpl<QHash<int, int>>(keys);
+    else
+        eraseImpl<QGroupHash<int, int>>(keys);
+}
+
+QTEST_MAIN(tst_QGroupHash)
+
+#include "tst_bench_qgrouphash.moc"
@@ -41,6 +41,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void loopbackThroughput_data();
+    void loopbackThroughput();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -76,5 +78,53 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::loopbackThroughput_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("size");
+    for (int size : {64, 512, 1400}) {
+        QTest::addRow("single-%d", size) << false << size;
+        QTest::addRow("batched-%d", size) << true << size;
+    }
+}
+
+void tst_QUdpSocket::loopbackThroughput()
+{
+    QFETCH(bool, batched);
+    QFETCH(int, size);
+
+    // small enough to fit into the default receive buffer of the socket
+    const int datagramCount = 64;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost));
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost));
+
+    const QList<QNetworkDatagram> datagrams(datagramCount,
+            QNetworkDatagram(QByteArray(size, 'a'), QHostAddress::LocalHost, receiver.localPort()));
+
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(sender.writeDatagrams(datagrams), qsizetype(datagramCount));
+        } else {
+            for (const QNetworkDatagram &datagram : datagrams)
+                QCOMPARE(sender.writeDatagram(datagram), qint64(size));
+        }
+
+        int received = 0;
+        while (received < datagramCount) {
+            if (!receiver.hasPendingDatagrams())
+                QVERIFY(receiver.waitForReadyRead(5000));
+            if (batched) {
+                received += int(receiver.receiveDatagrams(datagramCount - received, size).size());
+            } else {
+                QVERIFY(receiver.receiveDatagram(size).isValid());
+                ++received;
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
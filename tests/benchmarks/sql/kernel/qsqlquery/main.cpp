@@ -52,6 +52,10 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkInsertLoop_data() { generic_data(); }
+    void benchmarkInsertLoop();
+    void benchmarkInsertBatch_data() { generic_data(); }
+    void benchmarkInsertBatch();
 
 private:
     // returns all database connections
@@ -59,6 +63,7 @@ private:
     void dropTestTables( QSqlDatabase db );
     void createTestTables( QSqlDatabase db );
     void populateTestTables( QSqlDatabase db );
+    void benchmarkInsert(bool batch);
 
     tst_Databases dbs;
 };
@@ -293,4 +298,64 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     tst_Databases::safeDropTable(db, tableName);
 }
 
+void tst_QSqlQuery::benchmarkInsertLoop()
+{
+    benchmarkInsert(false);
+}
+
+void tst_QSqlQuery::benchmarkInsertBatch()
+{
+    benchmarkInsert(true);
+}
+
+void tst_QSqlQuery::benchmarkInsert(bool batch)
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(45))"));
+
+    const int NUM_ROWS = 10000;
+    QVariantList ids;
+    QVariantList names;
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        ids << i;
+        names << QString("Value" + QString::number(i));
+    }
+
+    // Executing a large batch row by row is slow with every driver, so
+    // group the rows in a transaction where supported, as applications do.
+    const bool useTransaction = db.driver()->hasFeature(QSqlDriver::Transactions);
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " (id, name) VALUES (?, ?)"));
+    QBENCHMARK {
+        if (useTransaction)
+            QVERIFY(db.transaction());
+        if (batch) {
+            q.addBindValue(ids);
+            q.addBindValue(names);
+            QVERIFY_SQL(q, execBatch());
+        } else {
+            for (int i = 0; i < NUM_ROWS; ++i) {
+                q.addBindValue(ids.at(i));
+                q.addBindValue(names.at(i));
+                QVERIFY_SQL(q, exec());
+            }
+        }
+        if (useTransaction)
+            QVERIFY(db.commit());
+    }
+
+    q.clear();
+    QVERIFY_SQL(q, exec("SELECT COUNT(*) FROM " + tableName));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt() % NUM_ROWS, 0);
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 #include "main.moc"
@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT_TESTS_SHARED_CONTAINER_TEST_HELPERS_H
+#define QT_TESTS_SHARED_CONTAINER_TEST_HELPERS_H
+
+#include <QtCore/QThread>
+
+#include <memory>
+#include <vector>
+
+namespace QTestContainerHelpers {
+
+// Counts its live instances, to check that containers destroy what they hold.
+struct Counted
+{
+    static inline int instances = 0;
+    int v = 0;
+    Counted(int v = 0) : v(v) { ++instances; }
+    Counted(const Counted &other) : v(other.v) { ++instances; }
+    Counted &operator=(const Counted &) = default;
+    ~Counted() { --instances; }
+};
+
+// Runs function(i) for i in [0, count) in as many threads and waits for them.
+// Returns false if a thread could not be waited for.
+template <typename Function>
+[[nodiscard]] bool runInThreads(int count, Function function)
+{
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < count; ++i)
+        threads.emplace_back(QThread::create(function, i));
+    for (auto &thread : threads)
+        thread->start();
+    bool finished = true;
+    for (auto &thread : threads)
+        finished = thread->wait() && finished;
+    return finished;
+}
+
+} // namespace QTestContainerHelpers
+
+#endif // QT_TESTS_SHARED_CONTAINER_TEST_HELPERS_H